@@ -131,10 +131,10 @@ Rectangle {
                         console.log("Alert: Left button clicked -", root.alertMenuLeft)
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.alertMenuLeft.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuLeft.replace(/\s+/g, "_")
                         root.leftButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.leftButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -186,10 +186,10 @@ Rectangle {
                         console.log("Alert: Middle button clicked -", root.alertMenuMiddle)
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.alertMenuMiddle.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuMiddle.replace(/\s+/g, "_")
                         root.middleButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.middleButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -241,10 +241,10 @@ Rectangle {
                         console.log("Alert: Right button clicked -", root.alertMenuRight)
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.alertMenuRight.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuRight.replace(/\s+/g, "_")
                         root.rightButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.rightButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -265,22 +265,97 @@ Rectangle {
 
         function onFileChanged(path) {
             // Check for button file deletions (file no longer exists = re-enable button)
-            var leftButtonFile = root.buttonDir + "button_" + root.alertMenuLeft.replace(/\s+/g, "_")
-            var middleButtonFile = root.buttonDir + "button_" + root.alertMenuMiddle.replace(/\s+/g, "_")
-            var rightButtonFile = root.buttonDir + "button_" + root.alertMenuRight.replace(/\s+/g, "_")
-
-            if (path === leftButtonFile && !fileIO.fileExists(leftButtonFile)) {
-                console.log("Left button file deleted, re-enabling button")
-                root.leftButtonPressed = false
+            var leftButtonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuLeft.replace(/\s+/g, "_")
+            var middleButtonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuMiddle.replace(/\s+/g, "_")
+            var rightButtonFile = root.buttonDir + screenPrefix + "button_" + root.alertMenuRight.replace(/\s+/g, "_")
+
+            if (path === leftButtonFile) {
+                fileIO.fileExistsAsync(leftButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Left button file deleted, re-enabling button")
+                        root.leftButtonPressed = false
+                        buttonLatency.acknowledged(leftButtonFile)
+                    }
+                })
             }
-            if (path === middleButtonFile && !fileIO.fileExists(middleButtonFile)) {
-                console.log("Middle button file deleted, re-enabling button")
-                root.middleButtonPressed = false
+            if (path === middleButtonFile) {
+                fileIO.fileExistsAsync(middleButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Middle button file deleted, re-enabling button")
+                        root.middleButtonPressed = false
+                        buttonLatency.acknowledged(middleButtonFile)
+                    }
+                })
             }
-            if (path === rightButtonFile && !fileIO.fileExists(rightButtonFile)) {
-                console.log("Right button file deleted, re-enabling button")
-                root.rightButtonPressed = false
+            if (path === rightButtonFile) {
+                fileIO.fileExistsAsync(rightButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Right button file deleted, re-enabling button")
+                        root.rightButtonPressed = false
+                        buttonLatency.acknowledged(rightButtonFile)
+                    }
+                })
             }
         }
     }
+
+    // Pressed buttons across restarts (stateSnapshot, [app_live] state_snapshot)
+    Connections {
+        target: stateSnapshot
+
+        function onSaving() {
+            stateSnapshot.setValue(screenPrefix + "alert.pressed", [root.leftButtonPressed, root.middleButtonPressed, root.rightButtonPressed])
+        }
+
+        function onRestored() {
+            root.restoreState()
+        }
+    }
+
+    // Write the button file off the GUI thread and stay pressed until the
+    // controller removes it - which it may do before the write callback runs
+    function submitButton(buttonFile, setPressed) {
+        fileIO.writeFileAsync(buttonFile, "1", function(success) {
+            if (!success) {
+                // Nothing will acknowledge it, so let the button be pressed again
+                console.warn("Button file could not be written:", buttonFile)
+                setPressed(false)
+                return
+            }
+            fileIO.watchFile(buttonFile)
+            fileIO.fileExistsAsync(buttonFile, function(exists) {
+                if (!exists) {
+                    setPressed(false)
+                    buttonLatency.acknowledged(buttonFile)
+                }
+            })
+        })
+    }
+
+    // After main.qml's onLoaded bindings have set the labels
+    Component.onCompleted: Qt.callLater(restoreState)
+
+    function restoreState() {
+        var pressed = stateSnapshot.value(screenPrefix + "alert.pressed", [])
+        var labels = [root.alertMenuLeft, root.alertMenuMiddle, root.alertMenuRight]
+        var setters = [function(v) { root.leftButtonPressed = v },
+                       function(v) { root.middleButtonPressed = v },
+                       function(v) { root.rightButtonPressed = v }]
+        for (var i = 0; i < 3; i++) {
+            if (!pressed[i] || labels[i] === "") {
+                continue
+            }
+            // Pressed until the controller removes the button file; it may have done so meanwhile
+            var buttonFile = root.buttonDir + screenPrefix + "button_" + labels[i].replace(/\s+/g, "_")
+            setters[i](true)
+            fileIO.watchFile(buttonFile)
+            fileIO.fileExistsAsync(buttonFile, (function(setPressed) {
+                return function(exists) {
+                    if (!exists) {
+                        setPressed(false)
+                    }
+                }
+            })(setters[i]))
+        }
+    }
 }
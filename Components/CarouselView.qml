@@ -7,6 +7,12 @@ Item {
     property var gameImages: []
     property int currentIndex: 0
     property int cardCount: gameImages.length
+    // Snapshot key for the current card across restarts, empty = not kept
+    property string stateKey: ""
+
+    // Quality governor tier >= 1: no rounded-corner masks (2 FBOs + shader per card),
+    // no shadows and no opacity fades
+    property bool reducedQuality: qualityGovernor.reducedCarousel
 
     width: parent.width
     height: 350
@@ -22,6 +28,29 @@ Item {
         }
     }
 
+    // Current card across restarts (stateSnapshot, [app_live] state_snapshot)
+    Connections {
+        target: root.stateKey !== "" ? stateSnapshot : null
+
+        function onSaving() {
+            stateSnapshot.setValue(root.stateKey, root.currentIndex)
+        }
+
+        function onRestored() {
+            root.restoreState()
+        }
+    }
+
+    Component.onCompleted: restoreState()
+
+    function restoreState() {
+        if (root.stateKey === "" || !stateSnapshot.contains(root.stateKey) || root.cardCount === 0) {
+            return
+        }
+        root.currentIndex = stateSnapshot.value(root.stateKey, 0) % root.cardCount
+        rotationTimer.restart()
+    }
+
     // Carousel container
     Item {
         id: carouselContainer
@@ -128,6 +157,7 @@ Item {
                 }
 
                 Behavior on opacity {
+                    enabled: !root.reducedQuality
                     NumberAnimation {
                         duration: 800
                         easing.type: Easing.InOutQuad
@@ -144,6 +174,7 @@ Item {
                     height: 30
                     radius: height / 2
                     opacity: card.opacity * 0.6
+                    visible: !root.reducedQuality
 
                     gradient: Gradient {
                         orientation: Gradient.Vertical
@@ -153,7 +184,7 @@ Item {
                     }
                 }
 
-                // Image (hidden, used as source for mask)
+                // Image (hidden, used as source for mask; drawn directly in reduced quality)
                 Image {
                     id: gameImage
                     anchors.fill: parent
@@ -161,7 +192,7 @@ Item {
                     fillMode: Image.PreserveAspectFit
                     smooth: true
                     asynchronous: true
-                    visible: false
+                    visible: root.reducedQuality
                 }
 
                 // Rounded rectangle mask (hidden)
@@ -172,11 +203,14 @@ Item {
                     visible: false
                 }
 
-                // Apply rounded mask to image
-                OpacityMask {
+                // Apply rounded mask to image (unloaded in reduced quality so its FBOs go away)
+                Loader {
                     anchors.fill: parent
-                    source: gameImage
-                    maskSource: maskRect
+                    active: !root.reducedQuality
+                    sourceComponent: OpacityMask {
+                        source: gameImage
+                        maskSource: maskRect
+                    }
                 }
             }
         }
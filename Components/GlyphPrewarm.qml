@@ -0,0 +1,104 @@
+import QtQuick
+
+// Rasterizes glyphs into the window's distance-field atlas before the apps need
+// them: the characters of glyphCache.characters in each font/size the apps use.
+// Drawn for a few frames at near-zero opacity behind the content (fully
+// transparent text would be skipped by the renderer and never reach the atlas),
+// then unloaded; the atlas keeps the glyphs. When new characters appear, only
+// those are drawn.
+Item {
+    id: root
+
+    // Characters drawn since the atlas was created (code point -> true)
+    property var warmed: ({})
+    // Characters of the current pass
+    property string pending: ""
+    // Countdown digits are all TimerApp needs from its font, drawn in the first pass
+    property string digits: "0123456789"
+
+    property var entries: [
+        { family: countdownFont.name, weight: Font.Normal, size: 200, text: root.digits },
+        { family: "Open Sans", weight: Font.Normal, size: 36, text: root.pending },
+        { family: "Open Sans", weight: Font.DemiBold, size: 36, text: root.pending },
+        { family: "Open Sans", weight: Font.Bold, size: 20, text: root.pending },
+        { family: "Open Sans", weight: Font.Bold, size: 32, text: root.pending },
+        { family: "Open Sans", weight: Font.Bold, size: 40, text: root.pending },
+        { family: "Open Sans", weight: Font.Bold, size: 64, text: root.pending }
+    ]
+
+    property bool warming: false
+
+    function prewarm() {
+        if (countdownFont.status !== FontLoader.Ready) {
+            return
+        }
+
+        // By code point, so characters outside the BMP stay whole
+        var added = ""
+        var characters = Array.from(glyphCache.characters)
+        for (var i = 0; i < characters.length; i++) {
+            if (!warmed[characters[i]]) {
+                warmed[characters[i]] = true
+                added += characters[i]
+            }
+        }
+        if (added === "" && digits === "") {
+            return
+        }
+
+        // Joins a pass that is still running
+        pending = warming ? pending + added : added
+        warming = true
+        doneTimer.restart()
+    }
+
+    // Same file as TimerApp's loader, resolves to the same family
+    FontLoader {
+        id: countdownFont
+        source: "qrc:/fonts/Countdown.ttf"
+        onStatusChanged: root.prewarm()
+    }
+
+    Loader {
+        active: root.warming
+        opacity: 0.01
+
+        sourceComponent: Column {
+            Repeater {
+                model: root.entries
+
+                Text {
+                    text: modelData.text
+                    font.family: modelData.family
+                    font.weight: modelData.weight
+                    font.pixelSize: modelData.size
+                    color: "#ffffff"
+                    // One long line per entry; only the atlas matters
+                    wrapMode: Text.NoWrap
+                }
+            }
+        }
+    }
+
+    // A handful of frames: glyphs are generated and uploaded on the first one
+    Timer {
+        id: doneTimer
+        interval: 500
+        onTriggered: {
+            root.warming = false
+            console.log("GlyphPrewarm:", Array.from(root.pending).length + root.digits.length,
+                        "new characters in", root.entries.length, "font sizes")
+            root.pending = ""
+            root.digits = ""
+        }
+    }
+
+    Connections {
+        target: glyphCache
+        function onCharactersChanged() {
+            root.prewarm()
+        }
+    }
+
+    Component.onCompleted: prewarm()
+}
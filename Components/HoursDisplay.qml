@@ -7,13 +7,13 @@ Item {
     property string textColor: "#FFFFFF"
     property string accentColor: "#FF5C00"
     property string titleText: "LAB HOURS"
-    property string todayName: Qt.formatDate(new Date(), "dddd").toLowerCase()
+    property string todayName: Qt.formatDate(new Date(clock.now()), "dddd").toLowerCase()
 
     // Function to get next 7 days starting from today
     function getNext7Days() {
         var days = ["sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"]
         var labels = ["SUNDAY", "MONDAY", "TUESDAY", "WEDNESDAY", "THURSDAY", "FRIDAY", "SATURDAY"]
-        var today = new Date()
+        var today = new Date(clock.now())
         var todayIndex = today.getDay()
         var result = []
 
@@ -1,5 +1,6 @@
 import QtQuick
 import QtQuick.Controls
+import Gladis 1.0
 
 // Image App (app_image) - Display full-screen image (ads, announcements, etc.)
 // Can be loaded on any layer
@@ -13,6 +14,19 @@ Item {
     property int fillMode: configManager.imageFillMode || Image.PreserveAspectFit
     property bool showBackground: configManager.imageShowBg || false
 
+    // Playlist mode ([app_image] image_playlist): sources come from the C++ scheduler,
+    // already decoded and switched on schedule
+    property bool playlistMode: playlist.active
+
+    // Cached by Qt's image cache under a URL carrying the file's modification time:
+    // every window showing the image shares one decode, a rewritten file (picked up
+    // when the path or [app_image] changes) is loaded again
+    property string imageUrl: ""
+    function updateImageUrl() {
+        imageUrl = fileIO.cacheUrl(root.imagePath)
+    }
+    onImagePathChanged: updateImageUrl()
+
     // Helper to check if file is GIF
     function isGifFile(path) {
         return path.toLowerCase().endsWith('.gif')
@@ -25,35 +39,29 @@ Item {
         z: -1  // Behind image
     }
 
-    // Current visible static image
-    Image {
+    // Current visible static image. A new source is decoded in the background and
+    // cross-faded in once ready (seamless swap, single GPU pass)
+    TransitionImage {
         id: mainImage
-        // For mode 0 (centered, no scaling), don't fill parent
-        anchors.centerIn: root.fillMode === 0 ? parent : undefined
-        anchors.fill: root.fillMode === 0 ? undefined : parent
-        source: !isGifFile(root.imagePath) && root.imagePath ? (root.imagePath.startsWith("file:") || root.imagePath.startsWith("qrc:/") ? root.imagePath : "file:" + root.imagePath) : ""
+        anchors.fill: parent
+        source: root.playlistMode ? playlist.currentSource : !isGifFile(root.imagePath) ? root.imageUrl : ""
         // fillMode mapping: 0=Pad (centered no scale), 1=PreserveAspectFit, 2=PreserveAspectCrop, 3=Stretch
-        fillMode: root.fillMode === 0 ? Image.Pad : root.fillMode
-        smooth: true
-        asynchronous: true
-        cache: false  // Don't cache so images update when INI changes
-        opacity: 1.0
-        z: 1  // On top of preloader
-        visible: !isGifFile(root.imagePath)
+        fillMode: root.fillMode === 0 ? Image.Pad : root.fillMode === 3 ? Image.Stretch : root.fillMode
+        mode: TransitionItem.Fade
+        duration: 200
+        z: 1
+        visible: root.playlistMode || !isGifFile(root.imagePath)
 
-        // Center the image if using PreserveAspectFit or PreserveAspectCrop
-        horizontalAlignment: Image.AlignHCenter
-        verticalAlignment: Image.AlignVCenter
-
-        Behavior on opacity {
-            NumberAnimation { duration: 200; easing.type: Easing.InOutQuad }
-        }
+        // Load + decode time for the metrics endpoint
+        property double loadStarted: 0
+        onSourceChanged: loadStarted = Date.now()
 
         onStatusChanged: {
             if (status === Image.Error) {
                 console.error("ImageApp: Failed to load image:", root.imagePath)
             } else if (status === Image.Ready) {
                 console.log("ImageApp: Image loaded successfully:", root.imagePath)
+                metrics.observeMs("gladis_image_decode_seconds", Date.now() - loadStarted, 'component="ImageApp"')
             }
         }
     }
@@ -64,15 +72,14 @@ Item {
         // For mode 0 (centered, no scaling), don't fill parent
         anchors.centerIn: root.fillMode === 0 ? parent : undefined
         anchors.fill: root.fillMode === 0 ? undefined : parent
-        source: isGifFile(root.imagePath) && root.imagePath ? (root.imagePath.startsWith("file:") || root.imagePath.startsWith("qrc:/") ? root.imagePath : "file:" + root.imagePath) : ""
+        source: !root.playlistMode && isGifFile(root.imagePath) ? root.imageUrl : ""
         // fillMode mapping: 0=Pad (centered no scale), 1=PreserveAspectFit, 2=PreserveAspectCrop, 3=Stretch
         fillMode: root.fillMode === 0 ? Image.Pad : root.fillMode
         smooth: true
         asynchronous: true
-        cache: false
         opacity: 1.0
         z: 1
-        visible: isGifFile(root.imagePath)
+        visible: !root.playlistMode && isGifFile(root.imagePath)
         playing: true  // Auto-play GIFs
 
         horizontalAlignment: Image.AlignHCenter
@@ -82,41 +89,15 @@ Item {
             NumberAnimation { duration: 200; easing.type: Easing.InOutQuad }
         }
 
+        property double loadStarted: 0
+        onSourceChanged: loadStarted = Date.now()
+
         onStatusChanged: {
             if (status === AnimatedImage.Error) {
                 console.error("ImageApp: Failed to load animated image:", root.imagePath)
             } else if (status === AnimatedImage.Ready) {
                 console.log("ImageApp: Animated image loaded successfully:", root.imagePath)
-            }
-        }
-    }
-
-    // Preloader image for seamless transitions
-    Image {
-        id: preloaderImage
-        anchors.centerIn: root.fillMode === 0 ? parent : undefined
-        anchors.fill: root.fillMode === 0 ? undefined : parent
-        fillMode: root.fillMode === 0 ? Image.Pad : root.fillMode
-        smooth: true
-        asynchronous: true
-        cache: false
-        opacity: 0.0
-        z: 0  // Behind main image
-        visible: false
-
-        horizontalAlignment: Image.AlignHCenter
-        verticalAlignment: Image.AlignVCenter
-
-        Behavior on opacity {
-            NumberAnimation { duration: 200; easing.type: Easing.InOutQuad }
-        }
-
-        onStatusChanged: {
-            if (status === Image.Ready) {
-                // New image loaded, now swap
-                visible = true
-                opacity = 1.0
-                mainImage.opacity = 0.0
+                metrics.observeMs("gladis_image_decode_seconds", Date.now() - loadStarted, 'component="ImageApp",type="gif"')
             }
         }
     }
@@ -175,47 +156,19 @@ Item {
     Connections {
         target: configManager
 
-        function onConfigChanged() {
+        function onImageChanged() {
             console.log("ImageApp: Config changed, reloading image...")
             console.log("  Image path:", root.imagePath)
             console.log("  Fill mode:", root.fillMode)
             console.log("  Background:", root.showBackground, root.backgroundColor)
 
-            // Seamless image swap: load new image in preloader first
-            var newSource = root.imagePath ? (root.imagePath.startsWith("file:") || root.imagePath.startsWith("qrc:/") ? root.imagePath : "file:" + root.imagePath) : ""
-
-            // Don't use preloader for GIFs (AnimatedImage handles it)
-            if (!isGifFile(root.imagePath)) {
-                if (newSource !== mainImage.source && newSource !== "") {
-                    // Start loading new image in background
-                    preloaderImage.source = newSource
-                } else if (newSource === "") {
-                    // If clearing image, just fade out
-                    mainImage.opacity = 0.0
-                }
-            }
-        }
-    }
-
-    // Handle preloader -> main swap completion
-    Connections {
-        target: preloaderImage
-
-        function onOpacityChanged() {
-            if (preloaderImage.opacity === 1.0 && mainImage.opacity === 0.0) {
-                // Swap complete, move preloader content to main
-                Qt.callLater(function() {
-                    mainImage.source = preloaderImage.source
-                    mainImage.opacity = 1.0
-                    preloaderImage.opacity = 0.0
-                    preloaderImage.visible = false
-                    preloaderImage.source = ""
-                })
-            }
+            // mainImage follows imageUrl and cross-fades once the new image is decoded
+            root.updateImageUrl()
         }
     }
 
     Component.onCompleted: {
+        updateImageUrl()
         console.log("ImageApp initialized")
         console.log("  Image path:", root.imagePath)
         console.log("  Fill mode:", root.fillMode)
@@ -0,0 +1,109 @@
+import QtQuick
+
+// Dynamic layer system of one output window (ScreenConfig: [app_live] for
+// main.qml, [app_screen_N] for ScreenWindow.qml).
+// Layer 0 is front-most (highest z-index); layers stack like z-index in CSS,
+// empty layers show nothing. The Loaders are named layer0..layer9 (render stats census).
+Item {
+    id: root
+
+    property var screenConfig: null
+
+    // True if at least one layer shows an app (the window draws its background then)
+    readonly property bool hasActiveLayer: {
+        if (!screenConfig) {
+            return false
+        }
+        for (var i = 0; i < screenConfig.layers.length; i++) {
+            var appName = screenConfig.layers[i]
+            if (appName !== "" && isAppStateActive(appName)) {
+                return true
+            }
+        }
+        return false
+    }
+
+    // Helper function to check if an app should be visible based on its state
+    function isAppStateActive(appName) {
+        if (appName === "app_timer") return configManager.timerState
+        if (appName === "app_alert") return configManager.alertState
+        if (appName === "app_blank") return configManager.blankState
+        if (appName === "app_hello") return configManager.helloState
+        // app_image and app_video have no state flag, always show if layer is set
+        return true
+    }
+
+    function appSource(appName) {
+        if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
+        if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
+        if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
+        if (appName === "app_video") return "qrc:/Components/VideoApp.qml"
+        if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
+        if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
+        return ""
+    }
+
+    // Pass the app's settings to the loaded component
+    function bindApp(item, appName) {
+        if (item && appName === "app_timer") {
+            item.timerState = Qt.binding(function() { return configManager.timerState })
+            item.timerCount = Qt.binding(function() { return configManager.timerCount })
+            item.timerMax = Qt.binding(function() { return configManager.timerMax })
+            item.timerText = Qt.binding(function() { return configManager.timerText })
+            item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
+            item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
+            item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
+            item.colorMain = Qt.binding(function() { return configManager.colorMain })
+            item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
+            item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
+            item.colorText = Qt.binding(function() { return configManager.colorText })
+        }
+        if (item && appName === "app_alert") {
+            item.alertState = Qt.binding(function() { return configManager.alertState })
+            item.alertText = Qt.binding(function() { return configManager.alertText })
+            item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
+            item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
+            item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
+            item.colorMain = Qt.binding(function() { return configManager.colorMain })
+            item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
+            item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
+            item.colorText = Qt.binding(function() { return configManager.colorText })
+        }
+        if (item && appName === "app_blank") {
+            item.blankState = Qt.binding(function() { return configManager.blankState })
+            item.blankFade = Qt.binding(function() { return configManager.blankFade })
+        }
+    }
+
+    Repeater {
+        model: 10
+
+        Loader {
+            id: layerLoader
+            objectName: "layer" + index
+
+            // Layer 9 is bottom-most (z: 10), layer 0 front-most (z: 100)
+            readonly property string appName: root.screenConfig ? root.screenConfig.layers[index] || "" : ""
+
+            anchors.fill: parent
+            z: (10 - index) * 10
+            active: appName !== "" && root.isAppStateActive(appName)
+            opacity: active ? 1.0 : 0.0
+            visible: opacity > 0.01
+
+            Behavior on opacity {
+                NumberAnimation {
+                    duration: root.screenConfig ? root.screenConfig.layerTransitions[index] : 300
+                    easing.type: Easing.InOutQuad
+                }
+            }
+
+            source: root.appSource(appName)
+
+            onLoaded: {
+                console.log("Screen", root.screenConfig.index, "layer", index, "loaded:", appName)
+                root.bindApp(item, appName)
+            }
+        }
+    }
+}
@@ -35,6 +35,9 @@ Rectangle {
     property int motionBlurRadius: 4  // 3-6 recommended for subtle effect
     property int motionBlurSamples: 8  // Higher = smoother but more GPU usage
 
+    // Snapshot key for the scroll offset across restarts, empty = not kept
+    property string stateKey: ""
+
     color: backgroundColor
 
     // Top line (optional)
@@ -115,7 +118,8 @@ Rectangle {
                     layer.smooth: true
 
                     // Apply horizontal motion blur for smooth scrolling (GPU-based custom shader)
-                    layer.effect: root.enableMotionBlur ? horizontalBlurShader : null
+                    // The quality governor turns it off first when frames are being dropped
+                    layer.effect: root.enableMotionBlur && qualityGovernor.motionBlurAllowed ? horizontalBlurShader : null
                 }
             }
 
@@ -128,30 +132,8 @@ Rectangle {
                     property real blurRadius: root.motionBlurRadius
                     property size sourceSize: Qt.size(width, height)
 
-                    // Horizontal box blur using Qt5-compatible GLSL
-                    fragmentShader: "
-                        varying highp vec2 qt_TexCoord0;
-                        uniform sampler2D source;
-                        uniform lowp float qt_Opacity;
-                        uniform highp float blurRadius;
-                        uniform highp vec2 sourceSize;
-
-                        void main() {
-                            highp vec4 sum = vec4(0.0);
-                            highp float samples = 5.0;  // Fixed sample count for consistency
-                            highp float pixelSize = 1.0 / sourceSize.x;
-                            highp float radius = blurRadius * pixelSize;
-
-                            // Horizontal box blur (5 samples)
-                            sum += texture2D(source, qt_TexCoord0 + vec2(-2.0 * radius, 0.0)) * 0.05;
-                            sum += texture2D(source, qt_TexCoord0 + vec2(-1.0 * radius, 0.0)) * 0.25;
-                            sum += texture2D(source, qt_TexCoord0) * 0.40;
-                            sum += texture2D(source, qt_TexCoord0 + vec2(1.0 * radius, 0.0)) * 0.25;
-                            sum += texture2D(source, qt_TexCoord0 + vec2(2.0 * radius, 0.0)) * 0.05;
-
-                            gl_FragColor = sum * qt_Opacity;
-                        }
-                    "
+                    // Horizontal box blur, precompiled (shaders/motionblur.frag via qt_add_shaders)
+                    fragmentShader: "qrc:/shaders/motionblur.frag.qsb"
                 }
             }
         }
@@ -179,10 +161,24 @@ Rectangle {
             }
         }
 
+        // One shortened pass from a restored offset, then the regular loop takes over
+        NumberAnimation {
+            id: resumeAnimation
+            target: scrollingRow
+            property: "x"
+            to: -(sourceText.width + root.textSpacing)
+            easing.type: Easing.Linear
+
+            onFinished: {
+                scrollingRow.x = 0
+                scrollAnimation.start()
+            }
+        }
+
         // Start animation when text is ready
         Component.onCompleted: {
             Qt.callLater(function() {
-                if (sourceText.width > 0 && root.text !== "") {
+                if (sourceText.width > 0 && root.text !== "" && !root.restoreState()) {
                     scrollAnimation.start()
                 }
             })
@@ -210,6 +206,7 @@ Rectangle {
             function onTextChanged() {
                 // Stop current animation
                 scrollAnimation.stop()
+                resumeAnimation.stop()
 
                 // Reset position to start
                 scrollingRow.x = 0
@@ -227,6 +224,39 @@ Rectangle {
         }
     }
 
+    // Scroll offset across restarts (stateSnapshot, [app_live] state_snapshot)
+    Connections {
+        target: root.stateKey !== "" ? stateSnapshot : null
+
+        function onSaving() {
+            stateSnapshot.setValue(root.stateKey, { "text": root.text, "offset": scrollingRow.x })
+        }
+
+        function onRestored() {
+            root.restoreState()
+        }
+    }
+
+    // Continue from the snapshot's offset if it was taken of the same text
+    function restoreState() {
+        var state = root.stateKey !== "" ? stateSnapshot.value(root.stateKey) : undefined
+        if (!state || state.text !== root.text || sourceText.width <= 0) {
+            return false
+        }
+
+        // Keep scrolling through the time the restart took
+        var period = sourceText.width + root.textSpacing
+        var offset = (-state.offset + stateSnapshot.ageMs / 1000 * root.scrollSpeed) % period
+
+        scrollAnimation.stop()
+        resumeAnimation.stop()
+        scrollingRow.x = -offset
+        resumeAnimation.from = -offset
+        resumeAnimation.duration = (period - offset) / root.scrollSpeed * 1000
+        resumeAnimation.start()
+        return true
+    }
+
     // Debug info (can be removed in production)
     Component.onCompleted: {
         console.log("PixmapScrollingText initialized")
@@ -0,0 +1,100 @@
+import QtQuick
+
+// Render statistics overlay - toggled by render_stats in [app_live]
+// Draws on top of contentContainer; everything here is plain Rectangles/Text
+// so the overlay adds a handful of batches and no FBOs or shader effects.
+Rectangle {
+    id: root
+    objectName: "renderStatsOverlay"  // Excluded from the item census
+
+    // --- CONFIGURATION ---
+    property real budgetMs: 1000 / 60  // Frame budget line in the graph
+    property real graphMaxMs: 50
+
+    width: 340
+    height: content.height + 16
+    color: "#cc000000"
+    radius: 6
+
+    Column {
+        id: content
+        x: 8
+        y: 8
+        width: parent.width - 16
+        spacing: 4
+
+        Text {
+            color: "#ffffff"
+            font.pixelSize: 13
+            font.bold: true
+            text: "FPS " + renderStats.fps.toFixed(1) +
+                  "   frame " + renderStats.frameTimeMs.toFixed(1) + " ms" +
+                  "   p95 " + renderStats.frameTimeP95Ms.toFixed(1) + " ms"
+        }
+
+        // Frame time graph, newest on the right
+        Item {
+            width: parent.width
+            height: 60
+
+            Rectangle {
+                anchors.fill: parent
+                color: "#33ffffff"
+            }
+
+            Row {
+                anchors.right: parent.right
+                height: parent.height
+                spacing: 0
+
+                Repeater {
+                    model: renderStats.frameTimes
+                    Rectangle {
+                        width: 324 / 120
+                        height: Math.min(60, modelData / root.graphMaxMs * 60)
+                        y: 60 - height
+                        color: modelData > root.budgetMs * 1.5 ? "#ff4040" : "#40ff80"
+                    }
+                }
+            }
+
+            // Frame budget
+            Rectangle {
+                width: parent.width
+                height: 1
+                y: parent.height - root.budgetMs / root.graphMaxMs * parent.height
+                color: "#ffff00"
+            }
+        }
+
+        Text {
+            color: qualityGovernor.tier > 0 ? "#ffd040" : "#ffffff"
+            font.pixelSize: 12
+            text: "quality tier " + qualityGovernor.tier + " (" + qualityGovernor.tierName + ")" +
+                  (qualityGovernor.temperature >= 0 ? "   SoC " + qualityGovernor.temperature.toFixed(1) + " C" : "")
+        }
+
+        Text {
+            color: "#ffffff"
+            font.pixelSize: 12
+            text: "batches/frame " + (renderStats.batchesPerFrame < 0 ? "n/a" : renderStats.batchesPerFrame.toFixed(1)) +
+                  "   uploads/frame " + renderStats.uploadsPerFrame.toFixed(2) +
+                  " (" + (renderStats.uploadBytesPerFrame / 1024).toFixed(0) + " KiB)"
+        }
+
+        // Per layer: items, FBOs (layer.enabled / ShaderEffectSource), effects, animations, timers
+        Repeater {
+            model: renderStats.layers
+            Text {
+                color: modelData.fbos > 0 || modelData.effects > 0 ? "#ffd040" : "#d0d0d0"
+                font.pixelSize: 12
+                font.family: "monospace"
+                text: modelData.name + ": items " + modelData.items +
+                      "  fbo " + modelData.fbos +
+                      "  fx " + modelData.effects +
+                      "  anim " + modelData.animations +
+                      "  timer " + modelData.timers
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+import QtQuick
+import QtQuick.Window
+
+// Additional output window ([app_screen_N]), created by ScreenManager in the
+// main engine: it shares dataManager, configManager, the image providers and
+// the decoded image cache with main.qml, and only has its own layer stack,
+// render_window and rotation.
+Window {
+    id: screenWindow
+
+    property var screenConfig: null
+    // Per window; shadows the primary window's context property
+    property var displayRotation: null
+    // Warm standby, see main.qml
+    property bool standby: false
+
+    visible: !standby
+    visibility: standby ? Window.Hidden : screenConfig.renderScreen === 1 ? Window.FullScreen : Window.Windowed
+    width: displayRotation.swapsAxes ? screenConfig.renderHeight : screenConfig.renderWidth
+    height: displayRotation.swapsAxes ? screenConfig.renderWidth : screenConfig.renderHeight
+    title: "GameLab Esports Dashboard - screen " + screenConfig.index
+    color: "#333333"
+    flags: Qt.Window | Qt.FramelessWindowHint
+
+    Component.onCompleted: {
+        console.log("Screen", screenConfig.index, "window initialized - Mode:",
+                    screenConfig.renderScreen === 1 ? "FullScreen" : "Windowed",
+                    "Dimensions:", width, "x", height, "Rotation:", screenConfig.renderRotate, displayRotation.mode)
+    }
+
+    // Rotatable content container
+    Item {
+        id: contentContainer
+        objectName: "contentContainer"
+        anchors.centerIn: parent
+        width: screenWindow.screenConfig.renderWidth
+        height: screenWindow.screenConfig.renderHeight
+        rotation: screenWindow.displayRotation.contentRotation
+        visible: !screenWindow.standby
+
+        // Offscreen rotation, see main.qml
+        layer.enabled: screenWindow.displayRotation.offscreen
+        layer.smooth: false
+
+        // Every window has its own glyph atlas
+        GlyphPrewarm {
+            z: -1
+        }
+
+        Rectangle {
+            anchors.fill: parent
+            visible: layerStack.hasActiveLayer
+            gradient: Gradient {
+                GradientStop { position: 0.0; color: configManager.colorBg01 }
+                GradientStop { position: 1.0; color: configManager.colorBg02 }
+            }
+        }
+
+        LayerStack {
+            id: layerStack
+            anchors.fill: parent
+            screenConfig: screenWindow.screenConfig
+        }
+    }
+}
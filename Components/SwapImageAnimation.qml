@@ -1,4 +1,5 @@
 import QtQuick
+import Gladis 1.0
 
 Item {
     id: root
@@ -30,33 +31,16 @@ Item {
                 height: parent.height
                 color: "#1a1a1a"
                 radius: 12
-                clip: true
 
-                Image {
+                // Fade out / fade in of the swapped source, one GPU pass
+                TransitionImage {
                     id: leftPosImage
                     anchors.fill: parent
                     source: root.isSwapped ? root.rightImageSource : root.leftImageSource
                     fillMode: Image.PreserveAspectCrop
-                    smooth: true
-                    asynchronous: true
-
-                    Behavior on source {
-                        SequentialAnimation {
-                            NumberAnimation {
-                                target: leftPosImage
-                                property: "opacity"
-                                to: 0
-                                duration: root.swapDuration / 2
-                            }
-                            PropertyAction { target: leftPosImage; property: "source" }
-                            NumberAnimation {
-                                target: leftPosImage
-                                property: "opacity"
-                                to: 1
-                                duration: root.swapDuration / 2
-                            }
-                        }
-                    }
+                    mode: TransitionItem.Swap
+                    duration: root.swapDuration
+                    easingType: Easing.Linear
                 }
 
                 Rectangle {
@@ -81,33 +65,15 @@ Item {
                 height: parent.height
                 color: "#1a1a1a"
                 radius: 12
-                clip: true
 
-                Image {
+                TransitionImage {
                     id: rightPosImage
                     anchors.fill: parent
                     source: root.isSwapped ? root.leftImageSource : root.rightImageSource
                     fillMode: Image.PreserveAspectFit
-                    smooth: true
-                    asynchronous: true
-
-                    Behavior on source {
-                        SequentialAnimation {
-                            NumberAnimation {
-                                target: rightPosImage
-                                property: "opacity"
-                                to: 0
-                                duration: root.swapDuration / 2
-                            }
-                            PropertyAction { target: rightPosImage; property: "source" }
-                            NumberAnimation {
-                                target: rightPosImage
-                                property: "opacity"
-                                to: 1
-                                duration: root.swapDuration / 2
-                            }
-                        }
-                    }
+                    mode: TransitionItem.Swap
+                    duration: root.swapDuration
+                    easingType: Easing.Linear
                 }
 
                 Rectangle {
@@ -26,9 +26,9 @@ Rectangle {
     property string timerMenuMiddle: ""
     property string timerMenuRight: "START OVER"
 
-    // File paths
-    property string timerAlert: configManager.timerAlert || "/dev/shm/app/timer_alert"
-    property string timerReset: configManager.timerReset || "/dev/shm/app/timer_reset"
+    // File paths; on extra screens the file names carry the screen prefix
+    property string timerAlert: screenFile(configManager.timerAlert || "/dev/shm/app/timer_alert")
+    property string timerReset: screenFile(configManager.timerReset || "/dev/shm/app/timer_reset")
     property string buttonDir: configManager.buttonDir || "/dev/shm/app/"
 
     // Button press state tracking
@@ -207,10 +207,10 @@ Rectangle {
                         root.isCountdownActive = true
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.timerMenuLeft.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuLeft.replace(/\s+/g, "_")
                         root.leftButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.leftButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -263,10 +263,10 @@ Rectangle {
                         console.log("Middle button clicked")
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.timerMenuMiddle.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuMiddle.replace(/\s+/g, "_")
                         root.middleButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.middleButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -320,10 +320,10 @@ Rectangle {
                         // Keep the timer running if it was already running
 
                         // Create button press file
-                        var buttonFile = root.buttonDir + "button_" + root.timerMenuRight.replace(/\s+/g, "_")
-                        fileIO.writeFile(buttonFile, "1")
+                        var buttonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuRight.replace(/\s+/g, "_")
                         root.rightButtonPressed = true
-                        fileIO.watchFile(buttonFile)
+                        buttonLatency.pressed(buttonFile)
+                        root.submitButton(buttonFile, function(v) { root.rightButtonPressed = v })
                         console.log("Button pressed, created file:", buttonFile)
                     }
                 }
@@ -354,14 +354,14 @@ Rectangle {
         onRunningChanged: {
             if (running) {
                 // Reset drift tracking when timer starts
-                lastTickTime = Date.now()
+                lastTickTime = clock.now()
                 drift = 0
             }
         }
 
         onTriggered: {
             // Calculate actual time elapsed since last tick
-            var currentTime = Date.now()
+            var currentTime = clock.now()
             var elapsed = currentTime - lastTickTime
 
             // Accumulate drift (difference from expected 1000ms)
@@ -403,25 +403,40 @@ Rectangle {
                 root.isCountdownActive = false
 
                 // Delete the reset file
-                fileIO.deleteFile(root.timerReset)
+                fileIO.deleteFileAsync(root.timerReset)
             }
 
             // Check for button file deletions (file no longer exists = re-enable button)
-            var leftButtonFile = root.buttonDir + "button_" + root.timerMenuLeft.replace(/\s+/g, "_")
-            var middleButtonFile = root.buttonDir + "button_" + root.timerMenuMiddle.replace(/\s+/g, "_")
-            var rightButtonFile = root.buttonDir + "button_" + root.timerMenuRight.replace(/\s+/g, "_")
-
-            if (path === leftButtonFile && !fileIO.fileExists(leftButtonFile)) {
-                console.log("Left button file deleted, re-enabling button")
-                root.leftButtonPressed = false
+            var leftButtonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuLeft.replace(/\s+/g, "_")
+            var middleButtonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuMiddle.replace(/\s+/g, "_")
+            var rightButtonFile = root.buttonDir + screenPrefix + "button_" + root.timerMenuRight.replace(/\s+/g, "_")
+
+            if (path === leftButtonFile) {
+                fileIO.fileExistsAsync(leftButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Left button file deleted, re-enabling button")
+                        root.leftButtonPressed = false
+                        buttonLatency.acknowledged(leftButtonFile)
+                    }
+                })
             }
-            if (path === middleButtonFile && !fileIO.fileExists(middleButtonFile)) {
-                console.log("Middle button file deleted, re-enabling button")
-                root.middleButtonPressed = false
+            if (path === middleButtonFile) {
+                fileIO.fileExistsAsync(middleButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Middle button file deleted, re-enabling button")
+                        root.middleButtonPressed = false
+                        buttonLatency.acknowledged(middleButtonFile)
+                    }
+                })
             }
-            if (path === rightButtonFile && !fileIO.fileExists(rightButtonFile)) {
-                console.log("Right button file deleted, re-enabling button")
-                root.rightButtonPressed = false
+            if (path === rightButtonFile) {
+                fileIO.fileExistsAsync(rightButtonFile, function(exists) {
+                    if (!exists) {
+                        console.log("Right button file deleted, re-enabling button")
+                        root.rightButtonPressed = false
+                        buttonLatency.acknowledged(rightButtonFile)
+                    }
+                })
             }
         }
     }
@@ -429,12 +444,98 @@ Rectangle {
     Component.onCompleted: {
         // Start watching for timer reset file
         fileIO.watchFile(root.timerReset)
+        // After main.qml's onLoaded bindings, which would reset the countdown
+        Qt.callLater(restoreState)
+    }
+
+    // Running state across restarts (stateSnapshot, [app_live] state_snapshot)
+    Connections {
+        target: stateSnapshot
+
+        function onSaving() {
+            stateSnapshot.setValue(screenPrefix + "timer.time", root.currentTime)
+            stateSnapshot.setValue(screenPrefix + "timer.active", root.isCountdownActive)
+            stateSnapshot.setValue(screenPrefix + "timer.pressed", [root.leftButtonPressed, root.middleButtonPressed, root.rightButtonPressed])
+        }
+
+        function onRestored() {
+            root.restoreState()
+        }
+    }
+
+    function restoreState() {
+        if (!stateSnapshot.contains(screenPrefix + "timer.time")) {
+            return
+        }
+        root.isCountdownActive = stateSnapshot.value(screenPrefix + "timer.active", root.isCountdownActive)
+        var time = stateSnapshot.value(screenPrefix + "timer.time", root.currentTime)
+        // Keep counting through the time the restart took
+        if (root.isCountdownActive && root.timerState && time > 0) {
+            time = Math.max(0, time - Math.floor(stateSnapshot.ageMs / 1000))
+            if (time === 0) {
+                writeTimerAlertFile()
+            }
+        }
+        root.currentTime = Math.min(time, root.timerMax)
+
+        // Pressed until the controller removes the button file; it may have done so meanwhile
+        var pressed = stateSnapshot.value(screenPrefix + "timer.pressed", [])
+        var labels = [root.timerMenuLeft, root.timerMenuMiddle, root.timerMenuRight]
+        var setters = [function(v) { root.leftButtonPressed = v },
+                       function(v) { root.middleButtonPressed = v },
+                       function(v) { root.rightButtonPressed = v }]
+        for (var i = 0; i < 3; i++) {
+            if (!pressed[i] || labels[i] === "") {
+                continue
+            }
+            var buttonFile = root.buttonDir + screenPrefix + "button_" + labels[i].replace(/\s+/g, "_")
+            setters[i](true)
+            fileIO.watchFile(buttonFile)
+            fileIO.fileExistsAsync(buttonFile, (function(setPressed) {
+                return function(exists) {
+                    if (!exists) {
+                        setPressed(false)
+                    }
+                }
+            })(setters[i]))
+        }
+        console.log("TimerApp: restored - time:", root.currentTime, "active:", root.isCountdownActive, "pressed:", pressed)
+    }
+
+    // Write the button file off the GUI thread and stay pressed until the
+    // controller removes it - which it may do before the write callback runs
+    function submitButton(buttonFile, setPressed) {
+        fileIO.writeFileAsync(buttonFile, "1", function(success) {
+            if (!success) {
+                // Nothing will acknowledge it, so let the button be pressed again
+                console.warn("Button file could not be written:", buttonFile)
+                setPressed(false)
+                return
+            }
+            fileIO.watchFile(buttonFile)
+            fileIO.fileExistsAsync(buttonFile, function(exists) {
+                if (!exists) {
+                    setPressed(false)
+                    buttonLatency.acknowledged(buttonFile)
+                }
+            })
+        })
+    }
+
+    // Puts the screen prefix in front of the file name, "" on the main window
+    function screenFile(path) {
+        var slash = path.lastIndexOf("/")
+        return path.substring(0, slash + 1) + screenPrefix + path.substring(slash + 1)
     }
 
     // Helper function to write timer alert file
     function writeTimerAlertFile() {
         console.log("Timer expired - writing alert file:", root.timerAlert)
-        fileIO.writeFile(root.timerAlert, "1")
+        fileIO.writeFileAsync(root.timerAlert, "1", function(success) {
+            if (!success) {
+                console.warn("Timer alert file could not be written:", root.timerAlert)
+            }
+        })
     }
     
     // Sync isCountdownActive with timerCount from INI
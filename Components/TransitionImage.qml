@@ -0,0 +1,133 @@
+import QtQuick
+import Gladis 1.0
+
+// Image that transitions to a new source on the GPU: the next image is loaded
+// in the background and, once ready, blended in by a single TransitionItem
+// (one draw call, no stacked opacity animations or clip nodes).
+Item {
+    id: root
+
+    property url source: ""
+    property int fillMode: Image.PreserveAspectFit
+    property int mode: TransitionItem.Fade
+    property int duration: 500
+    property int easingType: Easing.InOutQuad
+    property real softness: 0.05
+    property bool asynchronous: true
+    property bool cache: true
+    property bool smooth: true
+
+    // Status of the most recently requested source (loading while a transition is pending)
+    readonly property int status: pending.status
+    readonly property bool running: progressAnimation.running
+
+    signal transitionFinished()
+
+    // Two images used ping-pong: "front" is shown, "pending" receives the next source.
+    // They only provide textures; opacity 0 keeps them out of the render pass while
+    // their textures stay up to date (invisible items are not synced).
+    property Image front: imageA
+    property Image pending: imageA
+
+    Image {
+        id: imageA
+        anchors.fill: parent
+        opacity: 0
+        fillMode: root.fillMode
+        asynchronous: root.asynchronous
+        cache: root.cache
+        smooth: root.smooth
+        onStatusChanged: root.imageStatusChanged(imageA)
+    }
+
+    Image {
+        id: imageB
+        anchors.fill: parent
+        opacity: 0
+        fillMode: root.fillMode
+        asynchronous: root.asynchronous
+        cache: root.cache
+        smooth: root.smooth
+        onStatusChanged: root.imageStatusChanged(imageB)
+    }
+
+    TransitionItem {
+        id: transition
+        anchors.fill: parent
+        mode: root.mode
+        fillMode: root.fillMode
+        softness: root.softness
+        progress: 1.0
+    }
+
+    NumberAnimation {
+        id: progressAnimation
+        target: transition
+        property: "progress"
+        from: 0.0
+        to: 1.0
+        duration: root.duration
+        easing.type: root.easingType
+        onFinished: root.transitionFinished()
+    }
+
+    onSourceChanged: {
+        // A transition in flight is completed instantly (its target is already the front image)
+        if (progressAnimation.running) {
+            progressAnimation.stop()
+            transition.progress = 1.0
+        }
+
+        if (source.toString() === front.source.toString() && front.status !== Image.Null) {
+            pending = front
+            return
+        }
+
+        pending = (front === imageA) ? imageB : imageA
+        pending.source = source
+        if (pending.status === Image.Ready || pending.status === Image.Null) {
+            startTransition()  // Cached, synchronous or cleared
+        }
+    }
+
+    function imageStatusChanged(image) {
+        if (image !== pending || image === front) {
+            return
+        }
+        if (image.status === Image.Ready || image.status === Image.Error) {
+            startTransition()
+        }
+    }
+
+    function startTransition() {
+        var previous = front
+        transition.from = previous
+        transition.to = pending
+        front = pending
+        transition.progress = 0.0
+        progressAnimation.restart()
+
+        // Release the old texture once it is fully blended out
+        releaseTimer.previous = previous
+        releaseTimer.interval = root.duration + 50
+        releaseTimer.restart()
+    }
+
+    Timer {
+        id: releaseTimer
+        property Image previous: null
+        onTriggered: {
+            if (previous && previous !== root.front && previous !== root.pending) {
+                previous.source = ""
+            }
+        }
+    }
+
+    Component.onCompleted: {
+        if (source != "") {
+            imageA.source = source
+            transition.from = imageA
+            transition.to = imageA
+        }
+    }
+}
@@ -0,0 +1,111 @@
+import QtQuick
+import QtMultimedia
+
+// Video App (app_video) - Looping promo clip (H.264/HEVC)
+// Can be loaded on any layer. Frames reach the scene graph as YUV textures
+// (GPU textures when the decoder is hardware accelerated, CPU planes with
+// software decoding) and are converted to RGB in the VideoOutput shader.
+Item {
+    id: root
+    anchors.fill: parent
+
+    // Configuration properties
+    property string videoPath: configManager.videoSource || ""
+    property string backgroundColor: configManager.videoBgColor || "#000000"
+    property int fillMode: configManager.videoFillMode
+    property bool loop: configManager.videoLoop
+    property bool muted: configManager.videoMuted
+
+    function toUrl(path) {
+        if (!path) return ""
+        return path.startsWith("file:") || path.startsWith("qrc:/") ? path : "file:" + path
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: root.backgroundColor
+    }
+
+    MediaPlayer {
+        id: player
+        source: root.toUrl(root.videoPath)
+        loops: root.loop ? MediaPlayer.Infinite : 1
+        videoOutput: videoOutput
+        audioOutput: root.muted ? null : audioOutput
+
+        onSourceChanged: {
+            if (videoStats.isAttached(videoOutput.videoSink)) {
+                videoStats.reset()
+            }
+            if (source != "") {
+                play()
+            }
+        }
+
+        onErrorOccurred: function(error, errorString) {
+            console.error("VideoApp: Playback error:", errorString, "-", root.videoPath)
+        }
+
+        // Resumed after a pause: the wall clock moved on, the timestamps did not
+        onPlaybackStateChanged: {
+            if (playbackState === MediaPlayer.PlayingState && videoStats.isAttached(videoOutput.videoSink)) {
+                videoStats.restartTimeline()
+            }
+        }
+
+        onMediaStatusChanged: {
+            if (mediaStatus === MediaPlayer.LoadedMedia) {
+                console.log("VideoApp: Loaded", root.videoPath,
+                            "- video tracks:", videoTracks.length, "duration:", duration, "ms")
+            }
+        }
+    }
+
+    AudioOutput {
+        id: audioOutput
+    }
+
+    VideoOutput {
+        id: videoOutput
+        anchors.fill: parent
+        // 0=Stretch, 1=PreserveAspectFit, 2=PreserveAspectCrop
+        fillMode: root.fillMode === 0 ? VideoOutput.Stretch :
+                  root.fillMode === 2 ? VideoOutput.PreserveAspectCrop : VideoOutput.PreserveAspectFit
+    }
+
+    // Dropped frames / frame delay for the log and the metrics endpoint
+    Timer {
+        interval: 30000
+        running: player.playbackState === MediaPlayer.PlayingState
+        repeat: true
+        onTriggered: {
+            if (!videoStats.isAttached(videoOutput.videoSink)) {
+                return
+            }
+            console.log("VideoApp: frames:", videoStats.framesReceived, "dropped:", videoStats.droppedFrames,
+                        "delay:", videoStats.delayMs.toFixed(1), "ms (max", videoStats.maxDelayMs.toFixed(1), "ms)",
+                        "format:", videoStats.pixelFormat, videoStats.gpuFrames ? "GPU frames" : "CPU planes")
+        }
+    }
+
+    Component.onCompleted: {
+        console.log("VideoApp initialized - Source:", root.videoPath, "Loop:", root.loop, "Muted:", root.muted)
+        videoStats.attach(videoOutput.videoSink)
+        if (player.source != "" && root.visible) {
+            player.play()
+        }
+    }
+
+    // No decoding while hidden (warm standby), resume on takeover
+    onVisibleChanged: {
+        if (!visible) {
+            player.pause()
+        } else if (player.source != "") {
+            player.play()
+        }
+    }
+
+    Component.onDestruction: {
+        videoStats.detach(videoOutput.videoSink)
+    }
+}
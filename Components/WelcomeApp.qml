@@ -59,6 +59,7 @@ Item {
                 showBottomLine: true
                 scrollSpeed: 100
                 textSpacing: 150
+                stateKey: screenPrefix + "hello.ticker.top"
                 enableMotionBlur: false
                 motionBlurRadius: 4
             }
@@ -114,6 +115,7 @@ Item {
                 showTopLine: true
                 scrollSpeed: 100
                 textSpacing: 150
+                stateKey: screenPrefix + "hello.ticker.bottom"
                 enableMotionBlur: false
                 motionBlurRadius: 4
             }
@@ -218,6 +220,7 @@ Item {
                         id: carouselCentered
                         anchors.fill: parent
                         gameImages: root.gameImages
+                        stateKey: screenPrefix + "hello.carousel.centered"
                     }
                 }
             }
@@ -257,6 +260,7 @@ Item {
                             anchors.horizontalCenter: parent.horizontalCenter
                             anchors.verticalCenter: parent.verticalCenter
                             gameImages: root.gameImages
+                            stateKey: screenPrefix + "hello.carousel"
                         }
                     }
                 }
@@ -369,11 +373,11 @@ Item {
         }
     }
 
-    // Config update handler
+    // Config update handler ([app_hello] section only)
     Connections {
         target: configManager
 
-        function onConfigChanged() {
+        function onHelloChanged() {
             console.log("Config changed, reloading Welcome App UI...")
 
             // Update game images array
@@ -1,4 +1,5 @@
 import QtQuick
+import Gladis 1.0
 
 Item {
     id: root
@@ -76,15 +77,15 @@ Item {
                 anchors.fill: parent
                 radius: 50
                 color: "transparent"
-                clip: true
 
-                Image {
+                // New show images wipe in; fit is applied in the shader, no clip node needed
+                TransitionImage {
                     id: leftPosImage
                     anchors.fill: parent
                     source: root.leftImageSource
                     fillMode: Image.PreserveAspectFit
-                    smooth: true
-                    asynchronous: true
+                    mode: TransitionItem.Wipe
+                    duration: 800  // Match carousel rotation speed
                 }
             }
         }
@@ -127,15 +128,15 @@ Item {
                 anchors.fill: parent
                 radius: 15
                 color: "transparent"
-                clip: true
 
-                Image {
+                // New show images wipe in; fit is applied in the shader, no clip node needed
+                TransitionImage {
                     id: rightPosImage
                     anchors.fill: parent
                     source: root.rightImageSource
                     fillMode: Image.PreserveAspectFit
-                    smooth: true
-                    asynchronous: true
+                    mode: TransitionItem.Wipe
+                    duration: 800  // Match carousel rotation speed
                 }
             }
         }
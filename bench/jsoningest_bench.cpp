@@ -0,0 +1,232 @@
+// gladis_jsonbench: parse time and peak memory of user_data.json ingest, the
+// QJsonDocument path (read whole file, build document, toVariantMap) against
+// the streaming path (PlayerFeed::ingest into the feed models).
+//
+//   gladis_jsonbench                          # 1k, 10k, 100k entries
+//   gladis_jsonbench --entries 500000 --runs 3 --csv jsonbench.csv
+//
+// Files are synthetic: the summary counters plus "players" and "leaderboard"
+// arrays of N entries each. Time is the median of --runs parses in this
+// process. Peak memory is measured once per case in a forked child: VmHWM
+// after the parse minus VmRSS before it (the high-water mark is reset through
+// /proc/self/clear_refs), with the result still alive, as when it is on screen.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVariantMap>
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "playerfeed.h"
+
+namespace {
+
+enum Path {
+    Document,       // Current DataManager JsonSlot code
+    Stream,         // First load into empty models
+    StreamReload    // Reload into models already holding the same feed (row diff, no changes)
+};
+
+const char *pathName(Path path)
+{
+    switch (path) {
+    case Document: return "document";
+    case Stream: return "stream";
+    case StreamReload: return "stream-reload";
+    }
+    return "";
+}
+
+void writeFeed(const QString &path, int entries)
+{
+    static const char *games[] = { "Fortnite", "Rocket League", "Minecraft", "Valorant",
+                                   "Mario Kart 8", "Overwatch 2", "EA FC 25", "Tetris 99" };
+    static const char *platforms[] = { "xbox", "ps5", "switch", "pc", "arcade" };
+
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    QTextStream out(&file);
+    out << "{\n  \"total\": " << entries << ", \"playing\": " << entries * 9 / 10
+        << ", \"xbox\": 6, \"ps5\": 1, \"switch\": 2, \"pc\": 0, \"arcade\": 0,\n  \"players\": [\n";
+    for (int i = 0; i < entries; i++) {
+        out << "    {\"name\": \"Player " << i << "\", \"game\": \"" << games[i % 8]
+            << "\", \"platform\": \"" << platforms[i % 5] << "\", \"station\": " << i % 64
+            << ", \"minutes\": " << (i * 7) % 180 << "}" << (i + 1 < entries ? ",\n" : "\n");
+    }
+    out << "  ],\n  \"leaderboard\": [\n";
+    for (int i = 0; i < entries; i++) {
+        out << "    {\"name\": \"Player " << (i * 31) % entries << "\", \"game\": \"" << games[i % 8]
+            << "\", \"platform\": \"" << platforms[i % 5] << "\", \"score\": " << qint64(entries - i) * 1000
+            << "}" << (i + 1 < entries ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// One parse; the result is kept in the holders so peak memory includes it
+struct Holder {
+    QVariantMap map;
+    PlayerFeedModel players;
+    PlayerFeedModel leaderboard;
+};
+
+bool parse(Path path, const QString &fileName, Holder *holder)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    if (path == Document) {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        holder->map = doc.object().toVariantMap();
+        return error.error == QJsonParseError::NoError;
+    }
+    return PlayerFeed::ingest(&file, &holder->map, &holder->players, &holder->leaderboard, nullptr);
+}
+
+qint64 statusKb(const char *field)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QByteArray prefix = QByteArray(field) + ':';
+    for (const QByteArray &line : status.readAll().split('\n')) {
+        if (line.startsWith(prefix)) {
+            return line.mid(prefix.size()).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+double medianMs(Path path, const QString &fileName, int runs)
+{
+    QVector<double> times;
+    for (int r = 0; r < runs; r++) {
+        Holder holder;
+        if (path == StreamReload) {
+            parse(Stream, fileName, &holder);
+        }
+        QElapsedTimer timer;
+        timer.start();
+        if (!parse(path, fileName, &holder)) {
+            return -1;
+        }
+        times.append(timer.nsecsElapsed() / 1e6);
+    }
+    std::sort(times.begin(), times.end());
+    return times.at(times.size() / 2);
+}
+
+// Peak KiB above the starting RSS, -1 if it could not be measured
+qint64 peakKb(Path path, const QString &fileName, bool *hwmReset)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        Holder *holder = new Holder;
+        if (path == StreamReload) {
+            parse(Stream, fileName, holder);
+        }
+
+        QFile clearRefs("/proc/self/clear_refs");
+        bool reset = clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+        clearRefs.close();
+        qint64 before = statusKb("VmRSS");
+        parse(path, fileName, holder);
+        qint64 peak = statusKb("VmHWM");
+
+        qint64 result[2] = { before >= 0 && peak >= 0 ? peak - before : -1, reset ? 1 : 0 };
+        ssize_t written = write(fds[1], result, sizeof(result));
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    qint64 result[2] = { -1, 0 };
+    if (pid < 0 || read(fds[0], result, sizeof(result)) != sizeof(result)) {
+        result[0] = -1;
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    *hwmReset = result[1] != 0;
+    return result[0];
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("gladis_jsonbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks user_data.json ingest: QJsonDocument vs streaming.");
+    parser.addHelpOption();
+    QCommandLineOption entriesOption("entries", "Comma-separated entry counts (default 1000,10000,100000).", "list", "1000,10000,100000");
+    QCommandLineOption runsOption("runs", "Timed parses per case, the median is reported (default 5).", "n", "5");
+    QCommandLineOption csvOption("csv", "Also write the results as CSV.", "file");
+    parser.addOption(entriesOption);
+    parser.addOption(runsOption);
+    parser.addOption(csvOption);
+    parser.process(app);
+
+    const int runs = qMax(1, parser.value(runsOption).toInt());
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        QTextStream(stderr) << "gladis_jsonbench: no temporary directory" << Qt::endl;
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    QStringList csv { "entries,bytes,path,median_ms,peak_kb" };
+    bool allReset = true;
+    out << QString("%1 %2 %3 %4 %5").arg("entries", 8).arg("bytes", 11).arg("path", -14)
+               .arg("median ms", 10).arg("peak KiB", 10) << Qt::endl;
+
+    for (const QString &value : parser.value(entriesOption).split(',', Qt::SkipEmptyParts)) {
+        const int entries = value.toInt();
+        if (entries <= 0) {
+            continue;
+        }
+        const QString fileName = dir.filePath(QString("user_data_%1.json").arg(entries));
+        writeFeed(fileName, entries);
+        const qint64 bytes = QFile(fileName).size();
+
+        for (Path path : { Document, Stream, StreamReload }) {
+            double ms = medianMs(path, fileName, runs);
+            bool reset = false;
+            qint64 peak = peakKb(path, fileName, &reset);
+            allReset = allReset && reset;
+            out << QString("%1 %2 %3 %4 %5").arg(entries, 8).arg(bytes, 11).arg(pathName(path), -14)
+                       .arg(ms, 10, 'f', 2).arg(peak, 10) << Qt::endl;
+            csv << QString("%1,%2,%3,%4,%5").arg(entries).arg(bytes).arg(pathName(path))
+                       .arg(ms, 0, 'f', 3).arg(peak);
+        }
+    }
+
+    if (!allReset) {
+        out << "note: /proc/self/clear_refs not writable, peak includes memory touched before the parse" << Qt::endl;
+    }
+
+    if (parser.isSet(csvOption)) {
+        QFile file(parser.value(csvOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            QTextStream(stderr) << "gladis_jsonbench: cannot write " << file.fileName() << Qt::endl;
+            return 1;
+        }
+        file.write(csv.join('\n').toUtf8() + '\n');
+    }
+    return 0;
+}
@@ -0,0 +1,412 @@
+// gladis_microbench: QBENCHMARK timings of the config, data and file I/O paths
+// on synthetic inputs, so changes to these classes can be measured.
+//
+//   gladis_microbench                                   # all, text output
+//   gladis_microbench loadSlot                          # one function
+//   gladis_microbench -o results.csv,csv -o -,txt       # machine-readable (also xml, junitxml)
+//   ./microbench.sh                                     # build + run, results in benchmark-results/
+//
+// Inputs are generated in a temporary directory:
+//   loadConfig        base INI with the usual sections; "huge" adds 5000 keys per section
+//   loadSlot/...      welcome-data directory and bundle with facility_data.json and
+//                     user_data.json scaled to 1k/10k/100k entries
+//   watcherLatency    file rewritten -> change signal (config, data with the settle
+//                     delay set to 0, FileIOHelper watch)
+//   fileIOWrite       100 writes per iteration: blocking, or async until every ack
+
+#include <QtTest>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include "configmanager.h"
+#include "contentbundle.h"
+#include "datamanager.h"
+#include "fileiohelper.h"
+
+class MicroBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void loadConfig_data();
+    void loadConfig();
+    void parsePlatformList_data();
+    void parsePlatformList();
+    void parseHexColor_data();
+    void parseHexColor();
+
+    void loadSlot_data();
+    void loadSlot();
+    void loadAllData_data();
+    void loadAllData();
+
+    void watcherLatency_data();
+    void watcherLatency();
+    void fileIOWrite_data();
+    void fileIOWrite();
+
+private:
+    static const int WritesPerIteration = 100;
+
+    QString dataPath(int entries, bool bundle) const;
+    static void writeFile(const QString &path, const QByteArray &content);
+    static void rewriteFile(const QString &path, const QByteArray &content);
+    static void writeConfig(const QString &path, int fillerKeys);
+    static void writeDataDirectory(const QString &dir, int entries);
+    static void writeBundle(const QString &dir, const QString &bundlePath);
+
+    QTemporaryDir m_dir;
+};
+
+void MicroBench::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    // Per-change debug lines would be timed along with the work
+    QLoggingCategory::setFilterRules("*.debug=false\ngladis.*.info=false");
+
+    writeConfig(m_dir.filePath("small.ini"), 0);
+    writeConfig(m_dir.filePath("huge.ini"), 5000);
+
+    for (int entries : { 1000, 10000, 100000 }) {
+        writeDataDirectory(dataPath(entries, false), entries);
+        writeBundle(dataPath(entries, false), dataPath(entries, true));
+    }
+}
+
+QString MicroBench::dataPath(int entries, bool bundle) const
+{
+    return m_dir.filePath(QString("data-%1%2").arg(entries).arg(bundle ? ".bundle" : ""));
+}
+
+void MicroBench::writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate), qPrintable(path));
+    file.write(content);
+}
+
+// In place, same length, one write(): exactly one modify event per change
+void MicroBench::rewriteFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::ReadWrite), qPrintable(path));
+    file.write(content);
+}
+
+void MicroBench::writeConfig(const QString &path, int fillerKeys)
+{
+    QByteArray ini;
+    ini += "[app_live]\nlive_config = \"\"\nlayer_0 = app_hello\nlayer_1 = app_timer\nlayer_2 =\n"
+           "render_window = 720x1280\nrender_rotate = 0\nmetrics_port = 0\n";
+    ini += "[app_theme]\ncolor_main = {0x00AEEF}\ncolor_bg01 = {0x002657}\n"
+           "color_bg02 = {0x00529b}\ncolor_text = {0xfb6502}\n";
+    ini += "[app_hello]\n";
+    for (int i = 0; i < 10; i++) {
+        ini += QString("hello_list-img%1 = \"platform%1.png\"\nhello_list-cat%1 = \"Platform %1\"\n"
+                       "hello_list-tot%1 = %2\n").arg(i).arg(i * 3).toUtf8();
+    }
+    ini += "[app_timer]\ntimer_state = 0\n[app_image]\n[app_alert]\n[app_blank]\n[app_video]\n";
+
+    // Filler keys: the size of a config that grew per-site settings over the years
+    if (fillerKeys > 0) {
+        for (const char *section : { "app_live", "app_theme", "app_hello", "app_timer",
+                                     "app_image", "app_alert", "app_blank", "app_video" }) {
+            ini += QString("[%1]\n").arg(section).toUtf8();
+            for (int i = 0; i < fillerKeys; i++) {
+                ini += QString("site_key_%1 = \"value %1\"\n").arg(i).toUtf8();
+            }
+        }
+    }
+    writeFile(path, ini);
+}
+
+void MicroBench::writeDataDirectory(const QString &dir, int entries)
+{
+    static const char *games[] = { "Fortnite", "Rocket League", "Minecraft", "Valorant" };
+    static const char *platforms[] = { "xbox", "ps5", "switch", "pc", "arcade" };
+
+    QVERIFY(QDir().mkpath(dir));
+
+    QByteArray facility = "{\"name\": \"Game Lab\"";
+    for (int i = 0; i < entries; i++) {
+        facility += QString(",\n\"station_%1\": {\"game\": \"%2\", \"platform\": \"%3\", \"minutes\": %4}")
+                        .arg(i).arg(games[i % 4]).arg(platforms[i % 5]).arg(i % 180).toUtf8();
+    }
+    facility += "}\n";
+    writeFile(dir + "/facility_data.json", facility);
+
+    QByteArray user = QString("{\"total\": %1, \"playing\": %2, \"xbox\": 6, \"ps5\": 1, \"switch\": 2, "
+                              "\"pc\": 0, \"arcade\": 0,\n\"players\": [").arg(entries).arg(entries / 2).toUtf8();
+    for (int i = 0; i < entries; i++) {
+        user += QString("%1\n{\"name\": \"Player %2\", \"game\": \"%3\", \"platform\": \"%4\", "
+                        "\"station\": %5, \"minutes\": %6}")
+                    .arg(i ? "," : "").arg(i).arg(games[i % 4]).arg(platforms[i % 5]).arg(i % 64).arg(i % 180).toUtf8();
+    }
+    user += "],\n\"leaderboard\": [";
+    for (int i = 0; i < entries; i++) {
+        user += QString("%1\n{\"name\": \"Player %2\", \"game\": \"%3\", \"platform\": \"%4\", \"score\": %5}")
+                    .arg(i ? "," : "").arg(i).arg(games[i % 4]).arg(platforms[i % 5]).arg(qint64(entries - i) * 100).toUtf8();
+    }
+    user += "]}\n";
+    writeFile(dir + "/user_data.json", user);
+
+    writeFile(dir + "/facility_colors", "{\"primary\": \"#00AEEF\", \"secondary\": \"#002657\"}\n");
+    writeFile(dir + "/facility_name.txt", "Game Lab\n");
+    for (const char *name : { "scroll_upper.txt", "scroll_lower.txt", "text_daily", "text_count", "text_round" }) {
+        writeFile(dir + "/" + name, "SYNTHETIC TEXT\n");
+    }
+
+    // Image slots only check for the file, the bytes are never decoded here
+    for (const char *name : { "qr_support.png", "facility_logo.png", "banner_image.png", "left_image.png",
+                              "right_image.png", "game1_image.jpg", "game2_image.jpg", "game3_image.jpg",
+                              "game4_image.jpg" }) {
+        writeFile(dir + "/" + name, "not an image");
+    }
+}
+
+void MicroBench::writeBundle(const QString &dir, const QString &bundlePath)
+{
+    QList<ContentBundle::Item> items;
+    const QStringList names = QDir(dir).entryList(QDir::Files);
+    for (const QString &name : names) {
+        QFile file(dir + "/" + name);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        items.append(ContentBundle::itemFromFile(name, file.readAll()));
+    }
+    QString error;
+    QVERIFY2(ContentBundle::write(bundlePath, items, &error), qPrintable(error));
+}
+
+void MicroBench::loadConfig_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::newRow("small") << "small.ini";
+    QTest::newRow("huge") << "huge.ini";
+}
+
+void MicroBench::loadConfig()
+{
+    QFETCH(QString, file);
+    ConfigManager config;
+    config.setConfigPath(m_dir.filePath(file));
+    QCOMPARE(int(config.m_platformList.size()), 10);
+
+    QBENCHMARK {
+        config.loadConfig();
+    }
+}
+
+void MicroBench::parsePlatformList_data()
+{
+    loadConfig_data();
+}
+
+void MicroBench::parsePlatformList()
+{
+    QFETCH(QString, file);
+    ConfigManager config;
+    config.setConfigPath(m_dir.filePath(file));
+
+    QBENCHMARK {
+        config.parsePlatformList();
+    }
+    QCOMPARE(int(config.m_platformList.size()), 10);
+}
+
+void MicroBench::parseHexColor_data()
+{
+    QTest::addColumn<QString>("value");
+    QTest::addColumn<QString>("expected");
+    QTest::newRow("braces") << "{0x00AEEF}" << "#00AEEF";
+    QTest::newRow("0x") << "0xfb6502" << "#fb6502";
+    QTest::newRow("hash") << "#002657" << "#002657";
+    QTest::newRow("invalid") << "not a color" << "#000000";
+}
+
+void MicroBench::parseHexColor()
+{
+    QFETCH(QString, value);
+    QFETCH(QString, expected);
+    ConfigManager config;
+    QString result;
+
+    QBENCHMARK {
+        result = config.parseHexColor(value);
+    }
+    QCOMPARE(result, expected);
+}
+
+void MicroBench::loadSlot_data()
+{
+    QTest::addColumn<QString>("slot");
+    QTest::addColumn<int>("entries");
+    QTest::addColumn<bool>("bundle");
+
+    // Row names: <slot kind>/<slot>/<entries>, directory (loadSlot) or bundle (loadBundleSlot)
+    for (bool bundle : { false, true }) {
+        const char *mode = bundle ? "bundle" : "dir";
+        for (int entries : { 1000, 10000, 100000 }) {
+            QTest::addRow("%s/json/facilityData/%d", mode, entries) << "facilityData" << entries << bundle;
+            QTest::addRow("%s/feed/userData/%d", mode, entries) << "userData" << entries << bundle;
+        }
+        QTest::addRow("%s/json/facilityColors", mode) << "facilityColors" << 1000 << bundle;
+        QTest::addRow("%s/text/facilityName", mode) << "facilityName" << 1000 << bundle;
+        QTest::addRow("%s/image/facilityLogo", mode) << "facilityLogo" << 1000 << bundle;
+        QTest::addRow("%s/exists/qrCodeAvailable", mode) << "qrCodeAvailable" << 1000 << bundle;
+    }
+}
+
+void MicroBench::loadSlot()
+{
+    QFETCH(QString, slot);
+    QFETCH(int, entries);
+    QFETCH(bool, bundle);
+
+    // Loads every app_hello slot once; the timed loop re-reads the unchanged file
+    DataManager data;
+    data.setDataPath(dataPath(entries, bundle));
+    data.setActiveApps({ "app_hello" });
+    QVERIFY(data.m_slotIndex.contains(slot));
+    DataManager::DataSlot &dataSlot = data.m_slots[data.m_slotIndex.value(slot)];
+    QVERIFY(dataSlot.value != dataSlot.defaultValue);
+
+    QBENCHMARK {
+        data.loadSlot(dataSlot);
+    }
+}
+
+void MicroBench::loadAllData_data()
+{
+    QTest::addColumn<int>("entries");
+    QTest::addColumn<bool>("bundle");
+    for (bool bundle : { false, true }) {
+        for (int entries : { 1000, 10000, 100000 }) {
+            QTest::addRow("%s/%d", bundle ? "bundle" : "dir", entries) << entries << bundle;
+        }
+    }
+}
+
+void MicroBench::loadAllData()
+{
+    QFETCH(int, entries);
+    QFETCH(bool, bundle);
+    DataManager data;
+    data.setDataPath(dataPath(entries, bundle));
+    data.setActiveApps({ "app_hello" });
+
+    QBENCHMARK {
+        data.loadAllData();
+    }
+    QCOMPARE(data.players()->count(), entries);
+}
+
+void MicroBench::watcherLatency_data()
+{
+    QTest::addColumn<QString>("source");
+    QTest::newRow("config") << "config";
+    QTest::newRow("data") << "data";
+    QTest::newRow("fileio") << "fileio";
+}
+
+void MicroBench::watcherLatency()
+{
+    QFETCH(QString, source);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    int toggle = 0;
+
+    if (source == "config") {
+        // Overlay rewritten -> configChanged
+        const QString base = dir.filePath("gladis.ini");
+        const QString overlay = dir.filePath("overlay.ini");
+        writeConfig(base, 0);
+        writeFile(overlay, "[app_timer]\ntimer_state = 0\n");
+        ConfigManager config;
+        config.addOverlayPath(overlay);
+        config.setConfigPath(base);
+        QSignalSpy spy(&config, &ConfigManager::configChanged);
+
+        QBENCHMARK {
+            toggle ^= 1;
+            rewriteFile(overlay, QString("[app_timer]\ntimer_state = %1\n").arg(toggle).toUtf8());
+            QVERIFY(spy.wait(5000));
+        }
+    } else if (source == "data") {
+        // Slot file rewritten -> slotChanged; the settle delay (500 ms in production)
+        // is set to 0, so this is watcher + stability check + reload
+        const QString path = dir.filePath("text_daily");
+        writeFile(path, "A");
+        DataManager data;
+        data.setDataPath(dir.path());
+        data.setActiveApps({ "app_hello" });
+        data.m_delayTimer->setInterval(0);
+        bool changed = false;
+        connect(&data, &DataManager::slotChanged, this, [&changed](const QString &name) {
+            changed = changed || name == "textDaily";
+        });
+
+        QBENCHMARK {
+            toggle ^= 1;
+            changed = false;
+            rewriteFile(path, toggle ? "B" : "A");
+            QVERIFY(QTest::qWaitFor([&changed]() { return changed; }, 5000));
+        }
+    } else {
+        // Watched file rewritten -> FileIOHelper::fileChanged
+        const QString path = dir.filePath("button");
+        writeFile(path, "0");
+        FileIOHelper fileIO;
+        fileIO.watchFile(path);
+        QSignalSpy spy(&fileIO, &FileIOHelper::fileChanged);
+
+        QBENCHMARK {
+            toggle ^= 1;
+            rewriteFile(path, toggle ? "1" : "0");
+            QVERIFY(spy.wait(5000));
+        }
+    }
+}
+
+void MicroBench::fileIOWrite_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::newRow("sync/x100") << false;
+    QTest::newRow("async-ack/x100") << true;
+}
+
+void MicroBench::fileIOWrite()
+{
+    QFETCH(bool, async);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    FileIOHelper fileIO;
+    QStringList paths;
+    for (int i = 0; i < WritesPerIteration; i++) {
+        paths.append(dir.filePath(QString("button_%1").arg(i)));
+    }
+
+    int acked = 0;
+    connect(&fileIO, &FileIOHelper::writeFinished, this, [&acked](const QString &, bool success) {
+        acked += success ? 1 : 0;
+    });
+
+    QBENCHMARK {
+        if (async) {
+            acked = 0;
+            for (const QString &path : paths) {
+                fileIO.writeFileAsync(path, "1");
+            }
+            QVERIFY(QTest::qWaitFor([&acked]() { return acked == WritesPerIteration; }, 10000));
+        } else {
+            for (const QString &path : paths) {
+                QVERIFY(fileIO.writeFile(path, "1"));
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(MicroBench)
+
+#include "microbench.moc"
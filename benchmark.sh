@@ -0,0 +1,150 @@
+#!/bin/bash
+
+# GLADIS Rotation / Backend Benchmark
+# Renders the configured layers continuously (vsync off) once per rotation mode
+# and compares frame cost and text sharpness (Laplacian variance of a window grab).
+# With "backends", once per render_backend (vulkan, opengl, software) instead.
+#
+# Usage:
+#   ./benchmark.sh                  # render_rotate = 90, 10 s per mode
+#   ./benchmark.sh 270              # other rotation
+#   ./benchmark.sh 90 20            # 20 s per mode
+#   OUTPUT=HDMI-1 ./benchmark.sh    # xrandr output rotated for the platform run
+#   ./benchmark.sh backends         # 10 s per render backend
+#   ./benchmark.sh backends 20
+#   BACKENDS="vulkan opengl" ./benchmark.sh backends
+#   SOFTWARE_GPU=1 ./benchmark.sh backends   # Mesa llvmpipe (GL) and lavapipe (Vulkan)
+#
+# Results: benchmark-results/rotation.csv or backends.csv plus one PNG grab per run.
+# The platform run needs an output rotated by the display stack; on X11 this
+# script rotates $OUTPUT with xrandr, elsewhere rotate it with the compositor/KMS
+# first (otherwise that run only shows the unrotated content).
+# Backend runs on a plain Linux box (no GPU, no display) use Mesa's CPU drivers
+# under xvfb-run: install xvfb and mesa-vulkan-drivers (lavapipe).
+
+set -e
+
+if [[ "$1" == "backends" ]]; then
+    SECONDS_PER_BACKEND=${2:-10}
+    RESULTS_DIR="benchmark-results"
+    CSV="$RESULTS_DIR/backends.csv"
+
+    if [[ ! -x "./GLADIS" ]]; then
+        echo "ERROR: ./GLADIS not found - build first (./run.sh builds and copies it)"
+        exit 1
+    fi
+
+    mkdir -p "$RESULTS_DIR"
+    rm -f "$CSV" "$RESULTS_DIR"/backends-*.png
+
+    OVERLAY=$(mktemp --suffix=.ini)
+    trap 'rm -f "$OVERLAY"' EXIT
+    cat > "$OVERLAY" <<EOF
+[app_live]
+render_rotate = 0
+render_stats = 0
+state_snapshot = ""
+frame_snapshot = ""
+EOF
+
+    # The backend comes from --render-backend, not from the environment
+    unset QT_QUICK_BACKEND QSG_RHI_BACKEND
+
+    # No display: a virtual X server, and Mesa's CPU drivers unless told otherwise
+    RUNNER=()
+    if [[ -z "$DISPLAY" && -z "$WAYLAND_DISPLAY" ]]; then
+        if ! command -v xvfb-run > /dev/null; then
+            echo "ERROR: no display and no xvfb-run (install xvfb)"
+            exit 1
+        fi
+        RUNNER=(xvfb-run -a -s "-screen 0 1920x1080x24")
+        export QT_QPA_PLATFORM=xcb
+        SOFTWARE_GPU=${SOFTWARE_GPU:-1}
+    fi
+
+    if [[ "${SOFTWARE_GPU:-0}" == "1" ]]; then
+        export LIBGL_ALWAYS_SOFTWARE=1
+        LAVAPIPE=$(ls /usr/share/vulkan/icd.d/lvp_icd*.json 2>/dev/null | head -1)
+        if [[ -n "$LAVAPIPE" ]]; then
+            # Older loaders read VK_ICD_FILENAMES, newer ones VK_DRIVER_FILES
+            export VK_DRIVER_FILES="$LAVAPIPE" VK_ICD_FILENAMES="$LAVAPIPE"
+        else
+            echo "warning: lavapipe not found (mesa-vulkan-drivers), vulkan runs use the default driver"
+        fi
+    fi
+
+    for BACKEND in ${BACKENDS:-vulkan opengl software}; do
+        echo ""
+        echo "=== Benchmark: render_backend = $BACKEND ==="
+
+        LOG=$("${RUNNER[@]}" ./GLADIS --benchmark "$SECONDS_PER_BACKEND" --benchmark-output "$CSV" \
+                  --render-backend "$BACKEND" --config-overlay "$OVERLAY" 2>&1 || true)
+        echo "$LOG" | grep -E "BENCHMARK|render_backend|Render backend:" || true
+        if ! echo "$LOG" | grep -q "BENCHMARK"; then
+            echo "warning: no result for $BACKEND (last lines of the log below)"
+            echo "$LOG" | tail -5
+        fi
+    done
+
+    echo ""
+    echo "=== Results ($CSV) ==="
+    column -s, -t < "$CSV" 2>/dev/null || cat "$CSV"
+    echo ""
+    echo "mean_ms = frame cost at uncapped frame rate; compare rows on the same device only"
+    exit 0
+fi
+
+ROTATE=${1:-90}
+SECONDS_PER_MODE=${2:-10}
+OUTPUT=${OUTPUT:-Virtual1}
+RESULTS_DIR="benchmark-results"
+CSV="$RESULTS_DIR/rotation.csv"
+
+if [[ ! -x "./GLADIS" ]]; then
+    echo "ERROR: ./GLADIS not found - build first (./run.sh builds and copies it)"
+    exit 1
+fi
+
+mkdir -p "$RESULTS_DIR"
+rm -f "$CSV" "$RESULTS_DIR"/rotation-*.png
+
+# Force the rotation for these runs without touching gladis.ini
+OVERLAY=$(mktemp --suffix=.ini)
+trap 'rm -f "$OVERLAY"' EXIT
+cat > "$OVERLAY" <<EOF
+[app_live]
+render_rotate = $ROTATE
+render_stats = 0
+EOF
+
+xrandr_rotation() {
+    case "$ROTATE" in
+        90)  echo "left" ;;
+        180) echo "inverted" ;;
+        270) echo "right" ;;
+        *)   echo "normal" ;;
+    esac
+}
+
+for MODE in transform offscreen platform; do
+    echo ""
+    echo "=== Benchmark: render_rotate = $ROTATE, mode = $MODE ==="
+
+    if [[ "$MODE" == "platform" ]]; then
+        xrandr --output "$OUTPUT" --rotate "$(xrandr_rotation)" 2>/dev/null || \
+            echo "warning: could not rotate output $OUTPUT; assuming the display stack already does"
+    fi
+
+    ./GLADIS --benchmark "$SECONDS_PER_MODE" --benchmark-output "$CSV" \
+             --rotate-mode "$MODE" --config-overlay "$OVERLAY" 2>&1 | grep "BENCHMARK" || true
+
+    if [[ "$MODE" == "platform" ]]; then
+        xrandr --output "$OUTPUT" --rotate normal 2>/dev/null || true
+    fi
+done
+
+echo ""
+echo "=== Results ($CSV) ==="
+column -s, -t < "$CSV" 2>/dev/null || cat "$CSV"
+echo ""
+echo "mean_ms = frame cost at uncapped frame rate, sharpness: higher = crisper text"
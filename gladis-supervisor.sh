@@ -0,0 +1,131 @@
+#!/bin/bash
+
+# GLADIS Supervisor
+# Runs GLADIS with a warm standby: a second process started with --standby has
+# Qt, the QML and the data loaded but its window hidden. When the active process
+# exits (crash, kill), the standby gets SIGUSR1, restores the runtime state
+# snapshot ([app_live] state_snapshot) and shows its window; a new standby is
+# started behind it. A process stopped with SIGTERM saves the snapshot first.
+#
+# Usage:
+#   ./gladis-supervisor.sh                    # Supervise ./GLADIS
+#   ./gladis-supervisor.sh --config-overlay x # Arguments are passed to every process
+#   ./gladis-supervisor.sh --journal run.jsonl
+#                                             # Recording options only go to a process
+#                                             # started active, never to a standby
+#   APP=/opt/gladis/GLADIS ./gladis-supervisor.sh
+#
+# Deploy a new binary: kill -HUP <supervisor pid>. The standby (still the old
+# binary) is replaced first, then the active process is stopped and the new
+# standby takes over.
+#
+# Needs a windowing system that lets two processes hold a window (X11/Wayland);
+# under eglfs the standby would compete for the display.
+
+APP=${APP:-./GLADIS}
+# Time a new standby gets to load before it may be asked to take over
+WARMUP_SECONDS=${WARMUP_SECONDS:-3}
+# Pause before respawning a standby that died on its own
+RESPAWN_DELAY=${RESPAWN_DELAY:-2}
+
+if [[ ! -x "$APP" ]]; then
+    echo "ERROR: $APP not found - build first (./run.sh builds and copies it)"
+    exit 1
+fi
+
+# Options that record what the process does: two processes writing one journal
+# would corrupt it, and a standby has nothing to record yet
+COMMON_ARGS=()
+ACTIVE_ARGS=()
+while (( $# > 0 )); do
+    case "$1" in
+        --journal)
+            ACTIVE_ARGS+=("$1" "$2")
+            shift 2
+            ;;
+        --journal=*)
+            ACTIVE_ARGS+=("$1")
+            shift
+            ;;
+        *)
+            COMMON_ARGS+=("$1")
+            shift
+            ;;
+    esac
+done
+
+ACTIVE=""
+STANDBY=""
+STANDBY_STARTED=0
+
+start_active() {
+    "$APP" "${COMMON_ARGS[@]}" "${ACTIVE_ARGS[@]}" &
+    ACTIVE=$!
+    echo "supervisor: active pid $ACTIVE"
+}
+
+start_standby() {
+    "$APP" --standby "${COMMON_ARGS[@]}" &
+    STANDBY=$!
+    STANDBY_STARTED=$(date +%s)
+    echo "supervisor: standby pid $STANDBY"
+}
+
+alive() {
+    [[ -n "$1" ]] && kill -0 "$1" 2>/dev/null
+}
+
+wait_for_warmup() {
+    local remaining=$(( STANDBY_STARTED + WARMUP_SECONDS - $(date +%s) ))
+    if (( remaining > 0 )); then
+        sleep "$remaining"
+    fi
+}
+
+promote_standby() {
+    if alive "$STANDBY"; then
+        wait_for_warmup
+        kill -USR1 "$STANDBY"
+        ACTIVE=$STANDBY
+        STANDBY=""
+        echo "supervisor: standby $ACTIVE took over"
+    else
+        start_active
+    fi
+    start_standby
+}
+
+shutdown() {
+    kill "$ACTIVE" "$STANDBY" 2>/dev/null
+    wait
+    exit 0
+}
+
+redeploy() {
+    echo "supervisor: redeploy - replacing standby, then handing over"
+    kill "$STANDBY" 2>/dev/null
+    wait "$STANDBY" 2>/dev/null
+    start_standby
+    wait_for_warmup
+    kill "$ACTIVE" 2>/dev/null
+}
+
+trap shutdown INT TERM
+trap redeploy HUP
+
+start_active
+start_standby
+
+while true; do
+    # Returns on any child exit (or on a trapped signal)
+    wait -n
+
+    if ! alive "$ACTIVE"; then
+        echo "supervisor: active process $ACTIVE exited"
+        promote_standby
+    elif ! alive "$STANDBY"; then
+        echo "supervisor: standby $STANDBY exited, respawning"
+        sleep "$RESPAWN_DELAY"
+        start_standby
+    fi
+done
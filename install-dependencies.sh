@@ -42,7 +42,9 @@ echo ""
 echo "Installing Qt6 multimedia and additional modules..."
 sudo apt install -y \
     qt6-multimedia-dev \
+    qml6-module-qtmultimedia \
     qt6-5compat-dev \
+    qt6-shadertools-dev \
     qml6-module-qt5compat-graphicaleffects \
     libqt6core6 \
     libqt6gui6 \
@@ -56,6 +58,12 @@ sudo apt install -y \
     build-essential \
     pkg-config
 
+echo ""
+echo "Installing Vulkan driver and loader (render_backend = vulkan)..."
+sudo apt install -y \
+    mesa-vulkan-drivers \
+    libvulkan1
+
 echo ""
 echo "Installing optional but useful Qt6 tools..."
 sudo apt install -y \
@@ -73,6 +81,7 @@ echo "  - Qt6 Declarative (QML)"
 echo "  - Qt6 Quick Controls & Templates"
 echo "  - Qt6 Multimedia"
 echo "  - Qt6 Core5Compat"
+echo "  - Mesa Vulkan driver"
 echo "  - Build tools (CMake, GCC)"
 echo ""
 echo "You can now build and run the GLADIS application."
@@ -4,12 +4,15 @@ import "Components"
 
 Window {
     id: mainWindow
-    visible: true
+    // Warm standby (--standby): everything loaded, window hidden until the supervisor hands over
+    property bool standby: false
+    visible: !standby
     // Visibility controlled by render_screen setting in INI
-    visibility: configManager.renderScreen === 1 ? Window.FullScreen : Window.Windowed
-    // Resolution from config - swap width/height for 90/270 degree rotations
-    width: (configManager.renderRotate === 90 || configManager.renderRotate === 270) ? configManager.renderHeight : configManager.renderWidth
-    height: (configManager.renderRotate === 90 || configManager.renderRotate === 270) ? configManager.renderWidth : configManager.renderHeight
+    visibility: standby ? Window.Hidden : configManager.renderScreen === 1 ? Window.FullScreen : Window.Windowed
+    // Resolution from config - swap width/height when the content is rotated by 90/270
+    // degrees here (not when the display stack already rotates the output)
+    width: displayRotation.swapsAxes ? configManager.renderHeight : configManager.renderWidth
+    height: displayRotation.swapsAxes ? configManager.renderWidth : configManager.renderHeight
     title: "GameLab Esports Dashboard"
     color: "#333333"
 
@@ -22,7 +25,7 @@ Window {
         }
 
         console.log("Window initialized - Mode:", configManager.renderScreen === 1 ? "FullScreen" : "Windowed",
-                    "Dimensions:", width, "x", height, "Rotation:", configManager.renderRotate)
+                    "Dimensions:", width, "x", height, "Rotation:", configManager.renderRotate, displayRotation.mode)
     }
 
     // Detect orientation
@@ -45,16 +48,6 @@ Window {
         // This ensures all components adjust to the new dimensions
     }
 
-    // Helper function to check if an app should be visible based on its state
-    function isAppStateActive(appName) {
-        if (appName === "app_timer") return configManager.timerState
-        if (appName === "app_alert") return configManager.alertState
-        if (appName === "app_blank") return configManager.blankState
-        if (appName === "app_hello") return configManager.helloState
-        // app_image has no state flag, always show if layer is set
-        return true
-    }
-
     // TOGGLE THIS: Set to true to use pixmap scrolling (last resort), false for fade in/out carousel
     property bool usePixmapScrolling: true
 
@@ -101,22 +94,30 @@ Window {
     // Rotatable content container
     Item {
         id: contentContainer
+        objectName: "contentContainer"
         anchors.centerIn: parent
         width: configManager.renderWidth
         height: configManager.renderHeight
-        rotation: configManager.renderRotate
+        rotation: displayRotation.contentRotation
+        // In a standby the countdown and video stay paused (both follow visibility)
+        visible: !mainWindow.standby
+
+        // Offscreen rotation: the content renders unrotated (pixel aligned text) into the
+        // layer texture, which is drawn once per frame with the rotation applied.
+        // Quality governor tiers 2-3: render into a smaller texture, upscaled to render_window
+        layer.enabled: displayRotation.offscreen || qualityGovernor.renderScale < 1.0
+        layer.textureSize: Qt.size(Math.round(width * qualityGovernor.renderScale),
+                                   Math.round(height * qualityGovernor.renderScale))
+        // 1:1 blits of a 90 degree multiple map texels to pixels exactly, no filtering needed
+        layer.smooth: qualityGovernor.renderScale < 1.0
 
         // Property to check if any layer is active
-        property bool hasActiveLayer: (configManager.layer0 !== "" && isAppStateActive(configManager.layer0)) ||
-                                      (configManager.layer1 !== "" && isAppStateActive(configManager.layer1)) ||
-                                      (configManager.layer2 !== "" && isAppStateActive(configManager.layer2)) ||
-                                      (configManager.layer3 !== "" && isAppStateActive(configManager.layer3)) ||
-                                      (configManager.layer4 !== "" && isAppStateActive(configManager.layer4)) ||
-                                      (configManager.layer5 !== "" && isAppStateActive(configManager.layer5)) ||
-                                      (configManager.layer6 !== "" && isAppStateActive(configManager.layer6)) ||
-                                      (configManager.layer7 !== "" && isAppStateActive(configManager.layer7)) ||
-                                      (configManager.layer8 !== "" && isAppStateActive(configManager.layer8)) ||
-                                      (configManager.layer9 !== "" && isAppStateActive(configManager.layer9))
+        property bool hasActiveLayer: layerStack.hasActiveLayer
+
+        // Glyphs rasterized up front, under the background (see GlyphPrewarm.qml)
+        GlyphPrewarm {
+            z: -1
+        }
 
         // Background with gradient using facility colors
         // Only show if at least one layer is active
@@ -130,599 +131,11 @@ Window {
         }
 
     // ===== DYNAMIC LAYER SYSTEM =====
-    // Layer 0 is front-most (highest z-index)
-    // Layers stack on top of each other like z-index in CSS
-    // Empty layers show nothing
-
-    // Layer 9 (bottom-most layer, z: 10)
-    Loader {
-        id: layer9Loader
-        anchors.fill: parent
-        z: 10
-        active: configManager.layer9 !== "" && isAppStateActive(configManager.layer9)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition9
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer9
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 9 loaded:", configManager.layer9)
-            // Pass properties to the loaded component if needed
-            if (item && configManager.layer9 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer9 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer9 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 8 (z: 20)
-    Loader {
-        id: layer8Loader
-        anchors.fill: parent
-        z: 20
-        active: configManager.layer8 !== "" && isAppStateActive(configManager.layer8)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition8
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer8
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 8 loaded:", configManager.layer8)
-            if (item && configManager.layer8 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer8 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer8 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 7 (z: 30)
-    Loader {
-        id: layer7Loader
-        anchors.fill: parent
-        z: 30
-        active: configManager.layer7 !== "" && isAppStateActive(configManager.layer7)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition7
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer7
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 7 loaded:", configManager.layer7)
-            if (item && configManager.layer7 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer7 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer7 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 6 (z: 40)
-    Loader {
-        id: layer6Loader
+    // [app_live] layer_0 .. layer_9, layer_0 is front-most (see LayerStack.qml)
+    LayerStack {
+        id: layerStack
         anchors.fill: parent
-        z: 40
-        active: configManager.layer6 !== "" && isAppStateActive(configManager.layer6)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition6
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer6
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 6 loaded:", configManager.layer6)
-            if (item && configManager.layer6 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer6 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer6 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 5 (z: 50)
-    Loader {
-        id: layer5Loader
-        anchors.fill: parent
-        z: 50
-        active: configManager.layer5 !== "" && isAppStateActive(configManager.layer5)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition5
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer5
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 5 loaded:", configManager.layer5)
-            if (item && configManager.layer5 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer5 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer5 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 4 (z: 60)
-    Loader {
-        id: layer4Loader
-        anchors.fill: parent
-        z: 60
-        active: configManager.layer4 !== "" && isAppStateActive(configManager.layer4)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition4
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer4
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 4 loaded:", configManager.layer4)
-            if (item && configManager.layer4 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer4 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer4 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 3 (z: 70)
-    Loader {
-        id: layer3Loader
-        anchors.fill: parent
-        z: 70
-        active: configManager.layer3 !== "" && isAppStateActive(configManager.layer3)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition3
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer3
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 3 loaded:", configManager.layer3)
-            if (item && configManager.layer3 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer3 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer3 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 2 (z: 80)
-    Loader {
-        id: layer2Loader
-        anchors.fill: parent
-        z: 80
-        active: configManager.layer2 !== "" && isAppStateActive(configManager.layer2)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition2
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer2
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 2 loaded:", configManager.layer2)
-            if (item && configManager.layer2 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer2 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer2 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 1 (z: 90)
-    Loader {
-        id: layer1Loader
-        anchors.fill: parent
-        z: 90
-        active: configManager.layer1 !== "" && isAppStateActive(configManager.layer1)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition1
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer1
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 1 loaded:", configManager.layer1)
-            if (item && configManager.layer1 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer1 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer1 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
-    }
-
-    // Layer 0 (front-most layer, z: 100)
-    Loader {
-        id: layer0Loader
-        anchors.fill: parent
-        z: 100
-        active: configManager.layer0 !== "" && isAppStateActive(configManager.layer0)
-        opacity: active ? 1.0 : 0.0
-        visible: opacity > 0.01
-
-        Behavior on opacity {
-            NumberAnimation {
-                duration: configManager.layerTransition0
-                easing.type: Easing.InOutQuad
-            }
-        }
-
-        source: {
-            var appName = configManager.layer0
-            if (appName === "app_hello") return "qrc:/Components/WelcomeApp.qml"
-            if (appName === "app_timer") return "qrc:/Components/TimerApp.qml"
-            if (appName === "app_image") return "qrc:/Components/ImageApp.qml"
-            if (appName === "app_alert") return "qrc:/Components/AlertApp.qml"
-            if (appName === "app_blank") return "qrc:/Components/BlankApp.qml"
-            return ""
-        }
-
-        onLoaded: {
-            console.log("Layer 0 loaded:", configManager.layer0)
-            if (item && configManager.layer0 === "app_timer") {
-                item.timerState = Qt.binding(function() { return configManager.timerState })
-                item.timerCount = Qt.binding(function() { return configManager.timerCount })
-                item.timerMax = Qt.binding(function() { return configManager.timerMax })
-                item.timerText = Qt.binding(function() { return configManager.timerText })
-                item.timerMenuLeft = Qt.binding(function() { return configManager.timerMenuLeft })
-                item.timerMenuMiddle = Qt.binding(function() { return configManager.timerMenuMiddle })
-                item.timerMenuRight = Qt.binding(function() { return configManager.timerMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer0 === "app_alert") {
-                item.alertState = Qt.binding(function() { return configManager.alertState })
-                item.alertText = Qt.binding(function() { return configManager.alertText })
-                item.alertMenuLeft = Qt.binding(function() { return configManager.alertMenuLeft })
-                item.alertMenuMiddle = Qt.binding(function() { return configManager.alertMenuMiddle })
-                item.alertMenuRight = Qt.binding(function() { return configManager.alertMenuRight })
-                item.colorMain = Qt.binding(function() { return configManager.colorMain })
-                item.colorBg01 = Qt.binding(function() { return configManager.colorBg01 })
-                item.colorBg02 = Qt.binding(function() { return configManager.colorBg02 })
-                item.colorText = Qt.binding(function() { return configManager.colorText })
-            }
-            if (item && configManager.layer0 === "app_blank") {
-                item.blankState = Qt.binding(function() { return configManager.blankState })
-                item.blankFade = Qt.binding(function() { return configManager.blankFade })
-            }
-        }
+        screenConfig: configManager.primaryScreen
     }
 
     // Custom Cursor (tracking layer behind interactive elements)
@@ -794,5 +207,14 @@ Window {
         }
     }
 
+    // Render statistics overlay (render_stats in [app_live])
+    Loader {
+        active: renderStats.enabled
+        x: 8
+        y: 8
+        z: 20000  // Above the layers and the cursor
+        sourceComponent: RenderStatsOverlay {}
+    }
+
     } // End of contentContainer
 }
@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# GLADIS Micro-benchmarks
+# Builds the benchmark targets (GLADIS_BUILD_BENCHMARKS) and runs the QtTest
+# micro-benchmarks of ConfigManager, DataManager and FileIOHelper on synthetic
+# inputs: config parsing, every data slot loader at 1k/10k/100k entries,
+# watcher event-to-signal latency and file write/ack throughput.
+#
+# Usage:
+#   ./microbench.sh                 # everything
+#   ./microbench.sh loadSlot        # one test function (any gladis_microbench arguments)
+#   BUILD_DIR=build-bench ./microbench.sh
+#
+# Results: benchmark-results/microbench.csv and microbench.xml (QtTest formats),
+# plus the plain text report on stdout. Compare two CSVs to see what a change did.
+
+set -e
+
+BUILD_DIR=${BUILD_DIR:-build-bench}
+RESULTS_DIR="benchmark-results"
+
+echo "=== Building benchmarks ($BUILD_DIR) ==="
+cmake -S . -B "$BUILD_DIR" -DGLADIS_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release > /dev/null
+cmake --build "$BUILD_DIR" --target gladis_microbench -j"$(nproc)"
+
+mkdir -p "$RESULTS_DIR"
+BENCH=$(find "$BUILD_DIR" -name gladis_microbench -type f -perm -u+x | head -1)
+
+echo ""
+echo "=== Running $BENCH ==="
+"$BENCH" -o "$RESULTS_DIR/microbench.csv,csv" -o "$RESULTS_DIR/microbench.xml,xml" -o -,txt "$@"
+
+echo ""
+echo "Results: $RESULTS_DIR/microbench.csv, $RESULTS_DIR/microbench.xml"
@@ -0,0 +1,28 @@
+#version 440
+
+// PixmapScrollingText: horizontal motion blur of the text layer (5 taps)
+
+layout(location = 0) in vec2 qt_TexCoord0;
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float blurRadius;
+    vec2 sourceSize;
+};
+
+layout(binding = 1) uniform sampler2D source;
+
+void main()
+{
+    float radius = blurRadius / sourceSize.x;
+
+    vec4 sum = texture(source, qt_TexCoord0 + vec2(-2.0 * radius, 0.0)) * 0.05;
+    sum += texture(source, qt_TexCoord0 + vec2(-1.0 * radius, 0.0)) * 0.25;
+    sum += texture(source, qt_TexCoord0) * 0.40;
+    sum += texture(source, qt_TexCoord0 + vec2(1.0 * radius, 0.0)) * 0.25;
+    sum += texture(source, qt_TexCoord0 + vec2(2.0 * radius, 0.0)) * 0.05;
+
+    fragColor = sum * qt_Opacity;
+}
@@ -0,0 +1,55 @@
+#version 440
+
+// TransitionItem: blends the "from" and "to" textures in a single pass.
+// mode: 0 = fade, 1 = wipe (left to right), 2 = swap (fade out, then fade in), 3 = push (right to left)
+
+layout(location = 0) in vec2 coord;
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float progress;
+    float softness;
+    int mode;
+    vec4 fromRect;      // Image placement in item coordinates (0..1): x, y, width, height
+    vec4 toRect;
+    vec4 fromSubRect;   // Normalized sub rect of the texture (atlas)
+    vec4 toSubRect;
+};
+
+layout(binding = 1) uniform sampler2D fromTexture;
+layout(binding = 2) uniform sampler2D toTexture;
+
+vec4 fetch(sampler2D tex, vec4 placement, vec4 subRect, vec2 uv)
+{
+    // Fill mode as a placement rect: fit/pad leave transparent borders, crop overflows
+    vec2 t = (uv - placement.xy) / placement.zw;
+    if (t.x < 0.0 || t.y < 0.0 || t.x > 1.0 || t.y > 1.0) {
+        return vec4(0.0);
+    }
+    return texture(tex, subRect.xy + t * subRect.zw);
+}
+
+void main()
+{
+    vec4 color;
+    if (mode == 1) {
+        float edge = progress * (1.0 + softness);
+        float amount = 1.0 - smoothstep(edge - softness, edge, coord.x);
+        color = mix(fetch(fromTexture, fromRect, fromSubRect, coord),
+                    fetch(toTexture, toRect, toSubRect, coord), amount);
+    } else if (mode == 2) {
+        color = progress < 0.5
+            ? fetch(fromTexture, fromRect, fromSubRect, coord) * (1.0 - 2.0 * progress)
+            : fetch(toTexture, toRect, toSubRect, coord) * (2.0 * progress - 1.0);
+    } else if (mode == 3) {
+        vec2 offset = vec2(progress, 0.0);
+        color = fetch(fromTexture, fromRect, fromSubRect, coord + offset)
+              + fetch(toTexture, toRect, toSubRect, coord + offset - vec2(1.0, 0.0));
+    } else {
+        color = mix(fetch(fromTexture, fromRect, fromSubRect, coord),
+                    fetch(toTexture, toRect, toSubRect, coord), progress);
+    }
+    fragColor = color * qt_Opacity;
+}
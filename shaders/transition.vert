@@ -0,0 +1,26 @@
+#version 440
+
+// TransitionItem: one quad covering the item, texture coordinates 0..1
+
+layout(location = 0) in vec4 qt_Vertex;
+layout(location = 1) in vec2 qt_MultiTexCoord0;
+
+layout(location = 0) out vec2 coord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float progress;
+    float softness;
+    int mode;
+    vec4 fromRect;
+    vec4 toRect;
+    vec4 fromSubRect;
+    vec4 toSubRect;
+};
+
+void main()
+{
+    coord = qt_MultiTexCoord0;
+    gl_Position = qt_Matrix * qt_Vertex;
+}
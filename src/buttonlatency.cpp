@@ -0,0 +1,205 @@
+#include "buttonlatency.h"
+#include "fileiohelper.h"
+#include "metrics.h"
+#include <QQuickWindow>
+#include <QFileInfo>
+#include <QEvent>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Keep the last N round-trips per button for the summary percentiles
+const int kMaxSamples = 256;
+
+double msBetween(qint64 fromNs, qint64 toNs)
+{
+    return (fromNs >= 0 && toNs >= fromNs) ? (toNs - fromNs) / 1e6 : -1.0;
+}
+
+} // namespace
+
+ButtonLatencyTracker::ButtonLatencyTracker(FileIOHelper *fileIO, QObject *parent)
+    : QObject(parent)
+    , m_lastTouchNs(-1)
+    , m_outlierThresholdMs(1000)
+    , m_window(nullptr)
+    , m_ackPending(0)
+    , m_syncNs(-1)
+{
+    m_clock.start();
+
+    connect(fileIO, &FileIOHelper::writeFinished, this, &ButtonLatencyTracker::onWriteFinished);
+
+    Metrics::instance()->describe("gladis_button_latency_seconds", Metrics::Histogram,
+                                  "Button round-trip per stage (write, ack, visual) and total action->cleared");
+}
+
+void ButtonLatencyTracker::attachWindow(QQuickWindow *window)
+{
+    m_window = window;
+    window->installEventFilter(this);
+
+    // Both run on the render thread (GUI thread blocked during sync)
+    connect(window, &QQuickWindow::afterSynchronizing, this, [this]() {
+        if (m_ackPending.testAndSetOrdered(1, 0)) {
+            m_syncNs.storeRelease(m_clock.nsecsElapsed());
+        }
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::frameSwapped, this, [this]() {
+        qint64 syncNs = m_syncNs.fetchAndStoreOrdered(-1);
+        if (syncNs >= 0) {
+            qint64 swapNs = m_clock.nsecsElapsed();
+            QMetaObject::invokeMethod(this, [this, syncNs, swapNs]() {
+                onFramePresented(syncNs, swapNs);
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::DirectConnection);
+}
+
+void ButtonLatencyTracker::setOutlierThreshold(int milliseconds)
+{
+    m_outlierThresholdMs = milliseconds;
+}
+
+bool ButtonLatencyTracker::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::MouseButtonPress || event->type() == QEvent::TouchBegin) {
+        m_lastTouchNs = m_clock.nsecsElapsed();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void ButtonLatencyTracker::pressed(const QString &buttonFile)
+{
+    qint64 now = m_clock.nsecsElapsed();
+
+    auto previous = m_traces.constFind(buttonFile);
+    if (previous != m_traces.constEnd()) {
+        qWarning() << "Button" << QFileInfo(buttonFile).fileName()
+                   << "pressed again before the controller acknowledged the previous press ("
+                   << msBetween(previous->actionNs, now) << "ms ago)";
+    }
+
+    Trace trace;
+    // A press more than 10 s before the action is not this tap
+    trace.touchNs = (m_lastTouchNs >= 0 && now - m_lastTouchNs < 10000000000LL) ? m_lastTouchNs : -1;
+    trace.actionNs = now;
+    m_traces.insert(buttonFile, trace);
+}
+
+void ButtonLatencyTracker::onWriteFinished(const QString &filePath, bool success)
+{
+    auto it = m_traces.find(filePath);
+    if (it == m_traces.end() || it->writtenNs >= 0) {
+        return;
+    }
+
+    if (!success) {
+        qWarning() << "Button file write failed, round-trip will not complete:" << filePath;
+        m_traces.erase(it);
+        return;
+    }
+
+    it->writtenNs = m_clock.nsecsElapsed();
+}
+
+void ButtonLatencyTracker::acknowledged(const QString &buttonFile)
+{
+    auto it = m_traces.find(buttonFile);
+    if (it == m_traces.end() || it->ackNs >= 0) {
+        return;
+    }
+
+    it->ackNs = m_clock.nsecsElapsed();
+
+    // Without a window (or frames) the reset is as visible as it will get
+    if (!m_window || !m_window->isExposed()) {
+        finish(buttonFile, it.value(), it->ackNs);
+        m_traces.erase(it);
+        return;
+    }
+
+    if (!m_awaitingFrame.contains(buttonFile)) {
+        m_awaitingFrame.append(buttonFile);
+    }
+    m_ackPending.storeRelease(1);
+    m_window->update();
+}
+
+void ButtonLatencyTracker::onFramePresented(qint64 syncNs, qint64 swapNs)
+{
+    // Only acks that happened before the frame was synchronized are on screen
+    for (int i = m_awaitingFrame.size() - 1; i >= 0; i--) {
+        const QString buttonFile = m_awaitingFrame.at(i);
+        auto it = m_traces.find(buttonFile);
+        if (it == m_traces.end()) {
+            m_awaitingFrame.removeAt(i);
+        } else if (it->ackNs <= syncNs) {
+            finish(buttonFile, it.value(), swapNs);
+            m_traces.erase(it);
+            m_awaitingFrame.removeAt(i);
+        }
+    }
+
+    if (!m_awaitingFrame.isEmpty()) {
+        m_ackPending.storeRelease(1);
+        m_window->update();
+    }
+}
+
+void ButtonLatencyTracker::finish(const QString &buttonFile, const Trace &trace, qint64 clearedNs)
+{
+    QString button = QFileInfo(buttonFile).fileName();
+    double touchMs = msBetween(trace.touchNs, trace.actionNs);
+    double writeMs = msBetween(trace.actionNs, trace.writtenNs);
+    double ackMs = msBetween(trace.writtenNs >= 0 ? trace.writtenNs : trace.actionNs, trace.ackNs);
+    double visualMs = msBetween(trace.ackNs, clearedNs);
+    double totalMs = msBetween(trace.actionNs, clearedNs);
+
+    Metrics *metrics = Metrics::instance();
+    QString buttonLabel = Metrics::label("button", button);
+    if (writeMs >= 0) {
+        metrics->observeMs("gladis_button_latency_seconds", writeMs, buttonLabel + ",stage=\"write\"");
+    }
+    metrics->observeMs("gladis_button_latency_seconds", ackMs, buttonLabel + ",stage=\"ack\"");
+    metrics->observeMs("gladis_button_latency_seconds", visualMs, buttonLabel + ",stage=\"visual\"");
+    metrics->observeMs("gladis_button_latency_seconds", totalMs, buttonLabel + ",stage=\"total\"");
+
+    QVector<float> &totals = m_totalsMs[button];
+    totals.append(float(totalMs));
+    if (totals.size() > kMaxSamples) {
+        totals.remove(0, totals.size() - kMaxSamples);
+    }
+
+    if (totalMs > m_outlierThresholdMs) {
+        qWarning().noquote() << QString("Slow button round-trip %1: total %2 ms (hold %3, write %4, controller ack %5, visual %6)")
+                                    .arg(button)
+                                    .arg(totalMs, 0, 'f', 1)
+                                    .arg(touchMs, 0, 'f', 1)
+                                    .arg(writeMs, 0, 'f', 1)
+                                    .arg(ackMs, 0, 'f', 1)
+                                    .arg(visualMs, 0, 'f', 1);
+    } else {
+        qDebug() << "Button round-trip" << button << totalMs << "ms";
+    }
+}
+
+QString ButtonLatencyTracker::summaryLine() const
+{
+    QStringList parts;
+    for (auto it = m_totalsMs.constBegin(); it != m_totalsMs.constEnd(); ++it) {
+        QVector<float> sorted = it.value();
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](double p) {
+            return sorted.at(qBound(0, int(p * (sorted.size() - 1) + 0.5), int(sorted.size()) - 1));
+        };
+        parts.append(QString("%1:count=%2,p50_ms=%3,p95_ms=%4,max_ms=%5")
+                         .arg(it.key())
+                         .arg(sorted.size())
+                         .arg(percentile(0.5), 0, 'f', 1)
+                         .arg(percentile(0.95), 0, 'f', 1)
+                         .arg(sorted.last(), 0, 'f', 1));
+    }
+    return parts.join(' ');
+}
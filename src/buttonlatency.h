@@ -0,0 +1,69 @@
+#ifndef BUTTONLATENCY_H
+#define BUTTONLATENCY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QAtomicInteger>
+
+class QQuickWindow;
+class FileIOHelper;
+
+// Traces the TimerApp/AlertApp button round-trip through its stages:
+//   touch   - press event reached the window
+//   action  - release handled, button file write submitted (pressed())
+//   written - the async write finished (FileIOHelper::writeFinished)
+//   ack     - the controller deleted the file and QML noticed (acknowledged())
+//   cleared - first frame presented after the button state was reset
+// Per-button latencies go to the metrics endpoint; slow round-trips are
+// logged with their stage breakdown.
+class ButtonLatencyTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ButtonLatencyTracker(FileIOHelper *fileIO, QObject *parent = nullptr);
+
+    void attachWindow(QQuickWindow *window);
+
+    // Round-trips (action -> cleared) slower than this are logged
+    void setOutlierThreshold(int milliseconds);
+
+    Q_INVOKABLE void pressed(const QString &buttonFile);
+    Q_INVOKABLE void acknowledged(const QString &buttonFile);
+
+    // One line, key=value pairs, per button: count and action->cleared percentiles
+    QString summaryLine() const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Trace {
+        qint64 touchNs = -1;
+        qint64 actionNs = -1;
+        qint64 writtenNs = -1;
+        qint64 ackNs = -1;
+    };
+
+    void onWriteFinished(const QString &filePath, bool success);
+    void onFramePresented(qint64 syncNs, qint64 swapNs);
+    void finish(const QString &buttonFile, const Trace &trace, qint64 clearedNs);
+
+    QElapsedTimer m_clock;
+    qint64 m_lastTouchNs;
+    int m_outlierThresholdMs;
+    QHash<QString, Trace> m_traces;       // Button file -> round-trip in progress
+    QStringList m_awaitingFrame;          // Acknowledged, waiting for the frame showing it
+    QHash<QString, QVector<float>> m_totalsMs;  // Recent action->cleared per button
+
+    // Render thread handshake: the GUI sets m_ackPending, the next
+    // synchronization stamps m_syncNs, the swap after it reports the frame
+    QQuickWindow *m_window;
+    QAtomicInteger<int> m_ackPending;
+    QAtomicInteger<qint64> m_syncNs;
+};
+
+#endif // BUTTONLATENCY_H
@@ -1,12 +1,17 @@
 #include "configmanager.h"
+#include "metrics.h"
+#include "logging.h"
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSettings>
 #include <QRegularExpression>
+#include <QElapsedTimer>
 
 ConfigManager::ConfigManager(QObject *parent)
     : QObject(parent)
     , m_fileWatcher(new QFileSystemWatcher(this))
-    , m_settings(nullptr)
     , m_colorFlip(false)
     , m_helloState(true)
     , m_renderScreen(0)
@@ -14,6 +19,17 @@ ConfigManager::ConfigManager(QObject *parent)
     , m_renderHeight(600)
     , m_renderRotate(0)
     , m_renderMouse(1)
+    , m_metricsPort(0)
+    , m_buttonOutlierMs(1000)
+    , m_renderStats(false)
+    , m_qualityGovernor(true)
+    , m_qualityTempHigh(80)
+    , m_qualityTempLow(72)
+    , m_logRateLimit(200)
+    , m_frameSnapshotInterval(10)
+    , m_frameSnapshotWidth(320)
+    , m_stateSnapshotInterval(1000)
+    , m_stateSnapshotMaxAge(60)
     , m_mousePoint("mouse_assets/mouse-point.png")
     , m_mouseHover("mouse_assets/mouse-hover.png")
     , m_mouseField("mouse_assets/mouse-field.png")
@@ -51,6 +67,8 @@ ConfigManager::ConfigManager(QObject *parent)
     , m_imageBgColor("#000000")
     , m_imageFillMode(1)  // Qt::KeepAspectRatio (PreserveAspectFit)
     , m_imageShowBg(false)
+    , m_imageDuration(10)
+    , m_imagePreload(2)
     , m_alertState(false)
     , m_alertText("WANT TO CONTINUE?")
     , m_alertMenuLeft("YES")
@@ -59,35 +77,55 @@ ConfigManager::ConfigManager(QObject *parent)
     , m_buttonDir("/dev/shm/app/")
     , m_blankState(false)
     , m_blankFade(5)
+    , m_videoBgColor("#000000")
+    , m_videoFillMode(1)
+    , m_videoLoop(true)
+    , m_videoMuted(true)
 {
     connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &ConfigManager::onFileChanged);
+    connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged, this, &ConfigManager::onDirectoryChanged);
+
+    for (int i = 0; i <= ExtraScreenCount; i++) {
+        m_screens.append(new ScreenConfig(i, this));
+    }
 }
 
 ConfigManager::~ConfigManager()
 {
-    if (m_settings) {
-        delete m_settings;
-    }
 }
 
 void ConfigManager::setConfigPath(const QString &path)
 {
     m_configPath = path;
+    loadConfig();
+}
 
-    // Remove old file from watcher if exists
-    if (!m_fileWatcher->files().isEmpty()) {
-        m_fileWatcher->removePaths(m_fileWatcher->files());
+void ConfigManager::addOverlayPath(const QString &path)
+{
+    if (path.isEmpty() || m_extraOverlays.contains(path)) {
+        return;
     }
 
-    // Add new file to watcher
-    if (QFile::exists(path)) {
-        m_fileWatcher->addPath(path);
-        qDebug() << "Watching config file:" << path;
-    } else {
-        qWarning() << "Config file does not exist:" << path;
+    m_extraOverlays.append(path);
+
+    // Before the base is set, the overlay is picked up by setConfigPath()
+    if (!m_configPath.isEmpty()) {
+        loadConfig();
     }
+}
 
-    loadConfig();
+void ConfigManager::setPathRoot(const QString &root)
+{
+    m_pathRoot = root;
+}
+
+QStringList ConfigManager::overlayPaths() const
+{
+    QStringList paths;
+    for (int i = 1; i < m_sources.size(); i++) {
+        paths.append(m_sources.at(i).path);
+    }
+    return paths;
 }
 
 QString ConfigManager::parseHexColor(const QString &value)
@@ -104,197 +142,549 @@ QString ConfigManager::parseHexColor(const QString &value)
     return "#000000";
 }
 
+QHash<QString, QVariant> ConfigManager::parseConfigFile(const QString &path)
+{
+    QHash<QString, QVariant> values;
+
+    QSettings settings(path, QSettings::IniFormat);
+    const QStringList keys = settings.allKeys();
+    for (const QString &key : keys) {
+        values.insert(key, settings.value(key));
+    }
+
+    return values;
+}
+
+QVariant ConfigManager::value(const QString &group, const QString &key, const QVariant &defaultValue) const
+{
+    return m_values.value(group + QLatin1Char('/') + key, defaultValue);
+}
+
+QStringList ConfigManager::liveConfigOverlays() const
+{
+    QStringList paths;
+    if (m_sources.isEmpty()) {
+        return paths;
+    }
+
+    // A quoted path reads back as a string, an unquoted comma list as a string list
+    const QStringList entries = m_sources.first().values.value("app_live/live_config").toStringList();
+    for (const QString &entry : entries) {
+        QString path = entry.trimmed();
+        if (!path.isEmpty()) {
+            paths.append(path);
+        }
+    }
+    return paths;
+}
+
+void ConfigManager::refreshSourceState(ConfigSource &source)
+{
+    QFileInfo fileInfo(source.path);
+    source.exists = fileInfo.exists();
+    source.size = source.exists ? fileInfo.size() : -1;
+    source.modified = source.exists ? fileInfo.lastModified() : QDateTime();
+    source.values = source.exists ? parseConfigFile(source.path) : QHash<QString, QVariant>();
+}
+
+void ConfigManager::rebuildSources()
+{
+    m_sources.clear();
+
+    ConfigSource base;
+    base.path = m_configPath;
+    refreshSourceState(base);
+    m_sources.append(base);
+
+    // Overlays by increasing precedence: live_config entries, then addOverlayPath()
+    QStringList seen = { QFileInfo(m_configPath).absoluteFilePath() };
+    const QStringList liveOverlays = liveConfigOverlays();
+    for (int pass = 0; pass < 2; pass++) {
+        const QStringList &paths = (pass == 0) ? liveOverlays : m_extraOverlays;
+        for (const QString &path : paths) {
+            QString resolved = m_pathRoot.isEmpty() ? path : m_pathRoot + QFileInfo(path).absoluteFilePath();
+            QString absolutePath = QFileInfo(resolved).absoluteFilePath();
+            if (seen.contains(absolutePath)) {
+                continue;  // e.g. live_config pointing at the base file itself
+            }
+            seen.append(absolutePath);
+
+            ConfigSource overlay;
+            overlay.path = resolved;
+            overlay.fromLiveConfig = (pass == 0);
+            refreshSourceState(overlay);
+            m_sources.append(overlay);
+
+            qCDebug(lcConfig) << "Config overlay:" << path << (overlay.exists ? "" : "(not present yet)");
+        }
+    }
+
+    m_values.clear();
+    for (const ConfigSource &source : m_sources) {
+        QVariantMap changes;
+        for (auto it = source.values.constBegin(); it != source.values.constEnd(); ++it) {
+            m_values.insert(it.key(), it.value());
+            changes.insert(it.key(), it.value());
+        }
+        emit sourceReloaded(source.path, changes);
+    }
+
+    updateWatches();
+}
+
+void ConfigManager::updateWatches()
+{
+    if (!m_fileWatcher->files().isEmpty()) {
+        m_fileWatcher->removePaths(m_fileWatcher->files());
+    }
+    if (!m_fileWatcher->directories().isEmpty()) {
+        m_fileWatcher->removePaths(m_fileWatcher->directories());
+    }
+
+    for (const ConfigSource &source : m_sources) {
+        if (source.exists) {
+            m_fileWatcher->addPath(source.path);
+            qCDebug(lcConfig) << "Watching config file:" << source.path;
+        } else {
+            qCWarning(lcConfig) << "Config file does not exist:" << source.path;
+        }
+
+        // Directory watch catches files that appear later or are replaced by rename
+        QString dir = QFileInfo(source.path).absolutePath();
+        if (QDir(dir).exists() && !m_fileWatcher->directories().contains(dir)) {
+            m_fileWatcher->addPath(dir);
+        }
+    }
+}
+
+int ConfigManager::sourceIndex(const QString &path) const
+{
+    for (int i = 0; i < m_sources.size(); i++) {
+        if (m_sources.at(i).path == path) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QVariant ConfigManager::effectiveValue(const QString &key) const
+{
+    // Highest precedence source that defines the key wins
+    for (int i = m_sources.size() - 1; i >= 0; i--) {
+        auto it = m_sources.at(i).values.constFind(key);
+        if (it != m_sources.at(i).values.constEnd()) {
+            return it.value();
+        }
+    }
+    return QVariant();
+}
+
 void ConfigManager::loadConfig()
 {
     if (m_configPath.isEmpty()) {
-        qWarning() << "Config path not set";
+        qCWarning(lcConfig) << "Config path not set";
         return;
     }
 
     if (!QFile::exists(m_configPath)) {
-        qWarning() << "Config file does not exist:" << m_configPath;
+        qCWarning(lcConfig) << "Config file does not exist:" << m_configPath;
         return;
     }
 
-    // Store previous render dimensions to detect if they changed
-    int previousRenderWidth = m_renderWidth;
-    int previousRenderHeight = m_renderHeight;
+    qCDebug(lcConfig) << "Loading config from:" << m_configPath;
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    rebuildSources();
+
+    QSet<QString> sections = { "app_theme", "app_hello", "app_live", "app_timer",
+                               "app_image", "app_alert", "app_blank", "app_video" };
+    for (int i = 1; i <= ExtraScreenCount; i++) {
+        sections.insert(QString("app_screen_%1").arg(i));
+    }
+    applySections(sections);
+
+    qCDebug(lcConfig) << "Config loaded successfully";
+    Metrics::instance()->observe("gladis_config_load_seconds", loadTimer.nsecsElapsed() / 1e9);
+
+    emit configChanged();
+}
 
-    // Clean up old settings object
-    if (m_settings) {
-        delete m_settings;
-    }
-
-    // Create new settings object
-    m_settings = new QSettings(m_configPath, QSettings::IniFormat);
-    qDebug() << "Loading config from:" << m_configPath;
-
-    // Load App Theme section
-    m_settings->beginGroup("app_theme");
-    m_colorMain = parseHexColor(m_settings->value("color_main", "0x00AEEF").toString());
-    m_colorBg01 = parseHexColor(m_settings->value("color_bg01", "0x002657").toString());
-    m_colorBg02 = parseHexColor(m_settings->value("color_bg02", "0x00529b").toString());
-    m_colorText = parseHexColor(m_settings->value("color_text", "0xfb6502").toString());
-    m_colorFlip = m_settings->value("color_flip", 0).toInt() == 1;
-    m_settings->endGroup();
-
-    qDebug() << "Theme colors - Main:" << m_colorMain << "Bg01:" << m_colorBg01 << "Bg02:" << m_colorBg02 << "Text:" << m_colorText;
-
-    // Load App Hello section
-    m_settings->beginGroup("app_hello");
-    m_helloState = m_settings->value("hello_state", 1).toInt() == 1;
-    m_helloNews1 = m_settings->value("hello_news-1", "Welcome!").toString();
-    m_helloNews2 = m_settings->value("hello_news-2", "Welcome!").toString();
-    m_helloLead = m_settings->value("hello_lead", "/home/gladis/app/vars/banner_image.png").toString();
-    m_helloMain = m_settings->value("hello_main", "/home/gladis/app/vars/facility_logo.png").toString();
-    m_helloSpinText = m_settings->value("hello_spin-text", "NEW RELEASES").toString();
-    m_helloSpinImg1 = m_settings->value("hello_spin-img1", "/home/gladis/app/vars/game1_image.jpg").toString();
-    m_helloSpinImg2 = m_settings->value("hello_spin-img2", "/home/gladis/app/vars/game2_image.jpg").toString();
-    m_helloSpinImg3 = m_settings->value("hello_spin-img3", "/home/gladis/app/vars/game3_image.jpg").toString();
-    m_helloSpinImg4 = m_settings->value("hello_spin-img4", "/home/gladis/app/vars/game4_image.jpg").toString();
-    m_helloShow1 = m_settings->value("hello_show-1", "/home/gladis/app/vars/left_image.png").toString();
-    m_helloShow2 = m_settings->value("hello_show-2", "/home/gladis/app/vars/right_image.png").toString();
-    m_helloHourText = m_settings->value("hello_hour-text", "LAB HOURS").toString();
-    m_helloHourData = m_settings->value("hello_hour-data", "/home/gladis/app/vars/facility_data.json").toString();
-    m_helloListText = m_settings->value("hello_list-text", "PLAYERS").toString();
-    m_helloListData = m_settings->value("hello_list-data", "/home/gladis/app/vars/user_data.json").toString();
-    m_helloLogo = m_settings->value("hello_logo", "/home/gladis/app/vars/gamelab.gif").toString();
-    m_helloScan = m_settings->value("hello_scan", "/home/gladis/app/vars/qr_support.png").toString();
-    m_settings->endGroup();
+void ConfigManager::reloadSource(int index)
+{
+    if (index < 0 || index >= m_sources.size()) {
+        return;
+    }
+
+    QElapsedTimer reloadTimer;
+    reloadTimer.start();
+    QStringList overlaysBefore = liveConfigOverlays();
+
+    // Re-parse only this file and find the keys it added, removed or changed
+    ConfigSource &source = m_sources[index];
+    const QHash<QString, QVariant> oldValues = source.values;
+    refreshSourceState(source);
+    const QHash<QString, QVariant> &newValues = source.values;
+
+    QSet<QString> touched;
+    for (auto it = oldValues.constBegin(); it != oldValues.constEnd(); ++it) {
+        auto found = newValues.constFind(it.key());
+        if (found == newValues.constEnd() || found.value() != it.value()) {
+            touched.insert(it.key());
+        }
+    }
+    for (auto it = newValues.constBegin(); it != newValues.constEnd(); ++it) {
+        if (!oldValues.contains(it.key())) {
+            touched.insert(it.key());
+        }
+    }
+
+    if (touched.isEmpty()) {
+        qCDebug(lcConfig) << "Config file rewritten without changes:" << source.path;
+        Metrics::instance()->increment("gladis_config_noop_reloads_total");
+        return;
+    }
+
+    // Removed keys are reported with an invalid value
+    QVariantMap changes;
+    for (const QString &key : touched) {
+        changes.insert(key, newValues.value(key));
+    }
+    emit sourceReloaded(source.path, changes);
+
+    // The base changed its overlay list - the source set itself is different
+    if (index == 0 && liveConfigOverlays() != overlaysBefore) {
+        qCDebug(lcConfig) << "live_config changed, reloading all config sources";
+        loadConfig();
+        return;
+    }
+
+    // Re-resolve the touched keys; a key shadowed by a higher overlay has no effect
+    QSet<QString> groups;
+    for (const QString &key : touched) {
+        QVariant effective = effectiveValue(key);
+        bool changed = false;
+        if (effective.isValid()) {
+            auto current = m_values.constFind(key);
+            changed = (current == m_values.constEnd() || current.value() != effective);
+            m_values.insert(key, effective);
+        } else {
+            changed = m_values.remove(key) > 0;
+        }
+
+        if (changed) {
+            groups.insert(key.section(QLatin1Char('/'), 0, 0));
+        }
+    }
+
+    qCDebug(lcConfig) << "Config source" << source.path << "touched" << touched.size()
+             << "keys, re-applying sections:" << QStringList(groups.begin(), groups.end());
+
+    if (groups.isEmpty()) {
+        return;
+    }
+
+    applySections(groups);
+    Metrics::instance()->observe("gladis_config_reload_seconds", reloadTimer.nsecsElapsed() / 1e9);
+    emit configChanged();
+}
+
+void ConfigManager::applySections(const QSet<QString> &groups)
+{
+    bool theme = groups.contains("app_theme");
+    bool hello = groups.contains("app_hello");
+    bool live = groups.contains("app_live");
+    bool timer = groups.contains("app_timer");
+    bool image = groups.contains("app_image");
+    bool alert = groups.contains("app_alert");
+    bool blank = groups.contains("app_blank");
+    bool video = groups.contains("app_video");
+    bool screens = false;
+
+    if (theme) applyTheme();
+    if (hello) applyHello();
+    if (live) applyLive();
+    if (timer) applyTimer();
+    if (image) applyImage();
+    if (alert) applyAlert();
+    if (blank) applyBlank();
+    if (video) applyVideo();
+    for (int i = 1; i <= ExtraScreenCount; i++) {
+        if (groups.contains(QString("app_screen_%1").arg(i))) {
+            applyScreen(i);
+            screens = true;
+        }
+    }
+
+    // Let data consumers warm up before QML reacts to the new layer setup
+    if (live || screens) {
+        QStringList apps = layerApps();
+        if (apps != m_layerApps) {
+            m_layerApps = apps;
+            qCDebug(lcConfig) << "Layer apps:" << m_layerApps;
+            emit layerAppsChanged(m_layerApps);
+        }
+    }
+
+    if (theme) emit themeChanged();
+    if (hello) emit helloChanged();
+    if (live) emit liveChanged();
+    if (timer) emit timerChanged();
+    if (image) emit imageChanged();
+    if (alert) emit alertChanged();
+    if (blank) emit blankChanged();
+    if (video) emit videoChanged();
+    if (screens) emit screensChanged();
+}
+
+void ConfigManager::applyTheme()
+{
+    m_colorMain = parseHexColor(value("app_theme", "color_main", "0x00AEEF").toString());
+    m_colorBg01 = parseHexColor(value("app_theme", "color_bg01", "0x002657").toString());
+    m_colorBg02 = parseHexColor(value("app_theme", "color_bg02", "0x00529b").toString());
+    m_colorText = parseHexColor(value("app_theme", "color_text", "0xfb6502").toString());
+    m_colorFlip = value("app_theme", "color_flip", 0).toInt() == 1;
+
+    qCDebug(lcConfig) << "Theme colors - Main:" << m_colorMain << "Bg01:" << m_colorBg01 << "Bg02:" << m_colorBg02 << "Text:" << m_colorText;
+}
+
+void ConfigManager::applyHello()
+{
+    m_helloState = value("app_hello", "hello_state", 1).toInt() == 1;
+    m_helloNews1 = value("app_hello", "hello_news-1", "Welcome!").toString();
+    m_helloNews2 = value("app_hello", "hello_news-2", "Welcome!").toString();
+    m_helloLead = value("app_hello", "hello_lead", "/home/gladis/app/vars/banner_image.png").toString();
+    m_helloMain = value("app_hello", "hello_main", "/home/gladis/app/vars/facility_logo.png").toString();
+    m_helloSpinText = value("app_hello", "hello_spin-text", "NEW RELEASES").toString();
+    m_helloSpinImg1 = value("app_hello", "hello_spin-img1", "/home/gladis/app/vars/game1_image.jpg").toString();
+    m_helloSpinImg2 = value("app_hello", "hello_spin-img2", "/home/gladis/app/vars/game2_image.jpg").toString();
+    m_helloSpinImg3 = value("app_hello", "hello_spin-img3", "/home/gladis/app/vars/game3_image.jpg").toString();
+    m_helloSpinImg4 = value("app_hello", "hello_spin-img4", "/home/gladis/app/vars/game4_image.jpg").toString();
+    m_helloShow1 = value("app_hello", "hello_show-1", "/home/gladis/app/vars/left_image.png").toString();
+    m_helloShow2 = value("app_hello", "hello_show-2", "/home/gladis/app/vars/right_image.png").toString();
+    m_helloHourText = value("app_hello", "hello_hour-text", "LAB HOURS").toString();
+    m_helloHourData = value("app_hello", "hello_hour-data", "/home/gladis/app/vars/facility_data.json").toString();
+    m_helloListText = value("app_hello", "hello_list-text", "PLAYERS").toString();
+    m_helloListData = value("app_hello", "hello_list-data", "/home/gladis/app/vars/user_data.json").toString();
+    m_helloLogo = value("app_hello", "hello_logo", "/home/gladis/app/vars/gamelab.gif").toString();
+    m_helloScan = value("app_hello", "hello_scan", "/home/gladis/app/vars/qr_support.png").toString();
 
     // Parse platform list from hello_list-* entries
     parsePlatformList();
+}
 
-    // Load render properties from app_live section
-    m_settings->beginGroup("app_live");
+void ConfigManager::applyLive()
+{
+    // Store previous render dimensions to detect if they changed
+    int previousRenderWidth = m_renderWidth;
+    int previousRenderHeight = m_renderHeight;
 
-    m_renderScreen = m_settings->value("render_screen", 0).toInt();
+    m_renderScreen = value("app_live", "render_screen", 0).toInt();
 
     // Load all layers (layer_0 is front-most)
-    m_layer0 = m_settings->value("layer_0", "").toString();
-    m_layer1 = m_settings->value("layer_1", "").toString();
-    m_layer2 = m_settings->value("layer_2", "").toString();
-    m_layer3 = m_settings->value("layer_3", "").toString();
-    m_layer4 = m_settings->value("layer_4", "").toString();
-    m_layer5 = m_settings->value("layer_5", "").toString();
-    m_layer6 = m_settings->value("layer_6", "").toString();
-    m_layer7 = m_settings->value("layer_7", "").toString();
-    m_layer8 = m_settings->value("layer_8", "").toString();
-    m_layer9 = m_settings->value("layer_9", "").toString();
+    m_layer0 = value("app_live", "layer_0", "").toString();
+    m_layer1 = value("app_live", "layer_1", "").toString();
+    m_layer2 = value("app_live", "layer_2", "").toString();
+    m_layer3 = value("app_live", "layer_3", "").toString();
+    m_layer4 = value("app_live", "layer_4", "").toString();
+    m_layer5 = value("app_live", "layer_5", "").toString();
+    m_layer6 = value("app_live", "layer_6", "").toString();
+    m_layer7 = value("app_live", "layer_7", "").toString();
+    m_layer8 = value("app_live", "layer_8", "").toString();
+    m_layer9 = value("app_live", "layer_9", "").toString();
 
     // Load layer transition times (in milliseconds)
-    m_layerTransition0 = m_settings->value("layer_transition_0", 300).toInt();
-    m_layerTransition1 = m_settings->value("layer_transition_1", 300).toInt();
-    m_layerTransition2 = m_settings->value("layer_transition_2", 300).toInt();
-    m_layerTransition3 = m_settings->value("layer_transition_3", 300).toInt();
-    m_layerTransition4 = m_settings->value("layer_transition_4", 300).toInt();
-    m_layerTransition5 = m_settings->value("layer_transition_5", 300).toInt();
-    m_layerTransition6 = m_settings->value("layer_transition_6", 300).toInt();
-    m_layerTransition7 = m_settings->value("layer_transition_7", 300).toInt();
-    m_layerTransition8 = m_settings->value("layer_transition_8", 300).toInt();
-    m_layerTransition9 = m_settings->value("layer_transition_9", 300).toInt();
-
-    QString renderWindow = m_settings->value("render_window", "1024x600").toString();  // Default to 1024x600
-    qDebug() << "DEBUG: Read render_window from INI:" << renderWindow;
+    m_layerTransition0 = value("app_live", "layer_transition_0", 300).toInt();
+    m_layerTransition1 = value("app_live", "layer_transition_1", 300).toInt();
+    m_layerTransition2 = value("app_live", "layer_transition_2", 300).toInt();
+    m_layerTransition3 = value("app_live", "layer_transition_3", 300).toInt();
+    m_layerTransition4 = value("app_live", "layer_transition_4", 300).toInt();
+    m_layerTransition5 = value("app_live", "layer_transition_5", 300).toInt();
+    m_layerTransition6 = value("app_live", "layer_transition_6", 300).toInt();
+    m_layerTransition7 = value("app_live", "layer_transition_7", 300).toInt();
+    m_layerTransition8 = value("app_live", "layer_transition_8", 300).toInt();
+    m_layerTransition9 = value("app_live", "layer_transition_9", 300).toInt();
+
+    QString renderWindow = value("app_live", "render_window", "1024x600").toString();  // Default to 1024x600
     QStringList dimensions = renderWindow.split('x');
-    qDebug() << "DEBUG: Split dimensions:" << dimensions;
     if (dimensions.size() == 2) {
         m_renderWidth = dimensions[0].toInt();
         m_renderHeight = dimensions[1].toInt();
-        qDebug() << "DEBUG: Parsed width:" << m_renderWidth << "height:" << m_renderHeight;
-    }
-    m_renderRotate = m_settings->value("render_rotate", 0).toInt();
-    m_renderMouse = m_settings->value("render_mouse", 1).toInt();
-    m_mousePoint = m_settings->value("mouse-point", "mouse_assets/mouse-point.png").toString();
-    m_mouseHover = m_settings->value("mouse-hover", "mouse_assets/mouse-hover.png").toString();
-    m_mouseField = m_settings->value("mouse-field", "mouse_assets/mouse-field.png").toString();
-    m_mouseDelay = m_settings->value("mouse-delay", "mouse_assets/mouse-delay.png").toString();
-    m_settings->endGroup();
-
-    qDebug() << "Layers (0=front-most):";
-    qDebug() << "  layer_0:" << m_layer0 << "(transition:" << m_layerTransition0 << "ms)";
-    qDebug() << "  layer_1:" << m_layer1 << "(transition:" << m_layerTransition1 << "ms)";
-    qDebug() << "  layer_2:" << m_layer2 << "(transition:" << m_layerTransition2 << "ms)";
-    qDebug() << "  layer_3:" << m_layer3 << "(transition:" << m_layerTransition3 << "ms)";
-    qDebug() << "  layer_4:" << m_layer4 << "(transition:" << m_layerTransition4 << "ms)";
-    qDebug() << "  layer_5:" << m_layer5 << "(transition:" << m_layerTransition5 << "ms)";
-    qDebug() << "  layer_6:" << m_layer6 << "(transition:" << m_layerTransition6 << "ms)";
-    qDebug() << "  layer_7:" << m_layer7 << "(transition:" << m_layerTransition7 << "ms)";
-    qDebug() << "  layer_8:" << m_layer8 << "(transition:" << m_layerTransition8 << "ms)";
-    qDebug() << "  layer_9:" << m_layer9 << "(transition:" << m_layerTransition9 << "ms)";
-    qDebug() << "Render fullscreen mode:" << (m_renderScreen ? "enabled" : "disabled");
-    qDebug() << "Render dimensions:" << m_renderWidth << "x" << m_renderHeight << "Rotation:" << m_renderRotate;
-    qDebug() << "Custom mouse cursor:" << (m_renderMouse ? "enabled" : "disabled");
-
-    // Load App Timer section
-    m_settings->beginGroup("app_timer");
-    m_timerState = m_settings->value("timer_state", 0).toInt() == 1;
-    m_timerCount = m_settings->value("timer_count", 0).toInt() == 1;
-    m_timerMax = m_settings->value("timer_max", 99).toInt();
-    m_timerText = m_settings->value("timer_text", "FINISH SSO LOGIN").toString();
-    m_timerMenuLeft = m_settings->value("timer_menu-l", "NEED MORE TIME").toString();
-    m_timerMenuMiddle = m_settings->value("timer_menu-m", "").toString();
-    m_timerMenuRight = m_settings->value("timer_menu-r", "START OVER").toString();
-    m_timerAlert = m_settings->value("timer_alert", "/dev/shm/app/timer_alert").toString();
-    m_timerReset = m_settings->value("timer_reset", "/dev/shm/app/timer_reset").toString();
-    m_settings->endGroup();
-
-    qDebug() << "Timer config - State:" << m_timerState << "Count:" << m_timerCount << "Max:" << m_timerMax;
-    qDebug() << "Timer text:" << m_timerText;
-    qDebug() << "Timer alert file:" << m_timerAlert << "Reset file:" << m_timerReset;
-
-    // Load App Image section
-    m_settings->beginGroup("app_image");
-    m_imageSource = m_settings->value("image_source", "").toString();
-    m_imageBgColor = m_settings->value("image_bg_color", "#000000").toString();
-    m_imageFillMode = m_settings->value("image_fill_mode", 1).toInt();  // 0=Stretch, 1=PreserveAspectFit, 2=PreserveAspectCrop
-    m_imageShowBg = m_settings->value("image_show_bg", 0).toInt() == 1;
-    m_settings->endGroup();
-
-    qDebug() << "Image config - Source:" << m_imageSource << "FillMode:" << m_imageFillMode << "ShowBg:" << m_imageShowBg;
-
-    // Load App Alert section
-    m_settings->beginGroup("app_alert");
-    m_alertState = m_settings->value("alert_state", 0).toInt() == 1;
-    m_alertText = m_settings->value("alert_text", "WANT TO CONTINUE?").toString();
-    m_alertMenuLeft = m_settings->value("alert_menu-l", "YES").toString();
-    m_alertMenuMiddle = m_settings->value("alert_menu-m", "").toString();
-    m_alertMenuRight = m_settings->value("alert_menu-r", "NO!").toString();
-    m_buttonDir = m_settings->value("button_dir", "/dev/shm/app/").toString();
-    m_settings->endGroup();
-
-    qDebug() << "Alert config - State:" << m_alertState << "Text:" << m_alertText;
-    qDebug() << "Button directory:" << m_buttonDir;
-
-    // Load App Blank section
-    m_settings->beginGroup("app_blank");
-    m_blankState = m_settings->value("blank_state", 0).toInt() == 1;
-    m_blankFade = m_settings->value("blank_fade", 5).toInt();
-    m_settings->endGroup();
-
-    qDebug() << "Blank config - State:" << m_blankState << "Fade duration:" << m_blankFade << "seconds";
-
-    qDebug() << "Config loaded successfully";
+    } else {
+        qCWarning(lcConfig) << "Invalid render_window:" << renderWindow;
+    }
+    m_renderRotate = value("app_live", "render_rotate", 0).toInt();
+    m_renderRotateMode = value("app_live", "render_rotate_mode", "auto").toString();
+    m_renderMouse = value("app_live", "render_mouse", 1).toInt();
+    m_mousePoint = value("app_live", "mouse-point", "mouse_assets/mouse-point.png").toString();
+    m_mouseHover = value("app_live", "mouse-hover", "mouse_assets/mouse-hover.png").toString();
+    m_mouseField = value("app_live", "mouse-field", "mouse_assets/mouse-field.png").toString();
+    m_mouseDelay = value("app_live", "mouse-delay", "mouse_assets/mouse-delay.png").toString();
+    m_metricsPort = value("app_live", "metrics_port", 0).toInt();
+    m_metricsSocket = value("app_live", "metrics_socket", "").toString();
+    m_buttonOutlierMs = value("app_live", "button_outlier_ms", 1000).toInt();
+    m_renderStats = value("app_live", "render_stats", 0).toInt() == 1;
+    m_qualityGovernor = value("app_live", "quality_governor", 1).toInt() == 1;
+    m_qualityThermalZone = value("app_live", "quality_thermal_zone", "/sys/class/thermal/thermal_zone0/temp").toString();
+    m_qualityTempHigh = value("app_live", "quality_temp_high", 80).toInt();
+    m_qualityTempLow = value("app_live", "quality_temp_low", 72).toInt();
+    m_stateSnapshot = value("app_live", "state_snapshot", "").toString();
+    m_renderBackend = value("app_live", "render_backend", "opengl").toString();
+    m_renderPipelineCache = value("app_live", "render_pipeline_cache", "auto").toString();
+    m_renderGlyphCache = value("app_live", "render_glyph_cache", "auto").toString();
+    m_logOutput = value("app_live", "log_output", "").toString();
+    m_logRules = value("app_live", "log_rules", "").toString();
+    m_logRateLimit = value("app_live", "log_rate_limit", 200).toInt();
+    m_frameSnapshot = value("app_live", "frame_snapshot", "").toString();
+    m_frameSnapshotInterval = value("app_live", "frame_snapshot_interval", 10).toInt();
+    m_frameSnapshotWidth = value("app_live", "frame_snapshot_width", 320).toInt();
+    m_stateSnapshotInterval = value("app_live", "state_snapshot_interval", 1000).toInt();
+    m_stateSnapshotMaxAge = value("app_live", "state_snapshot_max_age", 60).toInt();
+
+    // The primary output window
+    ScreenConfig::Settings primary;
+    primary.enabled = true;
+    primary.output = value("app_live", "render_output", "").toString();
+    primary.layers = QStringList{ m_layer0, m_layer1, m_layer2, m_layer3, m_layer4,
+                                  m_layer5, m_layer6, m_layer7, m_layer8, m_layer9 };
+    primary.layerTransitions = QVariantList{ m_layerTransition0, m_layerTransition1, m_layerTransition2,
+                                             m_layerTransition3, m_layerTransition4, m_layerTransition5,
+                                             m_layerTransition6, m_layerTransition7, m_layerTransition8,
+                                             m_layerTransition9 };
+    primary.renderScreen = m_renderScreen;
+    primary.renderWidth = m_renderWidth;
+    primary.renderHeight = m_renderHeight;
+    primary.renderRotate = m_renderRotate;
+    primary.renderRotateMode = m_renderRotateMode;
+    m_screens.first()->setSettings(primary);
+
+    qCDebug(lcConfig) << "Layers (0=front-most):" << primary.layers << "transitions:" << primary.layerTransitions;
+    qCDebug(lcConfig) << "Render fullscreen mode:" << (m_renderScreen ? "enabled" : "disabled");
+    qCDebug(lcConfig) << "Render dimensions:" << m_renderWidth << "x" << m_renderHeight << "Rotation:" << m_renderRotate << m_renderRotateMode;
+    qCDebug(lcConfig) << "Custom mouse cursor:" << (m_renderMouse ? "enabled" : "disabled");
 
     // Check if resolution actually changed
     bool resolutionChanged = (m_renderWidth != previousRenderWidth || m_renderHeight != previousRenderHeight);
     if (resolutionChanged) {
-        qDebug() << "Resolution changed from" << previousRenderWidth << "x" << previousRenderHeight
+        qCDebug(lcConfig) << "Resolution changed from" << previousRenderWidth << "x" << previousRenderHeight
                  << "to" << m_renderWidth << "x" << m_renderHeight;
     }
+}
 
-    emit configChanged();
+void ConfigManager::applyTimer()
+{
+    m_timerState = value("app_timer", "timer_state", 0).toInt() == 1;
+    m_timerCount = value("app_timer", "timer_count", 0).toInt() == 1;
+    m_timerMax = value("app_timer", "timer_max", 99).toInt();
+    m_timerText = value("app_timer", "timer_text", "FINISH SSO LOGIN").toString();
+    m_timerMenuLeft = value("app_timer", "timer_menu-l", "NEED MORE TIME").toString();
+    m_timerMenuMiddle = value("app_timer", "timer_menu-m", "").toString();
+    m_timerMenuRight = value("app_timer", "timer_menu-r", "START OVER").toString();
+    m_timerAlert = value("app_timer", "timer_alert", "/dev/shm/app/timer_alert").toString();
+    m_timerReset = value("app_timer", "timer_reset", "/dev/shm/app/timer_reset").toString();
+
+    qCDebug(lcConfig) << "Timer config - State:" << m_timerState << "Count:" << m_timerCount << "Max:" << m_timerMax;
+    qCDebug(lcConfig) << "Timer text:" << m_timerText;
+    qCDebug(lcConfig) << "Timer alert file:" << m_timerAlert << "Reset file:" << m_timerReset;
 }
 
-void ConfigManager::parsePlatformList()
+void ConfigManager::applyImage()
 {
-    m_platformList.clear();
+    m_imageSource = value("app_image", "image_source", "").toString();
+    m_imageBgColor = value("app_image", "image_bg_color", "#000000").toString();
+    m_imageFillMode = value("app_image", "image_fill_mode", 1).toInt();  // 0=Stretch, 1=PreserveAspectFit, 2=PreserveAspectCrop
+    m_imageShowBg = value("app_image", "image_show_bg", 0).toInt() == 1;
+    m_imagePlaylist = value("app_image", "image_playlist", "").toString();
+    m_imageDuration = value("app_image", "image_duration", 10).toInt();
+    m_imagePreload = value("app_image", "image_preload", 2).toInt();
+
+    qCDebug(lcConfig) << "Image config - Source:" << m_imageSource << "FillMode:" << m_imageFillMode << "ShowBg:" << m_imageShowBg;
+    if (!m_imagePlaylist.isEmpty()) {
+        qCDebug(lcConfig) << "Image playlist:" << m_imagePlaylist << "default duration:" << m_imageDuration
+                 << "s, preload:" << m_imagePreload;
+    }
+}
 
-    if (!m_settings) {
-        return;
+void ConfigManager::applyAlert()
+{
+    m_alertState = value("app_alert", "alert_state", 0).toInt() == 1;
+    m_alertText = value("app_alert", "alert_text", "WANT TO CONTINUE?").toString();
+    m_alertMenuLeft = value("app_alert", "alert_menu-l", "YES").toString();
+    m_alertMenuMiddle = value("app_alert", "alert_menu-m", "").toString();
+    m_alertMenuRight = value("app_alert", "alert_menu-r", "NO!").toString();
+    m_buttonDir = value("app_alert", "button_dir", "/dev/shm/app/").toString();
+
+    qCDebug(lcConfig) << "Alert config - State:" << m_alertState << "Text:" << m_alertText;
+    qCDebug(lcConfig) << "Button directory:" << m_buttonDir;
+}
+
+void ConfigManager::applyBlank()
+{
+    m_blankState = value("app_blank", "blank_state", 0).toInt() == 1;
+    m_blankFade = value("app_blank", "blank_fade", 5).toInt();
+
+    qCDebug(lcConfig) << "Blank config - State:" << m_blankState << "Fade duration:" << m_blankFade << "seconds";
+}
+
+void ConfigManager::applyVideo()
+{
+    m_videoSource = value("app_video", "video_source", "").toString();
+    m_videoBgColor = value("app_video", "video_bg_color", "#000000").toString();
+    m_videoFillMode = value("app_video", "video_fill_mode", 1).toInt();  // 0=Stretch, 1=PreserveAspectFit, 2=PreserveAspectCrop
+    m_videoLoop = value("app_video", "video_loop", 1).toInt() == 1;
+    m_videoMuted = value("app_video", "video_muted", 1).toInt() == 1;
+
+    qCDebug(lcConfig) << "Video config - Source:" << m_videoSource << "FillMode:" << m_videoFillMode
+             << "Loop:" << m_videoLoop << "Muted:" << m_videoMuted;
+}
+
+void ConfigManager::applyScreen(int index)
+{
+    const QString group = QString("app_screen_%1").arg(index);
+
+    ScreenConfig::Settings settings;
+    settings.enabled = value(group, "screen_state", 0).toInt() == 1;
+    settings.output = value(group, "render_output", QString::number(index)).toString();
+    for (int i = 0; i < ScreenConfig::LayerCount; i++) {
+        settings.layers.append(value(group, QString("layer_%1").arg(i), "").toString());
+        settings.layerTransitions.append(value(group, QString("layer_transition_%1").arg(i), 300).toInt());
+    }
+    QStringList dimensions = value(group, "render_window", "1024x600").toString().split('x');
+    if (dimensions.size() == 2) {
+        settings.renderWidth = dimensions[0].toInt();
+        settings.renderHeight = dimensions[1].toInt();
     }
+    settings.renderScreen = value(group, "render_screen", 1).toInt();
+    settings.renderRotate = value(group, "render_rotate", 0).toInt();
+    settings.renderRotateMode = value(group, "render_rotate_mode", "auto").toString();
 
-    m_settings->beginGroup("app_hello");
+    m_screens.at(index)->setSettings(settings);
+
+    if (settings.enabled) {
+        qCDebug(lcConfig) << "Screen" << index << "on output" << settings.output << "-" << settings.renderWidth << "x"
+                 << settings.renderHeight << "rotation:" << settings.renderRotate << "layers:" << settings.layers;
+    }
+}
+
+QStringList ConfigManager::layerApps() const
+{
+    // Every enabled output's layers: data is shared, one DataManager feeds all windows
+    QStringList apps;
+    for (const ScreenConfig *screen : m_screens) {
+        if (!screen->enabled()) {
+            continue;
+        }
+        for (const QString &layer : screen->layers()) {
+            if (!layer.isEmpty() && !apps.contains(layer)) {
+                apps.append(layer);
+            }
+        }
+    }
+    return apps;
+}
+
+void ConfigManager::parsePlatformList()
+{
+    m_platformList.clear();
 
     // Parse hello_list-* entries (img, cat, tot)
     // Look for entries from 0 to 9 (supports up to 10 platforms)
@@ -303,32 +693,64 @@ void ConfigManager::parsePlatformList()
         QString catKey = QString("hello_list-cat%1").arg(i);
         QString totKey = QString("hello_list-tot%1").arg(i);
 
-        if (m_settings->contains(catKey)) {
+        if (m_values.contains("app_hello/" + catKey)) {
             QVariantMap platform;
-            platform["icon"] = m_settings->value(imgKey, "").toString();
-            platform["category"] = m_settings->value(catKey, "").toString();
-            platform["total"] = m_settings->value(totKey, "0").toInt();
+            platform["icon"] = value("app_hello", imgKey, "").toString();
+            platform["category"] = value("app_hello", catKey, "").toString();
+            platform["total"] = value("app_hello", totKey, "0").toInt();
             platform["index"] = i;
 
             m_platformList.append(platform);
-            qDebug() << "Platform" << i << ":" << platform["category"] << "-" << platform["total"] << "icon:" << platform["icon"];
+            qCDebug(lcConfig) << "Platform" << i << ":" << platform["category"] << "-" << platform["total"] << "icon:" << platform["icon"];
         }
     }
 
-    m_settings->endGroup();
-
-    qDebug() << "Parsed" << m_platformList.size() << "platforms";
+    qCDebug(lcConfig) << "Parsed" << m_platformList.size() << "platforms";
 }
 
 void ConfigManager::onFileChanged(const QString &path)
 {
-    qDebug() << "Config file changed:" << path;
+    qCDebug(lcConfig) << "Config file changed:" << path;
+    Metrics::instance()->increment("gladis_watcher_events_total", "source=\"config\",kind=\"file\"");
+    emit fileEventReceived(path);
 
     // Re-add the file to watcher (it gets removed automatically after change)
-    if (!m_fileWatcher->files().contains(path)) {
+    if (!m_fileWatcher->files().contains(path) && QFile::exists(path)) {
         m_fileWatcher->addPath(path);
     }
 
-    // Reload configuration
-    loadConfig();
+    // Re-parse only the file that changed
+    reloadSource(sourceIndex(path));
+}
+
+void ConfigManager::onDirectoryChanged(const QString &path)
+{
+    Metrics::instance()->increment("gladis_watcher_events_total", "source=\"config\",kind=\"directory\"");
+    emit fileEventReceived(path);
+
+    // Overlays created, deleted or replaced by rename in this directory
+    for (int i = 0; i < m_sources.size(); i++) {
+        const ConfigSource &source = m_sources.at(i);
+        if (QFileInfo(source.path).absolutePath() != path) {
+            continue;
+        }
+
+        QFileInfo fileInfo(source.path);
+        bool exists = fileInfo.exists();
+        if (exists == source.exists &&
+            (!exists || (fileInfo.size() == source.size && fileInfo.lastModified() == source.modified))) {
+            continue;
+        }
+
+        qCDebug(lcConfig) << "Config file" << (exists ? "updated:" : "removed:") << source.path;
+        if (exists && !m_fileWatcher->files().contains(source.path)) {
+            m_fileWatcher->addPath(source.path);
+        }
+
+        int sourceCount = m_sources.size();
+        reloadSource(i);
+        if (m_sources.size() != sourceCount || i >= m_sources.size()) {
+            break;  // Sources were rebuilt
+        }
+    }
 }
@@ -2,117 +2,173 @@
 #define CONFIGMANAGER_H
 
 #include <QObject>
-#include <QSettings>
 #include <QFileSystemWatcher>
 #include <QVariantMap>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QDateTime>
 #include <QString>
 #include <QColor>
+#include "screenconfig.h"
 
 class ConfigManager : public QObject
 {
     Q_OBJECT
 
     // App Theme Properties
-    Q_PROPERTY(QString colorMain READ colorMain NOTIFY configChanged)
-    Q_PROPERTY(QString colorBg01 READ colorBg01 NOTIFY configChanged)
-    Q_PROPERTY(QString colorBg02 READ colorBg02 NOTIFY configChanged)
-    Q_PROPERTY(QString colorText READ colorText NOTIFY configChanged)
-    Q_PROPERTY(bool colorFlip READ colorFlip NOTIFY configChanged)
+    Q_PROPERTY(QString colorMain READ colorMain NOTIFY themeChanged)
+    Q_PROPERTY(QString colorBg01 READ colorBg01 NOTIFY themeChanged)
+    Q_PROPERTY(QString colorBg02 READ colorBg02 NOTIFY themeChanged)
+    Q_PROPERTY(QString colorText READ colorText NOTIFY themeChanged)
+    Q_PROPERTY(bool colorFlip READ colorFlip NOTIFY themeChanged)
 
     // App Hello Properties
-    Q_PROPERTY(bool helloState READ helloState NOTIFY configChanged)
-    Q_PROPERTY(QString helloNews1 READ helloNews1 NOTIFY configChanged)
-    Q_PROPERTY(QString helloNews2 READ helloNews2 NOTIFY configChanged)
-    Q_PROPERTY(QString helloLead READ helloLead NOTIFY configChanged)
-    Q_PROPERTY(QString helloMain READ helloMain NOTIFY configChanged)
-    Q_PROPERTY(QString helloSpinText READ helloSpinText NOTIFY configChanged)
-    Q_PROPERTY(QString helloSpinImg1 READ helloSpinImg1 NOTIFY configChanged)
-    Q_PROPERTY(QString helloSpinImg2 READ helloSpinImg2 NOTIFY configChanged)
-    Q_PROPERTY(QString helloSpinImg3 READ helloSpinImg3 NOTIFY configChanged)
-    Q_PROPERTY(QString helloSpinImg4 READ helloSpinImg4 NOTIFY configChanged)
-    Q_PROPERTY(QString helloShow1 READ helloShow1 NOTIFY configChanged)
-    Q_PROPERTY(QString helloShow2 READ helloShow2 NOTIFY configChanged)
-    Q_PROPERTY(QString helloHourText READ helloHourText NOTIFY configChanged)
-    Q_PROPERTY(QString helloHourData READ helloHourData NOTIFY configChanged)
-    Q_PROPERTY(QString helloListText READ helloListText NOTIFY configChanged)
-    Q_PROPERTY(QString helloListData READ helloListData NOTIFY configChanged)
-    Q_PROPERTY(QString helloLogo READ helloLogo NOTIFY configChanged)
-    Q_PROPERTY(QString helloScan READ helloScan NOTIFY configChanged)
+    Q_PROPERTY(bool helloState READ helloState NOTIFY helloChanged)
+    Q_PROPERTY(QString helloNews1 READ helloNews1 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloNews2 READ helloNews2 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloLead READ helloLead NOTIFY helloChanged)
+    Q_PROPERTY(QString helloMain READ helloMain NOTIFY helloChanged)
+    Q_PROPERTY(QString helloSpinText READ helloSpinText NOTIFY helloChanged)
+    Q_PROPERTY(QString helloSpinImg1 READ helloSpinImg1 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloSpinImg2 READ helloSpinImg2 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloSpinImg3 READ helloSpinImg3 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloSpinImg4 READ helloSpinImg4 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloShow1 READ helloShow1 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloShow2 READ helloShow2 NOTIFY helloChanged)
+    Q_PROPERTY(QString helloHourText READ helloHourText NOTIFY helloChanged)
+    Q_PROPERTY(QString helloHourData READ helloHourData NOTIFY helloChanged)
+    Q_PROPERTY(QString helloListText READ helloListText NOTIFY helloChanged)
+    Q_PROPERTY(QString helloListData READ helloListData NOTIFY helloChanged)
+    Q_PROPERTY(QString helloLogo READ helloLogo NOTIFY helloChanged)
+    Q_PROPERTY(QString helloScan READ helloScan NOTIFY helloChanged)
 
     // Dynamic player list properties (for platforms)
-    Q_PROPERTY(QVariantList platformList READ platformList NOTIFY configChanged)
+    Q_PROPERTY(QVariantList platformList READ platformList NOTIFY helloChanged)
 
     // Render properties
-    Q_PROPERTY(int renderScreen READ renderScreen NOTIFY configChanged)
-    Q_PROPERTY(int renderWidth READ renderWidth NOTIFY configChanged)
-    Q_PROPERTY(int renderHeight READ renderHeight NOTIFY configChanged)
-    Q_PROPERTY(int renderRotate READ renderRotate NOTIFY configChanged)
-    Q_PROPERTY(int renderMouse READ renderMouse NOTIFY configChanged)
-    Q_PROPERTY(QString mousePoint READ mousePoint NOTIFY configChanged)
-    Q_PROPERTY(QString mouseHover READ mouseHover NOTIFY configChanged)
-    Q_PROPERTY(QString mouseField READ mouseField NOTIFY configChanged)
-    Q_PROPERTY(QString mouseDelay READ mouseDelay NOTIFY configChanged)
+    Q_PROPERTY(int renderScreen READ renderScreen NOTIFY liveChanged)
+    Q_PROPERTY(int renderWidth READ renderWidth NOTIFY liveChanged)
+    Q_PROPERTY(int renderHeight READ renderHeight NOTIFY liveChanged)
+    Q_PROPERTY(int renderRotate READ renderRotate NOTIFY liveChanged)
+    Q_PROPERTY(QString renderRotateMode READ renderRotateMode NOTIFY liveChanged)
+    Q_PROPERTY(int renderMouse READ renderMouse NOTIFY liveChanged)
+    Q_PROPERTY(int metricsPort READ metricsPort NOTIFY liveChanged)
+    Q_PROPERTY(QString metricsSocket READ metricsSocket NOTIFY liveChanged)
+    Q_PROPERTY(int buttonOutlierMs READ buttonOutlierMs NOTIFY liveChanged)
+    Q_PROPERTY(bool renderStats READ renderStats NOTIFY liveChanged)
+    Q_PROPERTY(bool qualityGovernor READ qualityGovernor NOTIFY liveChanged)
+    Q_PROPERTY(QString qualityThermalZone READ qualityThermalZone NOTIFY liveChanged)
+    Q_PROPERTY(int qualityTempHigh READ qualityTempHigh NOTIFY liveChanged)
+    Q_PROPERTY(int qualityTempLow READ qualityTempLow NOTIFY liveChanged)
+    Q_PROPERTY(QString stateSnapshot READ stateSnapshot NOTIFY liveChanged)
+    Q_PROPERTY(QString renderBackend READ renderBackend NOTIFY liveChanged)
+    Q_PROPERTY(QString renderPipelineCache READ renderPipelineCache NOTIFY liveChanged)
+    Q_PROPERTY(QString renderGlyphCache READ renderGlyphCache NOTIFY liveChanged)
+    Q_PROPERTY(QString logOutput READ logOutput NOTIFY liveChanged)
+    Q_PROPERTY(QString logRules READ logRules NOTIFY liveChanged)
+    Q_PROPERTY(int logRateLimit READ logRateLimit NOTIFY liveChanged)
+    Q_PROPERTY(QString frameSnapshot READ frameSnapshot NOTIFY liveChanged)
+    Q_PROPERTY(int frameSnapshotInterval READ frameSnapshotInterval NOTIFY liveChanged)
+    Q_PROPERTY(int frameSnapshotWidth READ frameSnapshotWidth NOTIFY liveChanged)
+    Q_PROPERTY(int stateSnapshotInterval READ stateSnapshotInterval NOTIFY liveChanged)
+    Q_PROPERTY(int stateSnapshotMaxAge READ stateSnapshotMaxAge NOTIFY liveChanged)
+    Q_PROPERTY(QString mousePoint READ mousePoint NOTIFY liveChanged)
+    Q_PROPERTY(QString mouseHover READ mouseHover NOTIFY liveChanged)
+    Q_PROPERTY(QString mouseField READ mouseField NOTIFY liveChanged)
+    Q_PROPERTY(QString mouseDelay READ mouseDelay NOTIFY liveChanged)
+
+    // Output windows: screen 0 is [app_live] (main.qml), 1..3 are [app_screen_N]
+    Q_PROPERTY(ScreenConfig *primaryScreen READ primaryScreen CONSTANT)
 
     // App Live properties - Layer system (layer_0 is front-most)
-    Q_PROPERTY(QString layer0 READ layer0 NOTIFY configChanged)
-    Q_PROPERTY(QString layer1 READ layer1 NOTIFY configChanged)
-    Q_PROPERTY(QString layer2 READ layer2 NOTIFY configChanged)
-    Q_PROPERTY(QString layer3 READ layer3 NOTIFY configChanged)
-    Q_PROPERTY(QString layer4 READ layer4 NOTIFY configChanged)
-    Q_PROPERTY(QString layer5 READ layer5 NOTIFY configChanged)
-    Q_PROPERTY(QString layer6 READ layer6 NOTIFY configChanged)
-    Q_PROPERTY(QString layer7 READ layer7 NOTIFY configChanged)
-    Q_PROPERTY(QString layer8 READ layer8 NOTIFY configChanged)
-    Q_PROPERTY(QString layer9 READ layer9 NOTIFY configChanged)
+    Q_PROPERTY(QString layer0 READ layer0 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer1 READ layer1 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer2 READ layer2 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer3 READ layer3 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer4 READ layer4 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer5 READ layer5 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer6 READ layer6 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer7 READ layer7 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer8 READ layer8 NOTIFY liveChanged)
+    Q_PROPERTY(QString layer9 READ layer9 NOTIFY liveChanged)
 
     // Layer transition times (opacity fade duration in milliseconds)
-    Q_PROPERTY(int layerTransition0 READ layerTransition0 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition1 READ layerTransition1 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition2 READ layerTransition2 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition3 READ layerTransition3 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition4 READ layerTransition4 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition5 READ layerTransition5 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition6 READ layerTransition6 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition7 READ layerTransition7 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition8 READ layerTransition8 NOTIFY configChanged)
-    Q_PROPERTY(int layerTransition9 READ layerTransition9 NOTIFY configChanged)
+    Q_PROPERTY(int layerTransition0 READ layerTransition0 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition1 READ layerTransition1 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition2 READ layerTransition2 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition3 READ layerTransition3 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition4 READ layerTransition4 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition5 READ layerTransition5 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition6 READ layerTransition6 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition7 READ layerTransition7 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition8 READ layerTransition8 NOTIFY liveChanged)
+    Q_PROPERTY(int layerTransition9 READ layerTransition9 NOTIFY liveChanged)
 
     // App Timer Properties
-    Q_PROPERTY(bool timerState READ timerState NOTIFY configChanged)
-    Q_PROPERTY(bool timerCount READ timerCount NOTIFY configChanged)
-    Q_PROPERTY(int timerMax READ timerMax NOTIFY configChanged)
-    Q_PROPERTY(QString timerText READ timerText NOTIFY configChanged)
-    Q_PROPERTY(QString timerMenuLeft READ timerMenuLeft NOTIFY configChanged)
-    Q_PROPERTY(QString timerMenuMiddle READ timerMenuMiddle NOTIFY configChanged)
-    Q_PROPERTY(QString timerMenuRight READ timerMenuRight NOTIFY configChanged)
-    Q_PROPERTY(QString timerAlert READ timerAlert NOTIFY configChanged)
-    Q_PROPERTY(QString timerReset READ timerReset NOTIFY configChanged)
+    Q_PROPERTY(bool timerState READ timerState NOTIFY timerChanged)
+    Q_PROPERTY(bool timerCount READ timerCount NOTIFY timerChanged)
+    Q_PROPERTY(int timerMax READ timerMax NOTIFY timerChanged)
+    Q_PROPERTY(QString timerText READ timerText NOTIFY timerChanged)
+    Q_PROPERTY(QString timerMenuLeft READ timerMenuLeft NOTIFY timerChanged)
+    Q_PROPERTY(QString timerMenuMiddle READ timerMenuMiddle NOTIFY timerChanged)
+    Q_PROPERTY(QString timerMenuRight READ timerMenuRight NOTIFY timerChanged)
+    Q_PROPERTY(QString timerAlert READ timerAlert NOTIFY timerChanged)
+    Q_PROPERTY(QString timerReset READ timerReset NOTIFY timerChanged)
 
     // App Image Properties
-    Q_PROPERTY(QString imageSource READ imageSource NOTIFY configChanged)
-    Q_PROPERTY(QString imageBgColor READ imageBgColor NOTIFY configChanged)
-    Q_PROPERTY(int imageFillMode READ imageFillMode NOTIFY configChanged)
-    Q_PROPERTY(bool imageShowBg READ imageShowBg NOTIFY configChanged)
+    Q_PROPERTY(QString imageSource READ imageSource NOTIFY imageChanged)
+    Q_PROPERTY(QString imageBgColor READ imageBgColor NOTIFY imageChanged)
+    Q_PROPERTY(int imageFillMode READ imageFillMode NOTIFY imageChanged)
+    Q_PROPERTY(bool imageShowBg READ imageShowBg NOTIFY imageChanged)
+    Q_PROPERTY(QString imagePlaylist READ imagePlaylist NOTIFY imageChanged)
+    Q_PROPERTY(int imageDuration READ imageDuration NOTIFY imageChanged)
+    Q_PROPERTY(int imagePreload READ imagePreload NOTIFY imageChanged)
 
     // App Alert Properties
-    Q_PROPERTY(bool alertState READ alertState NOTIFY configChanged)
-    Q_PROPERTY(QString alertText READ alertText NOTIFY configChanged)
-    Q_PROPERTY(QString alertMenuLeft READ alertMenuLeft NOTIFY configChanged)
-    Q_PROPERTY(QString alertMenuMiddle READ alertMenuMiddle NOTIFY configChanged)
-    Q_PROPERTY(QString alertMenuRight READ alertMenuRight NOTIFY configChanged)
-    Q_PROPERTY(QString buttonDir READ buttonDir NOTIFY configChanged)
+    Q_PROPERTY(bool alertState READ alertState NOTIFY alertChanged)
+    Q_PROPERTY(QString alertText READ alertText NOTIFY alertChanged)
+    Q_PROPERTY(QString alertMenuLeft READ alertMenuLeft NOTIFY alertChanged)
+    Q_PROPERTY(QString alertMenuMiddle READ alertMenuMiddle NOTIFY alertChanged)
+    Q_PROPERTY(QString alertMenuRight READ alertMenuRight NOTIFY alertChanged)
+    Q_PROPERTY(QString buttonDir READ buttonDir NOTIFY alertChanged)
+
+    // App Video Properties
+    Q_PROPERTY(QString videoSource READ videoSource NOTIFY videoChanged)
+    Q_PROPERTY(QString videoBgColor READ videoBgColor NOTIFY videoChanged)
+    Q_PROPERTY(int videoFillMode READ videoFillMode NOTIFY videoChanged)
+    Q_PROPERTY(bool videoLoop READ videoLoop NOTIFY videoChanged)
+    Q_PROPERTY(bool videoMuted READ videoMuted NOTIFY videoChanged)
 
     // App Blank Properties
-    Q_PROPERTY(bool blankState READ blankState NOTIFY configChanged)
-    Q_PROPERTY(int blankFade READ blankFade NOTIFY configChanged)
+    Q_PROPERTY(bool blankState READ blankState NOTIFY blankChanged)
+    Q_PROPERTY(int blankFade READ blankFade NOTIFY blankChanged)
 
 public:
     explicit ConfigManager(QObject *parent = nullptr);
     ~ConfigManager();
 
+    // Base config: the static INI with every default
     void setConfigPath(const QString &path);
+
+    // Overlays are merged on top of the base config in order, later overlays win.
+    // [app_live] live_config in the base config names overlays too (one path or a
+    // comma separated list); those rank below overlays added here.
+    void addOverlayPath(const QString &path);
+    QStringList overlayPaths() const;
+
+    // Resolve overlay paths under this directory instead of "/" (journal replay
+    // sandbox); must be set before setConfigPath()
+    void setPathRoot(const QString &root);
+
+    // Re-parse every source and re-apply every section
     void loadConfig();
 
+    // [app_screen_1] .. [app_screen_N]: extra output windows in this process
+    static const int ExtraScreenCount = 3;
+    ScreenConfig *primaryScreen() const { return m_screens.first(); }
+    QList<ScreenConfig *> screens() const { return m_screens; }
+
     // Getters for App Theme
     QString colorMain() const { return m_colorMain; }
     QString colorBg01() const { return m_colorBg01; }
@@ -148,7 +204,28 @@ public:
     int renderWidth() const { return m_renderWidth; }
     int renderHeight() const { return m_renderHeight; }
     int renderRotate() const { return m_renderRotate; }
+    QString renderRotateMode() const { return m_renderRotateMode; }
     int renderMouse() const { return m_renderMouse; }
+    int metricsPort() const { return m_metricsPort; }
+    QString metricsSocket() const { return m_metricsSocket; }
+    int buttonOutlierMs() const { return m_buttonOutlierMs; }
+    bool renderStats() const { return m_renderStats; }
+    bool qualityGovernor() const { return m_qualityGovernor; }
+    QString qualityThermalZone() const { return m_qualityThermalZone; }
+    int qualityTempHigh() const { return m_qualityTempHigh; }
+    int qualityTempLow() const { return m_qualityTempLow; }
+    QString stateSnapshot() const { return m_stateSnapshot; }
+    QString renderBackend() const { return m_renderBackend; }
+    QString renderPipelineCache() const { return m_renderPipelineCache; }
+    QString renderGlyphCache() const { return m_renderGlyphCache; }
+    QString logOutput() const { return m_logOutput; }
+    QString logRules() const { return m_logRules; }
+    int logRateLimit() const { return m_logRateLimit; }
+    QString frameSnapshot() const { return m_frameSnapshot; }
+    int frameSnapshotInterval() const { return m_frameSnapshotInterval; }
+    int frameSnapshotWidth() const { return m_frameSnapshotWidth; }
+    int stateSnapshotInterval() const { return m_stateSnapshotInterval; }
+    int stateSnapshotMaxAge() const { return m_stateSnapshotMaxAge; }
     QString mousePoint() const { return m_mousePoint; }
     QString mouseHover() const { return m_mouseHover; }
     QString mouseField() const { return m_mouseField; }
@@ -166,6 +243,9 @@ public:
     QString layer8() const { return m_layer8; }
     QString layer9() const { return m_layer9; }
 
+    // Distinct apps configured on any layer (regardless of their state flag)
+    QStringList layerApps() const;
+
     // Getters for layer transitions
     int layerTransition0() const { return m_layerTransition0; }
     int layerTransition1() const { return m_layerTransition1; }
@@ -194,6 +274,9 @@ public:
     QString imageBgColor() const { return m_imageBgColor; }
     int imageFillMode() const { return m_imageFillMode; }
     bool imageShowBg() const { return m_imageShowBg; }
+    QString imagePlaylist() const { return m_imagePlaylist; }
+    int imageDuration() const { return m_imageDuration; }
+    int imagePreload() const { return m_imagePreload; }
 
     // Getters for alert app
     bool alertState() const { return m_alertState; }
@@ -207,19 +290,83 @@ public:
     bool blankState() const { return m_blankState; }
     int blankFade() const { return m_blankFade; }
 
+    // Getters for video app
+    QString videoSource() const { return m_videoSource; }
+    QString videoBgColor() const { return m_videoBgColor; }
+    int videoFillMode() const { return m_videoFillMode; }
+    bool videoLoop() const { return m_videoLoop; }
+    bool videoMuted() const { return m_videoMuted; }
+
 signals:
+    // Emitted after any change, once per reload
     void configChanged();
 
+    // Emitted only for the sections whose effective keys changed
+    void themeChanged();
+    void helloChanged();
+    void liveChanged();
+    void timerChanged();
+    void imageChanged();
+    void alertChanged();
+    void blankChanged();
+    void videoChanged();
+    void screensChanged();
+
+    // Emitted before configChanged(), only when the set of layer apps differs
+    void layerAppsChanged(const QStringList &apps);
+
+    // Instrumentation hooks (event journal): raw watcher notifications and the
+    // keys a source file changed (all of its keys on a full load)
+    void fileEventReceived(const QString &path);
+    void sourceReloaded(const QString &path, const QVariantMap &changes);
+
 private slots:
     void onFileChanged(const QString &path);
+    void onDirectoryChanged(const QString &path);
 
 private:
+    friend class MicroBench;  // bench/microbench.cpp times the private loaders
+
+    // One INI file contributing keys ("group/key") to the merged config
+    struct ConfigSource {
+        QString path;
+        bool fromLiveConfig = false;  // Listed by [app_live] live_config
+        bool exists = false;
+        qint64 size = -1;
+        QDateTime modified;
+        QHash<QString, QVariant> values;
+    };
+
     QString parseHexColor(const QString &value);
     void parsePlatformList();
 
+    static QHash<QString, QVariant> parseConfigFile(const QString &path);
+    QVariant value(const QString &group, const QString &key, const QVariant &defaultValue) const;
+    QStringList liveConfigOverlays() const;
+    void rebuildSources();
+    void reloadSource(int index);
+    void refreshSourceState(ConfigSource &source);
+    void updateWatches();
+    int sourceIndex(const QString &path) const;
+    QVariant effectiveValue(const QString &key) const;
+    void applySections(const QSet<QString> &groups);
+
+    void applyTheme();
+    void applyHello();
+    void applyLive();
+    void applyTimer();
+    void applyImage();
+    void applyAlert();
+    void applyBlank();
+    void applyVideo();
+    void applyScreen(int index);
+
     QString m_configPath;
     QFileSystemWatcher *m_fileWatcher;
-    QSettings *m_settings;
+    QList<ConfigSource> m_sources;       // [0] is the base config, then overlays by precedence
+    QStringList m_extraOverlays;         // Added with addOverlayPath()
+    QString m_pathRoot;
+    QHash<QString, QVariant> m_values;   // Effective merged values
 
     // App Theme members
     QString m_colorMain;
@@ -256,7 +403,28 @@ private:
     int m_renderWidth;
     int m_renderHeight;
     int m_renderRotate;
+    QString m_renderRotateMode;
     int m_renderMouse;
+    int m_metricsPort;
+    QString m_metricsSocket;
+    int m_buttonOutlierMs;
+    bool m_renderStats;
+    bool m_qualityGovernor;
+    QString m_qualityThermalZone;
+    int m_qualityTempHigh;
+    int m_qualityTempLow;
+    QString m_stateSnapshot;
+    QString m_renderBackend;
+    QString m_renderPipelineCache;
+    QString m_renderGlyphCache;
+    QString m_logOutput;
+    QString m_logRules;
+    int m_logRateLimit;
+    QString m_frameSnapshot;
+    int m_frameSnapshotInterval;
+    int m_frameSnapshotWidth;
+    int m_stateSnapshotInterval;
+    int m_stateSnapshotMaxAge;
     QString m_mousePoint;
     QString m_mouseHover;
     QString m_mouseField;
@@ -273,6 +441,8 @@ private:
     QString m_layer7;
     QString m_layer8;
     QString m_layer9;
+    QStringList m_layerApps;
+    QList<ScreenConfig *> m_screens;
 
     // Layer transition times (in milliseconds)
     int m_layerTransition0;
@@ -302,6 +472,9 @@ private:
     QString m_imageBgColor;
     int m_imageFillMode;  // Qt::AspectRatioMode enum value
     bool m_imageShowBg;
+    QString m_imagePlaylist;
+    int m_imageDuration;
+    int m_imagePreload;
 
     // App Alert properties
     bool m_alertState;
@@ -314,6 +487,13 @@ private:
     // App Blank properties
     bool m_blankState;
     int m_blankFade;
+
+    // App Video properties
+    QString m_videoSource;
+    QString m_videoBgColor;
+    int m_videoFillMode;
+    bool m_videoLoop;
+    bool m_videoMuted;
 };
 
 #endif // CONFIGMANAGER_H
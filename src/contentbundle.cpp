@@ -0,0 +1,260 @@
+#include "contentbundle.h"
+#include <QSaveFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonParseError>
+#include <QtEndian>
+
+namespace {
+
+const int IndexEntryFixedSize = 4 * 8 + 2;
+
+qint64 aligned(qint64 offset)
+{
+    const qint64 alignment = ContentBundle::PayloadAlignment;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+void appendLE32(QByteArray &out, quint32 value)
+{
+    uchar bytes[4];
+    qToLittleEndian(value, bytes);
+    out.append(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+void appendLE64(QByteArray &out, quint64 value)
+{
+    uchar bytes[8];
+    qToLittleEndian(value, bytes);
+    out.append(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+} // namespace
+
+ContentBundle::~ContentBundle()
+{
+    if (m_map) {
+        m_file.unmap(const_cast<uchar *>(m_map));
+    }
+}
+
+QSharedPointer<const ContentBundle> ContentBundle::open(const QString &path, QString *error)
+{
+    QSharedPointer<ContentBundle> bundle(new ContentBundle());
+    if (!bundle->load(path, error)) {
+        return QSharedPointer<const ContentBundle>();
+    }
+    return bundle;
+}
+
+bool ContentBundle::load(const QString &path, QString *error)
+{
+    auto fail = [error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    m_path = path;
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(m_file.errorString());
+    }
+
+    m_size = m_file.size();
+    if (m_size < HeaderSize) {
+        return fail("truncated header");
+    }
+
+    // The mapping stays valid after the path is renamed over, until we unmap it
+    m_map = m_file.map(0, m_size);
+    if (!m_map) {
+        return fail("mmap failed: " + m_file.errorString());
+    }
+
+    const uchar *header = m_map;
+    if (qFromLittleEndian<quint32>(header) != Magic) {
+        return fail("not a content bundle");
+    }
+    if (qFromLittleEndian<quint32>(header + 4) != Version) {
+        return fail(QString("unsupported version %1").arg(qFromLittleEndian<quint32>(header + 4)));
+    }
+    const quint32 count = qFromLittleEndian<quint32>(header + 8);
+    const quint32 indexSize = qFromLittleEndian<quint32>(header + 12);
+    if (qint64(qFromLittleEndian<quint64>(header + 16)) != m_size) {
+        return fail("size mismatch (incomplete copy?)");
+    }
+    m_packedMs = qFromLittleEndian<qint64>(header + 24);
+    if (HeaderSize + qint64(indexSize) > m_size) {
+        return fail("truncated index");
+    }
+
+    const uchar *cursor = m_map + HeaderSize;
+    const uchar *indexEnd = cursor + indexSize;
+    auto inFile = [this](qint64 offset, qint64 size) {
+        return offset >= 0 && size >= 0 && offset <= m_size && size <= m_size - offset;
+    };
+
+    m_entries.reserve(count);
+    for (quint32 i = 0; i < count; i++) {
+        if (indexEnd - cursor < IndexEntryFixedSize) {
+            return fail("truncated index");
+        }
+        Entry entry;
+        entry.offset = qint64(qFromLittleEndian<quint64>(cursor));
+        entry.size = qint64(qFromLittleEndian<quint64>(cursor + 8));
+        entry.cborOffset = qint64(qFromLittleEndian<quint64>(cursor + 16));
+        entry.cborSize = qint64(qFromLittleEndian<quint64>(cursor + 24));
+        const quint16 nameLength = qFromLittleEndian<quint16>(cursor + 32);
+        cursor += IndexEntryFixedSize;
+        if (indexEnd - cursor < nameLength) {
+            return fail("truncated index");
+        }
+        const QString name = QString::fromUtf8(reinterpret_cast<const char *>(cursor), nameLength);
+        cursor += nameLength;
+
+        if (!inFile(entry.offset, entry.size) || !inFile(entry.cborOffset, entry.cborSize)) {
+            return fail("entry out of range: " + name);
+        }
+        m_entries.insert(name, entry);
+    }
+
+    return true;
+}
+
+QByteArray ContentBundle::data(const QString &name) const
+{
+    auto it = m_entries.constFind(name);
+    if (it == m_entries.constEnd()) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_map + it->offset), it->size);
+}
+
+QCborValue ContentBundle::cbor(const QString &name) const
+{
+    auto it = m_entries.constFind(name);
+    if (it == m_entries.constEnd() || it->cborSize == 0) {
+        return QCborValue();
+    }
+    return QCborValue::fromCbor(QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_map + it->cborOffset), it->cborSize));
+}
+
+ContentBundle::Item ContentBundle::itemFromFile(const QString &name, const QByteArray &data)
+{
+    Item item;
+    item.name = name;
+    item.data = data;
+
+    // Feeds are streamed from the raw bytes (PlayerFeed), a CBOR copy would only double them
+    if (isStreamedFile(name)) {
+        return item;
+    }
+
+    // facility_colors has no extension, so every file is tried; images fail on the first byte
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error == QJsonParseError::NoError && (doc.isObject() || doc.isArray())) {
+        QCborValue value = doc.isObject() ? QCborValue::fromJsonValue(doc.object())
+                                          : QCborValue::fromJsonValue(doc.array());
+        item.cbor = value.toCbor();
+    }
+    return item;
+}
+
+bool ContentBundle::isStreamedFile(const QString &name)
+{
+    return name == QLatin1String("user_data.json");
+}
+
+bool ContentBundle::write(const QString &path, const QList<Item> &items, QString *error)
+{
+    // Layout first: header, index, then every payload at an aligned offset
+    qint64 indexSize = 0;
+    QList<QByteArray> names;
+    for (const Item &item : items) {
+        QByteArray name = item.name.toUtf8();
+        if (name.size() > 0xffff) {
+            if (error) {
+                *error = "name too long: " + item.name;
+            }
+            return false;
+        }
+        indexSize += IndexEntryFixedSize + name.size();
+        names.append(name);
+    }
+
+    QByteArray index;
+    index.reserve(indexSize);
+    QList<qint64> offsets;
+    qint64 offset = aligned(HeaderSize + indexSize);
+    for (int i = 0; i < items.size(); i++) {
+        const Item &item = items.at(i);
+        qint64 dataOffset = offset;
+        offset = aligned(dataOffset + item.data.size());
+        qint64 cborOffset = item.cbor.isEmpty() ? 0 : offset;
+        if (!item.cbor.isEmpty()) {
+            offset = aligned(cborOffset + item.cbor.size());
+        }
+        offsets << dataOffset << cborOffset;
+
+        appendLE64(index, dataOffset);
+        appendLE64(index, item.data.size());
+        appendLE64(index, cborOffset);
+        appendLE64(index, item.cbor.size());
+        uchar nameLength[2];
+        qToLittleEndian<quint16>(quint16(names.at(i).size()), nameLength);
+        index.append(reinterpret_cast<const char *>(nameLength), sizeof(nameLength));
+        index.append(names.at(i));
+    }
+    const qint64 fileSize = offset;
+
+    QByteArray header;
+    appendLE32(header, Magic);
+    appendLE32(header, Version);
+    appendLE32(header, quint32(items.size()));
+    appendLE32(header, quint32(indexSize));
+    appendLE64(header, quint64(fileSize));
+    appendLE64(header, quint64(QDateTime::currentMSecsSinceEpoch()));
+
+    // Readers only ever see the old or the complete new file
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    qint64 position = 0;
+    auto writeAt = [&file, &position](qint64 at, const QByteArray &bytes) {
+        if (at > position) {
+            file.write(QByteArray(at - position, '\0'));
+            position = at;
+        }
+        file.write(bytes);
+        position += bytes.size();
+    };
+
+    writeAt(0, header);
+    writeAt(HeaderSize, index);
+    for (int i = 0; i < items.size(); i++) {
+        writeAt(offsets.at(2 * i), items.at(i).data);
+        if (!items.at(i).cbor.isEmpty()) {
+            writeAt(offsets.at(2 * i + 1), items.at(i).cbor);
+        }
+    }
+    writeAt(fileSize, QByteArray());
+
+    if (!file.commit()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
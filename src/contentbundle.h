@@ -0,0 +1,85 @@
+#ifndef CONTENTBUNDLE_H
+#define CONTENTBUNDLE_H
+
+#include <QByteArray>
+#include <QCborValue>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+// Single-file content bundle: the welcome-data files in one indexed archive.
+//
+// The file is mapped read-only and entries are served straight from the
+// mapping (QByteArray::fromRawData), nothing is copied until a value is built
+// from it. JSON files are stored a second time as CBOR so readers skip the
+// text parser. Bundles are replaced by rename (gladis-pack writes through
+// QSaveFile), an open bundle keeps its mapping of the old file until released.
+//
+// File format (little endian):
+//   header   quint32 magic "GLBN", quint32 version, quint32 entry count,
+//            quint32 index size, quint64 file size, qint64 packed (ms since epoch)
+//   index    per entry: quint64 offset, quint64 size, quint64 CBOR offset,
+//            quint64 CBOR size (0 = none), quint16 name length, UTF-8 name
+//   payload  entries and CBOR blobs, each aligned to PayloadAlignment
+class ContentBundle
+{
+public:
+    static const quint32 Magic = 0x474c424e;   // "GLBN"
+    static const quint32 Version = 1;
+    static const int HeaderSize = 32;
+    static const int PayloadAlignment = 16;
+
+    struct Item {
+        QString name;
+        QByteArray data;
+        QByteArray cbor;   // Pre-parsed JSON, empty for other files
+    };
+
+    ~ContentBundle();
+
+    // Null with *error set if the file is missing, truncated or not a bundle
+    static QSharedPointer<const ContentBundle> open(const QString &path, QString *error = nullptr);
+
+    // Writes atomically (temporary file + rename)
+    static bool write(const QString &path, const QList<Item> &items, QString *error = nullptr);
+
+    // Bundle item for a file of a data directory: JSON objects/arrays also get a
+    // CBOR copy, except for the feeds DataManager streams (isStreamedFile)
+    static Item itemFromFile(const QString &name, const QByteArray &data);
+    static bool isStreamedFile(const QString &name);
+
+    QString path() const { return m_path; }
+    qint64 size() const { return m_size; }
+    qint64 packedMs() const { return m_packedMs; }
+    QStringList names() const { return m_entries.keys(); }
+
+    bool contains(const QString &name) const { return m_entries.contains(name); }
+
+    // Raw bytes, valid as long as the bundle is alive (no copy)
+    QByteArray data(const QString &name) const;
+    // Pre-parsed JSON, invalid if the entry has none
+    QCborValue cbor(const QString &name) const;
+
+private:
+    struct Entry {
+        qint64 offset = 0;
+        qint64 size = 0;
+        qint64 cborOffset = 0;
+        qint64 cborSize = 0;
+    };
+
+    ContentBundle() = default;
+    bool load(const QString &path, QString *error);
+
+    QString m_path;
+    QFile m_file;
+    const uchar *m_map = nullptr;
+    qint64 m_size = 0;
+    qint64 m_packedMs = 0;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // CONTENTBUNDLE_H
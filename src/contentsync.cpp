@@ -0,0 +1,663 @@
+#include "contentsync.h"
+#include "contentbundle.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QtEndian>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const int HashSize = 32;                          // SHA-256
+const quint32 MaxFrameSize = 64 * 1024 * 1024;    // Far above one chunk
+const int ProcessTimeoutMs = 60000;
+
+// Wire format, both directions: quint8 op/status, quint32 length (LE), payload
+enum Op : char {
+    MissingOp = 'M',   // payload: hashes -> reply: missing hashes
+    PutOp = 'P',       // payload: hash + chunk data
+    PublishOp = 'U'    // payload: manifest JSON
+};
+
+QByteArray chunkHash(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+QByteArray frame(char op, const QByteArray &payload)
+{
+    QByteArray out;
+    out.reserve(5 + payload.size());
+    out.append(op);
+    uchar length[4];
+    qToLittleEndian<quint32>(quint32(payload.size()), length);
+    out.append(reinterpret_cast<const char *>(length), sizeof(length));
+    out.append(payload);
+    return out;
+}
+
+QList<QByteArray> splitHashes(const QByteArray &payload)
+{
+    QList<QByteArray> hashes;
+    for (int i = 0; i + HashSize <= payload.size(); i += HashSize) {
+        hashes.append(payload.mid(i, HashSize));
+    }
+    return hashes;
+}
+
+bool readAll(int fd, char *data, qint64 size)
+{
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool writeAll(int fd, const QByteArray &bytes)
+{
+    const char *data = bytes.constData();
+    qint64 size = bytes.size();
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Replaces an existing file (QFile::rename does not)
+bool replaceFile(const QString &from, const QString &to)
+{
+    return ::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+}
+
+bool linkFile(const QString &from, const QString &to)
+{
+    return ::link(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+}
+
+// Swaps two paths in one step where the kernel can (Linux 3.15+), otherwise
+// moves the old one out of the way first
+bool exchangePaths(const QString &from, const QString &to)
+{
+    const QByteArray fromName = QFile::encodeName(from);
+    const QByteArray toName = QFile::encodeName(to);
+#ifdef RENAME_EXCHANGE
+    if (::renameat2(AT_FDCWD, fromName.constData(), AT_FDCWD, toName.constData(), RENAME_EXCHANGE) == 0) {
+        return true;
+    }
+#endif
+    const QByteArray aside = toName + ".old";
+    if (::rename(toName.constData(), aside.constData()) != 0) {
+        return false;
+    }
+    if (::rename(fromName.constData(), toName.constData()) != 0) {
+        ::rename(aside.constData(), toName.constData());
+        return false;
+    }
+    return ::rename(aside.constData(), fromName.constData()) == 0;
+}
+
+} // namespace
+
+// ===== Manifest =====
+
+bool SyncManifest::fromDirectory(const QString &path, SyncManifest *manifest, QString *error, int chunkSize)
+{
+    QDir directory(path);
+    if (!directory.exists()) {
+        *error = "no such directory: " + path;
+        return false;
+    }
+
+    manifest->chunkSize = chunkSize;
+    manifest->files.clear();
+    const QStringList fileNames = directory.entryList(QDir::Files | QDir::Readable, QDir::Name);
+    for (const QString &fileName : fileNames) {
+        QFile file(directory.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) {
+            *error = "cannot read " + file.fileName() + ": " + file.errorString();
+            return false;
+        }
+
+        File entry;
+        entry.name = fileName;
+        entry.size = file.size();
+        while (!file.atEnd()) {
+            entry.chunks.append(chunkHash(file.read(chunkSize)));
+        }
+        manifest->files.append(entry);
+    }
+    return true;
+}
+
+bool SyncManifest::fromJson(const QByteArray &json, SyncManifest *manifest, QString *error)
+{
+    QJsonParseError parseError;
+    QJsonObject root = QJsonDocument::fromJson(json, &parseError).object();
+    if (parseError.error != QJsonParseError::NoError) {
+        *error = "manifest: " + parseError.errorString();
+        return false;
+    }
+    if (root.value("version").toInt() != Version) {
+        *error = QString("manifest: unsupported version %1").arg(root.value("version").toInt());
+        return false;
+    }
+
+    manifest->chunkSize = root.value("chunkSize").toInt(DefaultChunkSize);
+    manifest->files.clear();
+    const QJsonArray files = root.value("files").toArray();
+    for (const QJsonValue &value : files) {
+        QJsonObject object = value.toObject();
+        File file;
+        file.name = object.value("name").toString();
+        file.size = qint64(object.value("size").toDouble());
+
+        // Flat directory: no separators, nothing outside the target
+        if (file.name.isEmpty() || file.name.contains('/') || file.name.startsWith('.')) {
+            *error = "manifest: invalid file name " + file.name;
+            return false;
+        }
+        const QJsonArray chunks = object.value("chunks").toArray();
+        for (const QJsonValue &chunk : chunks) {
+            QByteArray hash = QByteArray::fromHex(chunk.toString().toLatin1());
+            if (hash.size() != HashSize) {
+                *error = "manifest: invalid chunk hash in " + file.name;
+                return false;
+            }
+            file.chunks.append(hash);
+        }
+        manifest->files.append(file);
+    }
+    return true;
+}
+
+QByteArray SyncManifest::toJson() const
+{
+    QJsonArray fileArray;
+    for (const File &file : files) {
+        QJsonArray chunkArray;
+        for (const QByteArray &chunk : file.chunks) {
+            chunkArray.append(QString::fromLatin1(chunk.toHex()));
+        }
+        fileArray.append(QJsonObject {
+            { "name", file.name },
+            { "size", double(file.size) },
+            { "chunks", chunkArray }
+        });
+    }
+
+    QJsonObject root {
+        { "version", Version },
+        { "chunkSize", chunkSize },
+        { "files", fileArray }
+    };
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QList<QByteArray> SyncManifest::uniqueChunks() const
+{
+    QList<QByteArray> chunks;
+    QSet<QByteArray> seen;
+    for (const File &file : files) {
+        for (const QByteArray &chunk : file.chunks) {
+            if (!seen.contains(chunk)) {
+                seen.insert(chunk);
+                chunks.append(chunk);
+            }
+        }
+    }
+    return chunks;
+}
+
+qint64 SyncManifest::totalSize() const
+{
+    qint64 size = 0;
+    for (const File &file : files) {
+        size += file.size;
+    }
+    return size;
+}
+
+// ===== Receiver =====
+
+ContentReceiver::ContentReceiver(const QString &target)
+    : m_target(QDir::cleanPath(target))
+    , m_stateDir(m_target + ".sync")
+{
+    QDir().mkpath(m_stateDir + "/chunks");
+}
+
+QString ContentReceiver::chunkPath(const QByteArray &hash) const
+{
+    return m_stateDir + "/chunks/" + QString::fromLatin1(hash.toHex());
+}
+
+QList<QByteArray> ContentReceiver::missingChunks(const QList<QByteArray> &hashes) const
+{
+    QList<QByteArray> missing;
+    for (const QByteArray &hash : hashes) {
+        if (!QFile::exists(chunkPath(hash))) {
+            missing.append(hash);
+        }
+    }
+    return missing;
+}
+
+bool ContentReceiver::putChunk(const QByteArray &hash, const QByteArray &data, QString *error)
+{
+    if (chunkHash(data) != hash) {
+        *error = "chunk " + QString::fromLatin1(hash.toHex()) + " does not match its hash";
+        return false;
+    }
+
+    QSaveFile file(chunkPath(hash));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        *error = "cannot store chunk: " + file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ContentReceiver::assemble(const SyncManifest::File &file, QByteArray *data, QString *error) const
+{
+    data->clear();
+    data->reserve(file.size);
+    for (const QByteArray &hash : file.chunks) {
+        QFile chunk(chunkPath(hash));
+        if (!chunk.open(QIODevice::ReadOnly)) {
+            *error = "missing chunk " + QString::fromLatin1(hash.toHex()) + " of " + file.name;
+            return false;
+        }
+        data->append(chunk.readAll());
+    }
+    if (data->size() != file.size) {
+        *error = "size mismatch assembling " + file.name;
+        return false;
+    }
+    return true;
+}
+
+bool ContentReceiver::publish(const SyncManifest &manifest, QString *error)
+{
+    // Same content as last time: nothing to swap, no reload on the kiosk
+    const QByteArray json = manifest.toJson();
+    QFile last(m_stateDir + "/manifest.json");
+    bool targetExists = QFileInfo::exists(m_target);
+    if (targetExists && last.open(QIODevice::ReadOnly) && last.readAll() == json) {
+        return true;
+    }
+    last.close();
+
+    if (m_target.endsWith(".bundle")) {
+        QList<ContentBundle::Item> items;
+        for (const SyncManifest::File &file : manifest.files) {
+            QByteArray data;
+            if (!assemble(file, &data, error)) {
+                return false;
+            }
+            items.append(ContentBundle::itemFromFile(file.name, data));
+        }
+        if (!ContentBundle::write(m_target, items, error)) {
+            return false;
+        }
+    } else if (!publishDirectory(manifest, error)) {
+        return false;
+    }
+
+    QSaveFile manifestFile(m_stateDir + "/manifest.json");
+    if (manifestFile.open(QIODevice::WriteOnly)) {
+        manifestFile.write(json);
+        manifestFile.commit();
+    }
+    collectGarbage(manifest);
+    return true;
+}
+
+bool ContentReceiver::publishDirectory(const SyncManifest &manifest, QString *error)
+{
+    // Every version is a complete directory under <target>.sync and the target
+    // a symlink to the live one, so readers see the old set or the new one
+    QFileInfo targetInfo(m_target);
+    const QString live = targetInfo.isSymLink() ? targetInfo.symLinkTarget()
+                                                : (targetInfo.isDir() ? m_target : QString());
+
+    qint64 stamp = QDateTime::currentMSecsSinceEpoch();
+    while (QFileInfo::exists(m_stateDir + "/data-" + QString::number(stamp))) {
+        stamp++;
+    }
+    const QString versionName = "data-" + QString::number(stamp);
+    const QString version = m_stateDir + "/" + versionName;
+    if (!QDir().mkpath(version)) {
+        *error = "cannot create " + version;
+        return false;
+    }
+
+    SyncManifest previous;
+    QFile last(m_stateDir + "/manifest.json");
+    if (last.open(QIODevice::ReadOnly)) {
+        QString ignored;
+        SyncManifest::fromJson(last.readAll(), &previous, &ignored);
+    }
+    QHash<QString, QList<QByteArray>> previousChunks;
+    for (const SyncManifest::File &file : previous.files) {
+        previousChunks.insert(file.name, file.chunks);
+    }
+
+    QSet<QString> names;
+    for (const SyncManifest::File &file : manifest.files) {
+        names.insert(file.name);
+        // Unchanged files are hard links to the live version, not copies
+        if (!live.isEmpty() && previousChunks.value(file.name) == file.chunks
+                && linkFile(live + "/" + file.name, version + "/" + file.name)) {
+            continue;
+        }
+        QByteArray data;
+        if (!assemble(file, &data, error)) {
+            QDir(version).removeRecursively();
+            return false;
+        }
+        QFile staged(version + "/" + file.name);
+        if (!staged.open(QIODevice::WriteOnly) || staged.write(data) != data.size() || !staged.flush()) {
+            *error = "cannot stage " + file.name + ": " + staged.errorString();
+            QDir(version).removeRecursively();
+            return false;
+        }
+    }
+
+    // Files this receiver did not publish (copied in by hand) stay
+    if (!live.isEmpty()) {
+        const QStringList liveNames = QDir(live).entryList(QDir::Files);
+        for (const QString &name : liveNames) {
+            if (!names.contains(name) && !previousChunks.contains(name)) {
+                linkFile(live + "/" + name, version + "/" + name);
+            }
+        }
+    }
+
+    // A new link renamed over the old one swaps the whole set at once
+    const QString link = m_target + ".new";
+    QFile::remove(link);
+    const QString linkTarget = targetInfo.fileName() + ".sync/" + versionName;
+    if (::symlink(QFile::encodeName(linkTarget).constData(), QFile::encodeName(link).constData()) != 0) {
+        *error = "cannot create " + link;
+        QDir(version).removeRecursively();
+        return false;
+    }
+
+    if (targetInfo.isSymLink() || !targetInfo.exists()) {
+        if (!replaceFile(link, m_target)) {
+            *error = "cannot replace " + m_target;
+            return false;
+        }
+        // Only versions this receiver made; a link someone pointed elsewhere stays
+        if (!live.isEmpty() && QFileInfo(live).canonicalPath() == QFileInfo(m_stateDir).canonicalFilePath()) {
+            QDir(live).removeRecursively();
+        }
+        return true;
+    }
+
+    // First publish over a plain directory (rsynced before): exchange the two,
+    // then the directory is at <target>.new
+    if (!exchangePaths(link, m_target)) {
+        *error = "cannot replace directory " + m_target;
+        QFile::remove(link);
+        return false;
+    }
+    QDir(link).removeRecursively();
+    return true;
+}
+
+void ContentReceiver::collectGarbage(const SyncManifest &manifest)
+{
+    // The chunks of the published version are what the next sync diffs against
+    QSet<QString> keep;
+    for (const QByteArray &hash : manifest.uniqueChunks()) {
+        keep.insert(QString::fromLatin1(hash.toHex()));
+    }
+
+    QDir chunks(m_stateDir + "/chunks");
+    const QStringList names = chunks.entryList(QDir::Files);
+    for (const QString &name : names) {
+        if (!keep.contains(name)) {
+            chunks.remove(name);
+        }
+    }
+}
+
+int ContentReceiver::serve(int readFd, int writeFd)
+{
+    for (;;) {
+        char header[5];
+        if (!readAll(readFd, header, sizeof(header))) {
+            return 0;   // Sender done
+        }
+        const char op = header[0];
+        const quint32 size = qFromLittleEndian<quint32>(header + 1);
+        if (size > MaxFrameSize) {
+            return 1;
+        }
+        QByteArray payload(int(size), Qt::Uninitialized);
+        if (!readAll(readFd, payload.data(), size)) {
+            return 1;
+        }
+
+        QString error;
+        QByteArray reply;
+        bool ok = true;
+        switch (op) {
+        case MissingOp:
+            for (const QByteArray &hash : missingChunks(splitHashes(payload))) {
+                reply.append(hash);
+            }
+            break;
+        case PutOp:
+            ok = payload.size() >= HashSize && putChunk(payload.left(HashSize), payload.mid(HashSize), &error);
+            break;
+        case PublishOp: {
+            SyncManifest manifest;
+            ok = SyncManifest::fromJson(payload, &manifest, &error) && publish(manifest, &error);
+            break;
+        }
+        default:
+            ok = false;
+            error = QString("unknown request %1").arg(int(op));
+            break;
+        }
+
+        if (!writeAll(writeFd, frame(ok ? 1 : 0, ok ? reply : error.toUtf8()))) {
+            return 1;
+        }
+    }
+}
+
+// ===== Transports =====
+
+LocalTransport::LocalTransport(ContentReceiver *receiver)
+    : m_receiver(receiver)
+{
+}
+
+bool LocalTransport::missingChunks(const QList<QByteArray> &hashes, QList<QByteArray> *missing)
+{
+    *missing = m_receiver->missingChunks(hashes);
+    return true;
+}
+
+bool LocalTransport::putChunk(const QByteArray &hash, const QByteArray &data)
+{
+    m_error.clear();
+    return m_receiver->putChunk(hash, data, &m_error);
+}
+
+bool LocalTransport::publish(const SyncManifest &manifest)
+{
+    m_error.clear();
+    return m_receiver->publish(manifest, &m_error);
+}
+
+ProcessTransport::ProcessTransport(const QString &program, const QStringList &arguments)
+    : m_process(new QProcess())
+{
+    // The receiver's messages (ssh prompts, warnings) go straight to our stderr
+    m_process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    m_process->start(program, arguments);
+    if (!m_process->waitForStarted(ProcessTimeoutMs)) {
+        m_error = "cannot start " + program + ": " + m_process->errorString();
+    }
+}
+
+ProcessTransport::~ProcessTransport()
+{
+    m_process->closeWriteChannel();
+    if (!m_process->waitForFinished(ProcessTimeoutMs)) {
+        m_process->kill();
+        m_process->waitForFinished();
+    }
+    delete m_process;
+}
+
+bool ProcessTransport::readExact(qint64 size, QByteArray *out)
+{
+    out->clear();
+    while (out->size() < size) {
+        if (m_process->bytesAvailable() == 0 && !m_process->waitForReadyRead(ProcessTimeoutMs)) {
+            m_error = "receiver did not answer (" + m_process->errorString() + ")";
+            return false;
+        }
+        out->append(m_process->read(size - out->size()));
+    }
+    return true;
+}
+
+bool ProcessTransport::request(char op, const QByteArray &payload, QByteArray *reply)
+{
+    if (m_process->state() != QProcess::Running) {
+        if (m_error.isEmpty()) {
+            m_error = "receiver exited";
+        }
+        return false;
+    }
+
+    m_process->write(frame(op, payload));
+    while (m_process->bytesToWrite() > 0) {
+        if (!m_process->waitForBytesWritten(ProcessTimeoutMs)) {
+            m_error = "cannot send to receiver (" + m_process->errorString() + ")";
+            return false;
+        }
+    }
+
+    QByteArray header;
+    if (!readExact(5, &header)) {
+        return false;
+    }
+    const quint32 size = qFromLittleEndian<quint32>(header.constData() + 1);
+    if (size > MaxFrameSize || !readExact(size, reply)) {
+        return false;
+    }
+    if (header.at(0) != 1) {
+        m_error = QString::fromUtf8(*reply);
+        return false;
+    }
+    return true;
+}
+
+bool ProcessTransport::missingChunks(const QList<QByteArray> &hashes, QList<QByteArray> *missing)
+{
+    QByteArray reply;
+    if (!request(MissingOp, hashes.join(), &reply)) {
+        return false;
+    }
+    *missing = splitHashes(reply);
+    return true;
+}
+
+bool ProcessTransport::putChunk(const QByteArray &hash, const QByteArray &data)
+{
+    QByteArray reply;
+    return request(PutOp, hash + data, &reply);
+}
+
+bool ProcessTransport::publish(const SyncManifest &manifest)
+{
+    QByteArray reply;
+    return request(PublishOp, manifest.toJson(), &reply);
+}
+
+// ===== Sender =====
+
+bool syncDirectory(const QString &source, SyncTransport *transport, SyncStats *stats, QString *error)
+{
+    SyncManifest manifest;
+    if (!SyncManifest::fromDirectory(source, &manifest, error)) {
+        return false;
+    }
+
+    const QList<QByteArray> chunks = manifest.uniqueChunks();
+    stats->files = manifest.files.size();
+    stats->chunks = chunks.size();
+
+    QList<QByteArray> missing;
+    if (!transport->missingChunks(chunks, &missing)) {
+        *error = transport->errorString();
+        return false;
+    }
+
+    // Where each missing chunk can be read from
+    QHash<QByteArray, QPair<QString, int>> locations;
+    for (const SyncManifest::File &file : manifest.files) {
+        for (int i = 0; i < file.chunks.size(); i++) {
+            if (!locations.contains(file.chunks.at(i))) {
+                locations.insert(file.chunks.at(i), qMakePair(file.name, i));
+            }
+        }
+    }
+
+    QTextStream out(stdout);
+    for (const QByteArray &hash : missing) {
+        const QPair<QString, int> location = locations.value(hash);
+        QFile file(QDir(source).filePath(location.first));
+        if (!file.open(QIODevice::ReadOnly) || !file.seek(qint64(location.second) * manifest.chunkSize)) {
+            *error = "cannot read " + file.fileName();
+            return false;
+        }
+        QByteArray data = file.read(manifest.chunkSize);
+        if (chunkHash(data) != hash) {
+            *error = location.first + " changed while syncing, run again";
+            return false;
+        }
+        if (!transport->putChunk(hash, data)) {
+            *error = transport->errorString();
+            return false;
+        }
+        stats->chunksSent++;
+        stats->bytesSent += data.size();
+        out << "  " << location.first << " chunk " << location.second << " (" << data.size() << " bytes)" << Qt::endl;
+    }
+
+    if (!transport->publish(manifest)) {
+        *error = transport->errorString();
+        return false;
+    }
+    return true;
+}
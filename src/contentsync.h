@@ -0,0 +1,132 @@
+#ifndef CONTENTSYNC_H
+#define CONTENTSYNC_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QProcess;
+
+// Content-addressed sync of a data directory to a kiosk (gladis-sync).
+//
+// The sender describes the directory as a manifest: every file split into
+// fixed-size chunks named by their SHA-256. The receiver keeps the chunks of
+// the last published version next to the target (<target>.sync/chunks), so
+// only chunks it does not have travel. Once all chunks are there, publish()
+// assembles the files and swaps them in:
+//   <name>.bundle   one ContentBundle renamed into place, so DataManager sees
+//                   the whole update at once (recommended)
+//   directory       a complete copy under <target>.sync (unchanged files
+//                   hard-linked), then the <target> symlink is renamed over
+//                   to point at it, so the set changes at once as well
+//
+// The transport is an interface: LocalTransport calls a receiver in the same
+// process (tests, local staging), ProcessTransport talks to
+// "gladis-sync --receive <target>" over a pipe, e.g. through ssh.
+
+struct SyncManifest
+{
+    static const int Version = 1;
+    static const int DefaultChunkSize = 256 * 1024;
+
+    struct File {
+        QString name;
+        qint64 size = 0;
+        QList<QByteArray> chunks;   // SHA-256, raw bytes
+    };
+
+    int chunkSize = DefaultChunkSize;
+    QList<File> files;
+
+    // Flat like the data directory; hidden files are skipped
+    static bool fromDirectory(const QString &path, SyncManifest *manifest, QString *error,
+                              int chunkSize = DefaultChunkSize);
+    static bool fromJson(const QByteArray &json, SyncManifest *manifest, QString *error);
+    QByteArray toJson() const;
+
+    // Every chunk once, in file order
+    QList<QByteArray> uniqueChunks() const;
+    qint64 totalSize() const;
+};
+
+class SyncTransport
+{
+public:
+    virtual ~SyncTransport() = default;
+
+    virtual bool missingChunks(const QList<QByteArray> &hashes, QList<QByteArray> *missing) = 0;
+    virtual bool putChunk(const QByteArray &hash, const QByteArray &data) = 0;
+    virtual bool publish(const SyncManifest &manifest) = 0;
+
+    QString errorString() const { return m_error; }
+
+protected:
+    QString m_error;
+};
+
+class ContentReceiver
+{
+public:
+    explicit ContentReceiver(const QString &target);
+
+    QList<QByteArray> missingChunks(const QList<QByteArray> &hashes) const;
+    // Rejects data that does not match its hash
+    bool putChunk(const QByteArray &hash, const QByteArray &data, QString *error);
+    bool publish(const SyncManifest &manifest, QString *error);
+
+    // Serves one sender over a pair of file descriptors until it disconnects
+    int serve(int readFd, int writeFd);
+
+private:
+    QString chunkPath(const QByteArray &hash) const;
+    bool assemble(const SyncManifest::File &file, QByteArray *data, QString *error) const;
+    bool publishDirectory(const SyncManifest &manifest, QString *error);
+    void collectGarbage(const SyncManifest &manifest);
+
+    QString m_target;
+    QString m_stateDir;
+};
+
+class LocalTransport : public SyncTransport
+{
+public:
+    explicit LocalTransport(ContentReceiver *receiver);
+
+    bool missingChunks(const QList<QByteArray> &hashes, QList<QByteArray> *missing) override;
+    bool putChunk(const QByteArray &hash, const QByteArray &data) override;
+    bool publish(const SyncManifest &manifest) override;
+
+private:
+    ContentReceiver *m_receiver;
+};
+
+class ProcessTransport : public SyncTransport
+{
+public:
+    // program/arguments start the receiver, e.g. ssh pi@kiosk gladis-sync --receive app/vars.bundle
+    ProcessTransport(const QString &program, const QStringList &arguments);
+    ~ProcessTransport() override;
+
+    bool missingChunks(const QList<QByteArray> &hashes, QList<QByteArray> *missing) override;
+    bool putChunk(const QByteArray &hash, const QByteArray &data) override;
+    bool publish(const SyncManifest &manifest) override;
+
+private:
+    bool request(char op, const QByteArray &payload, QByteArray *reply);
+    bool readExact(qint64 size, QByteArray *out);
+
+    QProcess *m_process;
+};
+
+// Sends the manifest's missing chunks and publishes it; progress on stdout
+struct SyncStats
+{
+    int files = 0;
+    int chunks = 0;
+    int chunksSent = 0;
+    qint64 bytesSent = 0;
+};
+bool syncDirectory(const QString &source, SyncTransport *transport, SyncStats *stats, QString *error);
+
+#endif // CONTENTSYNC_H
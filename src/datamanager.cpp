@@ -1,149 +1,402 @@
 #include "datamanager.h"
+#include "metrics.h"
+#include "logging.h"
+#include "contentbundle.h"
+#include "virtualclock.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QUrl>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMetaProperty>
 #include <QDebug>
 #include <QDir>
-#include <QThread>
+#include <QBuffer>
+#include <QImageReader>
+#include <QCborMap>
+#include <QMutexLocker>
 
 DataManager::DataManager(QObject *parent)
     : QObject(parent)
     , m_fileWatcher(new QFileSystemWatcher(this))
-    , m_delayTimer(new QTimer(this))
+    , m_delayTimer(new ClockTimer(this))
+    , m_slotValues(new QQmlPropertyMap(this))
+    , m_players(new PlayerFeedModel(this))
+    , m_leaderboard(new PlayerFeedModel(this))
     , m_dataPath("welcome-data")
-    , m_qrCodeAvailable(false)
-    , m_facilityLogoIsGif(false)
-    , m_textDaily("LAB HOURS")
-    , m_textCount("PLAYERS")
-    , m_textRound("NEW RELEASES")
+    , m_bundleMode(false)
+    , m_bundleGeneration(0)
 {
+    Metrics::instance()->describe("gladis_bundle_swaps_total", Metrics::Counter, "Content bundles (re)opened after a rename");
+    Metrics::instance()->describe("gladis_bundle_errors_total", Metrics::Counter, "Content bundles rejected (truncated, wrong version)");
+    Metrics::instance()->describe("gladis_bundle_bytes", Metrics::Gauge, "Size of the mapped content bundle");
+    Metrics::instance()->describe("gladis_feed_records", Metrics::Gauge, "Rows in the player feed models (players + leaderboard)");
+    Metrics::instance()->describe("gladis_feed_parse_seconds", Metrics::Histogram, "Time to stream user_data.json into the feed models");
+
+    m_latencyClock.start();
     m_delayTimer->setSingleShot(true);
     m_delayTimer->setInterval(500); // 500ms delay to ensure file write completion
 
     connect(m_fileWatcher, &QFileSystemWatcher::fileChanged,
             this, &DataManager::onFileChanged);
-    connect(m_delayTimer, &QTimer::timeout,
+    connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &DataManager::onDirectoryChanged);
+    connect(m_delayTimer, &ClockTimer::timeout,
             this, &DataManager::onDelayedFileRead);
 
+    registerSlots();
+
+    // Nothing is watched or read until an app using the data is put on a layer
+    // (see setActiveApps), so startup cost scales with what is on screen
+}
+
+void DataManager::registerSlots()
+{
+    // Data slots: exposed to QML by name, loaded from files in the data path
+    addSlot("facilityData", {"facility_data.json"}, JsonSlot, QVariantMap());
+    addSlot("userData", {"user_data.json"}, FeedSlot, QVariantMap());
+    addSlot("facilityColors", {"facility_colors"}, JsonSlot, QVariantMap());
+    addSlot("facilityName", {"facility_name.txt"}, TextSlot, QString());
+    addSlot("scrollUpperText", {"scroll_upper.txt"}, TextSlot, QString("SEAMLESS SCROLLING TEXT NOTIFICATION"));
+    addSlot("scrollLowerText", {"scroll_lower.txt"}, TextSlot, QString("SEAMLESS SCROLLING TEXT NOTIFICATION"));
+    addSlot("textDaily", {"text_daily"}, TextSlot, QString("LAB HOURS"));
+    addSlot("textCount", {"text_count"}, TextSlot, QString("PLAYERS"));
+    addSlot("textRound", {"text_round"}, TextSlot, QString("NEW RELEASES"));
+    addSlot("qrCodeAvailable", {"qr_support.png"}, ExistsSlot, false);
+    addSlot("facilityLogoIsGif", {"facility_logo.gif"}, ExistsSlot, false);
+    addSlot("facilityLogo", {"facility_logo.png", "facility_logo.gif"}, ImageSlot, QString());
+    addSlot("bannerImage", {"banner_image.png"}, ImageSlot, QString());
+    addSlot("leftImage", {"left_image.png"}, ImageSlot, QString());
+    addSlot("rightImage", {"right_image.png"}, ImageSlot, QString());
+    addSlot("game1Image", {"game1_image.jpg"}, ImageSlot, QString());
+    addSlot("game2Image", {"game2_image.jpg"}, ImageSlot, QString());
+    addSlot("game3Image", {"game3_image.jpg"}, ImageSlot, QString());
+    addSlot("game4Image", {"game4_image.jpg"}, ImageSlot, QString());
+    addSlot("qrCode", {"qr_support.png"}, ImageSlot, QString());
+
+    // Slots consumed by each layer app
+    declareAppData("app_hello", {
+        "facilityData", "userData", "facilityColors", "facilityName",
+        "scrollUpperText", "scrollLowerText", "textDaily", "textCount", "textRound",
+        "qrCodeAvailable", "facilityLogoIsGif", "facilityLogo", "bannerImage",
+        "leftImage", "rightImage", "game1Image", "game2Image", "game3Image", "game4Image",
+        "qrCode"
+    });
+}
+
+void DataManager::addSlot(const QString &name, const QStringList &fileNames, SlotKind kind,
+                          const QVariant &defaultValue)
+{
+    DataSlot slot;
+    slot.name = name;
+    slot.fileNames = fileNames;
+    slot.kind = kind;
+    slot.defaultValue = defaultValue;
+    slot.value = defaultValue;
+
+    m_slotIndex.insert(name, m_slots.size());
+    m_slots.append(slot);
+    m_slotValues->insert(name, defaultValue);
+}
+
+void DataManager::declareAppData(const QString &app, const QStringList &slotNames)
+{
+    for (const QString &name : slotNames) {
+        if (!m_slotIndex.contains(name)) {
+            qCWarning(lcData) << "App" << app << "declares unknown data slot:" << name;
+        }
+    }
+    m_appSlots.insert(app, slotNames);
+}
+
+QVariant DataManager::slotValue(const QString &name) const
+{
+    auto it = m_slotIndex.constFind(name);
+    if (it == m_slotIndex.constEnd()) {
+        return QVariant();
+    }
+    return m_slots.at(it.value()).value;
+}
+
+QStringList DataManager::activeApps() const
+{
+    QStringList apps(m_activeApps.begin(), m_activeApps.end());
+    apps.sort();
+    return apps;
+}
+
+void DataManager::setActiveApps(const QStringList &apps)
+{
+    QSet<QString> newApps;
+    for (const QString &app : apps) {
+        if (!app.isEmpty()) {
+            newApps.insert(app);
+        }
+    }
+
+    if (newApps == m_activeApps) {
+        return;
+    }
+
+    m_activeApps = newApps;
+    qCDebug(lcData) << "Data consumers changed:" << activeApps();
+    updateActiveSlots();
+    emit activeAppsChanged();
+}
+
+void DataManager::updateActiveSlots()
+{
+    QSet<QString> wanted;
+    for (const QString &app : m_activeApps) {
+        const QStringList slotNames = m_appSlots.value(app);
+        for (const QString &name : slotNames) {
+            wanted.insert(name);
+        }
+    }
+
+    QList<int> activated;
+    for (int i = 0; i < m_slots.size(); i++) {
+        DataSlot &slot = m_slots[i];
+        bool active = wanted.contains(slot.name);
+        if (active && !slot.active) {
+            activated.append(i);
+        } else if (!active && slot.active) {
+            // Release the parsed data, the slot is reloaded when an app needs it again
+            qCDebug(lcData) << "Releasing data slot:" << slot.name;
+            setSlotValue(slot, slot.defaultValue);
+            if (slot.kind == FeedSlot) {
+                clearFeedModels();
+            }
+        }
+        slot.active = active;
+    }
+
+    // Nothing watched the bundle while no slot was in use
+    if (m_bundleMode) {
+        reloadBundle();
+    }
     setupFileWatching();
-    loadAllData();
+
+    // Only slots that just became active are read, the rest are already current
+    for (int index : activated) {
+        loadSlot(m_slots[index]);
+    }
 }
 
 void DataManager::setDataPath(const QString &path)
 {
     if (m_dataPath != path) {
         m_dataPath = path;
-        setupFileWatching();
-        loadAllData();
+        m_bundleMode = path.endsWith(".bundle");
+        m_pendingFiles.clear();
+        m_pendingSince.clear();
+
+        // Bundles are swapped by rename, the delay only folds the watcher's event burst
+        m_delayTimer->setInterval(m_bundleMode ? 50 : 500);
+        {
+            QMutexLocker locker(&m_bundleMutex);
+            m_bundle.reset();
+        }
+        if (m_bundleMode) {
+            reloadBundle();
+        }
+
+        // Without active slots there is nothing to watch or read yet
+        if (!m_pathSlots.isEmpty() || !m_activeApps.isEmpty()) {
+            setupFileWatching();
+            loadAllData();
+        }
         emit dataPathChanged();
     }
 }
 
+QString DataManager::slotFilePath(const DataSlot &slot, int candidate) const
+{
+    // Every slot of a bundle reads the one bundle file
+    if (m_bundleMode) {
+        return m_dataPath;
+    }
+    return m_dataPath + "/" + slot.fileNames.at(candidate);
+}
+
 void DataManager::setupFileWatching()
 {
     // Remove existing watches
     if (!m_fileWatcher->files().isEmpty()) {
         m_fileWatcher->removePaths(m_fileWatcher->files());
     }
+    if (!m_fileWatcher->directories().isEmpty()) {
+        m_fileWatcher->removePaths(m_fileWatcher->directories());
+    }
+
+    // Map every file read by an active slot to the slots reading it
+    m_pathSlots.clear();
+    for (int i = 0; i < m_slots.size(); i++) {
+        const DataSlot &slot = m_slots.at(i);
+        if (!slot.active) {
+            continue;
+        }
+        for (int c = 0; c < slot.fileNames.size(); c++) {
+            QList<int> &pathSlots = m_pathSlots[slotFilePath(slot, c)];
+            if (!pathSlots.contains(i)) {
+                pathSlots.append(i);
+            }
+        }
+    }
+
+    if (m_pathSlots.isEmpty()) {
+        qCDebug(lcData) << "No data slots in use, nothing to watch";
+        return;
+    }
 
-    // Add files to watch
-    QStringList filesToWatch = {
-        m_dataPath + "/facility_data.json",
-        m_dataPath + "/user_data.json",
-        m_dataPath + "/facility_name.txt",
-        m_dataPath + "/facility_colors",
-        m_dataPath + "/scroll_upper.txt",
-        m_dataPath + "/scroll_lower.txt",
-        m_dataPath + "/qr_support.png",
-        m_dataPath + "/facility_logo.png",
-        m_dataPath + "/facility_logo.gif",
-        m_dataPath + "/game1_image.jpg",
-        m_dataPath + "/game2_image.jpg",
-        m_dataPath + "/game3_image.jpg",
-        m_dataPath + "/game4_image.jpg",
-        m_dataPath + "/left_image.png",
-        m_dataPath + "/right_image.png",
-        m_dataPath + "/banner_image.png",
-        m_dataPath + "/text_daily",
-        m_dataPath + "/text_count",
-        m_dataPath + "/text_round"
-    };
-
-    for (const QString &file : filesToWatch) {
+    for (auto it = m_pathSlots.constBegin(); it != m_pathSlots.constEnd(); ++it) {
+        const QString &file = it.key();
         if (QFile::exists(file)) {
             m_fileWatcher->addPath(file);
-            qDebug() << "Watching file:" << file;
+            qCDebug(lcData) << "Watching file:" << file;
         } else {
-            qWarning() << "File not found:" << file;
+            qCWarning(lcData) << "File not found:" << file;
         }
     }
+
+    // The directory itself catches files that appear later (and bundles renamed over)
+    QString directory = m_bundleMode ? QFileInfo(m_dataPath).absolutePath() : m_dataPath;
+    if (QDir(directory).exists()) {
+        m_fileWatcher->addPath(directory);
+    }
 }
 
 void DataManager::onFileChanged(const QString &path)
 {
-    qDebug() << "File changed detected:" << path;
+    qCDebug(lcData) << "File changed detected:" << path;
+    Metrics::instance()->increment("gladis_watcher_events_total", "source=\"data\",kind=\"file\"");
+    emit fileEventReceived(path);
 
-    // Store the pending file and start the delay timer
-    m_pendingFile = path;
+    // Queue the file and (re)start the delay timer
+    if (m_pendingFiles.contains(path)) {
+        Metrics::instance()->increment("gladis_watcher_events_coalesced_total", "source=\"data\"");
+    }
+    if (!m_pendingSince.contains(path)) {
+        m_pendingSince.insert(path, m_latencyClock.nsecsElapsed());
+    }
+    m_pendingFiles.insert(path);
     m_delayTimer->start();
 }
 
+void DataManager::onDirectoryChanged(const QString &path)
+{
+    Metrics::instance()->increment("gladis_watcher_events_total", "source=\"data\",kind=\"directory\"");
+    emit fileEventReceived(path);
+
+    // A rename over the bundle leaves the watch on the old file, so any directory
+    // event may be a swap; reloadBundle() ignores the ones that are not
+    if (m_bundleMode) {
+        if (!m_pendingSince.contains(m_dataPath)) {
+            m_pendingSince.insert(m_dataPath, m_latencyClock.nsecsElapsed());
+        }
+        m_pendingFiles.insert(m_dataPath);
+        m_delayTimer->start();
+        return;
+    }
+
+    // gladis-sync flips a directory target (a symlink) to a new version and
+    // removes the old one, taking the watch with it
+    if (!m_fileWatcher->directories().contains(m_dataPath) && QDir(m_dataPath).exists()) {
+        m_fileWatcher->addPath(m_dataPath);
+    }
+
+    // Pick up slot files that were created since the last scan
+    const QStringList watched = m_fileWatcher->files();
+    for (auto it = m_pathSlots.constBegin(); it != m_pathSlots.constEnd(); ++it) {
+        const QString &file = it.key();
+        if (!watched.contains(file) && QFile::exists(file)) {
+            qCDebug(lcData) << "File appeared:" << file;
+            m_fileWatcher->addPath(file);
+            if (!m_pendingSince.contains(file)) {
+                m_pendingSince.insert(file, m_latencyClock.nsecsElapsed());
+            }
+            m_pendingFiles.insert(file);
+            m_delayTimer->start();
+        }
+    }
+}
+
 void DataManager::onDelayedFileRead()
 {
-    if (m_pendingFile.isEmpty()) {
+    if (m_pendingFiles.isEmpty()) {
         return;
     }
 
-    QString path = m_pendingFile;
-    m_pendingFile.clear();
+    const QSet<QString> pending = m_pendingFiles;
+    m_pendingFiles.clear();
+
+    for (const QString &path : pending) {
+        // Complete by construction (renamed into place), no stability check
+        if (m_bundleMode && path == m_dataPath) {
+            bool swapped = reloadBundle();
+            if (swapped) {
+                applyFileChange(path);
+            }
+            qint64 latencyNs = m_latencyClock.nsecsElapsed() - m_pendingSince.take(path);
+            if (swapped) {
+                Metrics::instance()->observe("gladis_data_reload_latency_seconds", latencyNs / 1e9,
+                                             Metrics::label("file", QFileInfo(path).fileName()));
+            }
+            continue;
+        }
+
+        if (!m_pathSlots.contains(path)) {
+            m_pendingSince.remove(path);
+            continue;
+        }
+
+        // A removed file is applied right away (exists slots flip, text falls back to default)
+        if (QFile::exists(path) && !isFileStable(path)) {
+            qCDebug(lcData) << "File still being written, retrying:" << path;
+            Metrics::instance()->increment("gladis_data_unstable_retries_total");
+            m_pendingFiles.insert(path);
+            continue;
+        }
+
+        qCDebug(lcData) << "Reading stable file:" << path;
+
+        // Re-add the file to watcher (sometimes removed after modification)
+        if (!m_fileWatcher->files().contains(path) && QFile::exists(path)) {
+            m_fileWatcher->addPath(path);
+        }
+
+        applyFileChange(path);
+
+        // First watcher event for this change -> value applied (includes the settle delay)
+        if (m_pendingSince.contains(path)) {
+            qint64 latencyNs = m_latencyClock.nsecsElapsed() - m_pendingSince.take(path);
+            Metrics::instance()->observe("gladis_data_reload_latency_seconds", latencyNs / 1e9,
+                                         Metrics::label("file", QFileInfo(path).fileName()));
+        }
+    }
 
-    // Check if file is stable (same size for the delay period)
-    if (!isFileStable(path)) {
-        qDebug() << "File still being written, retrying:" << path;
-        m_pendingFile = path;
+    if (!m_pendingFiles.isEmpty()) {
         m_delayTimer->start();
-        return;
     }
+}
 
-    qDebug() << "Reading stable file:" << path;
-
-    // Re-add the file to watcher (sometimes removed after modification)
-    if (!m_fileWatcher->files().contains(path)) {
-        m_fileWatcher->addPath(path);
-    }
-
-    // Load the appropriate data based on filename
-    if (path.endsWith("facility_data.json")) {
-        loadFacilityData();
-    } else if (path.endsWith("user_data.json")) {
-        loadUserData();
-    } else if (path.endsWith("facility_name.txt")) {
-        loadFacilityName();
-    } else if (path.endsWith("facility_colors")) {
-        loadFacilityColors();
-    } else if (path.endsWith("scroll_upper.txt")) {
-        loadScrollUpperText();
-    } else if (path.endsWith("scroll_lower.txt")) {
-        loadScrollLowerText();
-    } else if (path.endsWith("qr_support.png")) {
-        checkQRCodeAvailability();
-    } else if (path.endsWith("facility_logo.png") || path.endsWith("facility_logo.gif")) {
-        // Facility logo changed - check type and emit signals
-        checkFacilityLogoType();
-        qDebug() << "Facility logo file changed, emitting imagesChanged signal";
-        emit imagesChanged();
-    } else if (path.endsWith("_image.jpg") || path.endsWith("_image.png")) {
-        // Image file changed - emit signal to reload images in QML
-        qDebug() << "Image file changed, emitting imagesChanged signal";
+void DataManager::applyFileChange(const QString &path)
+{
+    // Hash lookup instead of matching the file name against every slot
+    bool imageChanged = false;
+    const QList<int> indexes = m_pathSlots.value(path);
+    for (int index : indexes) {
+        DataSlot &slot = m_slots[index];
+        loadSlot(slot);
+        if (slot.kind == ImageSlot) {
+            imageChanged = true;
+        }
+    }
+
+    if (imageChanged) {
+        // Same URL, new pixels - let QML reload the images
+        qCDebug(lcData) << "Image file changed, emitting imagesChanged signal";
         emit imagesChanged();
-    } else if (path.endsWith("text_daily")) {
-        loadTextDaily();
-    } else if (path.endsWith("text_count")) {
-        loadTextCount();
-    } else if (path.endsWith("text_round")) {
-        loadTextRound();
     }
 }
 
@@ -178,7 +431,7 @@ QByteArray DataManager::safeReadFile(const QString &path)
 {
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file:" << path;
+        qCWarning(lcData) << "Failed to open file:" << path;
         return QByteArray();
     }
 
@@ -187,116 +440,250 @@ QByteArray DataManager::safeReadFile(const QString &path)
     return data;
 }
 
-void DataManager::loadAllData()
+bool DataManager::reloadBundle()
 {
-    loadFacilityData();
-    loadUserData();
-    loadFacilityName();
-    loadFacilityColors();
-    loadScrollUpperText();
-    loadScrollLowerText();
-    checkQRCodeAvailability();
-    checkFacilityLogoType();
-    loadTextDaily();
-    loadTextCount();
-    loadTextRound();
+    QString error;
+    QSharedPointer<const ContentBundle> bundle = ContentBundle::open(m_dataPath, &error);
+    if (!bundle) {
+        // Keep serving the last good bundle
+        if (QFile::exists(m_dataPath)) {
+            qCWarning(lcData) << "Content bundle rejected:" << m_dataPath << "-" << error;
+            Metrics::instance()->increment("gladis_bundle_errors_total");
+        }
+        return false;
+    }
+
+    QSharedPointer<const ContentBundle> current = this->bundle();
+    if (current && current->packedMs() == bundle->packedMs() && current->size() == bundle->size()) {
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_bundleMutex);
+        m_bundle = bundle;
+        m_bundleGeneration++;
+    }
+
+    // The watch stays on the replaced file otherwise
+    if (m_fileWatcher->files().contains(m_dataPath)) {
+        m_fileWatcher->removePath(m_dataPath);
+        m_fileWatcher->addPath(m_dataPath);
+    }
+
+    qCDebug(lcData) << "Content bundle mapped:" << m_dataPath << "-" << bundle->names().size()
+             << "entries," << bundle->size() << "bytes";
+    Metrics::instance()->increment("gladis_bundle_swaps_total");
+    Metrics::instance()->setGauge("gladis_bundle_bytes", bundle->size());
+    return true;
 }
 
-void DataManager::loadFacilityData()
+QSharedPointer<const ContentBundle> DataManager::bundle() const
 {
-    QString filePath = m_dataPath + "/facility_data.json";
-    QByteArray data = safeReadFile(filePath);
+    QMutexLocker locker(&m_bundleMutex);
+    return m_bundle;
+}
 
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read facility_data.json";
-        return;
+QString DataManager::bundleImageUrl(const QString &name) const
+{
+    QMutexLocker locker(&m_bundleMutex);
+    if (!m_bundle || !m_bundle->contains(name)) {
+        return QString();
     }
+    return QString("image://bundle/%1/%2").arg(m_bundleGeneration).arg(name);
+}
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error in facility_data.json:" << parseError.errorString();
-        return;
+void DataManager::loadBundleSlot(DataSlot &slot)
+{
+    // First candidate the bundle has; values are built straight from the mapping
+    QSharedPointer<const ContentBundle> bundle = this->bundle();
+    QString entry;
+    for (const QString &fileName : slot.fileNames) {
+        if (bundle && bundle->contains(fileName)) {
+            entry = fileName;
+            break;
+        }
     }
 
-    if (doc.isObject()) {
-        m_facilityData = doc.object().toVariantMap();
-        emit facilityDataChanged();
-        qDebug() << "Facility data loaded successfully";
+    switch (slot.kind) {
+    case TextSlot: {
+        QByteArray data = entry.isEmpty() ? QByteArray() : bundle->data(entry);
+        if (data.isEmpty()) {
+            qCWarning(lcData) << "Empty or missing bundle entry" << slot.fileNames.first();
+            setSlotValue(slot, slot.defaultValue);
+            break;
+        }
+        setSlotValue(slot, QString::fromUtf8(data).trimmed());
+        break;
+    }
+    case JsonSlot: {
+        // Parsed once by gladis-pack, stored as CBOR
+        QCborValue value = entry.isEmpty() ? QCborValue() : bundle->cbor(entry);
+        if (!value.isMap()) {
+            qCWarning(lcData) << "No JSON object in bundle entry" << slot.fileNames.first();
+            break;
+        }
+        setSlotValue(slot, value.toMap().toVariantMap());
+        break;
+    }
+    case FeedSlot: {
+        // Streamed from the mapped text; a CBOR map of 100k rows would be built in full
+        QByteArray data = entry.isEmpty() ? QByteArray() : bundle->data(entry);
+        if (data.isEmpty()) {
+            qCWarning(lcData) << "Empty or missing bundle entry" << slot.fileNames.first();
+            break;
+        }
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        loadFeedSlot(slot, &buffer);
+        break;
     }
+    case ImageSlot:
+        setSlotValue(slot, entry.isEmpty() ? QString() : bundleImageUrl(entry));
+        break;
+    case ExistsSlot:
+        setSlotValue(slot, !entry.isEmpty());
+        break;
+    }
+
+    emit slotReloaded(slot.name, {m_dataPath});
 }
 
-void DataManager::loadUserData()
+void DataManager::loadAllData()
 {
-    QString filePath = m_dataPath + "/user_data.json";
-    QByteArray data = safeReadFile(filePath);
+    for (DataSlot &slot : m_slots) {
+        if (slot.active) {
+            loadSlot(slot);
+        }
+    }
+}
 
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read user_data.json";
+void DataManager::loadSlot(DataSlot &slot)
+{
+    if (m_bundleMode) {
+        loadBundleSlot(slot);
         return;
     }
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    switch (slot.kind) {
+    case TextSlot: {
+        QString filePath = slotFilePath(slot, 0);
+        QByteArray data = safeReadFile(filePath);
+        if (data.isEmpty()) {
+            qCWarning(lcData) << "Empty or failed to read" << slot.fileNames.first();
+            setSlotValue(slot, slot.defaultValue);
+            break;
+        }
+        setSlotValue(slot, QString::fromUtf8(data).trimmed());
+        break;
+    }
+    case JsonSlot: {
+        QString filePath = slotFilePath(slot, 0);
+        QByteArray data = safeReadFile(filePath);
+        if (data.isEmpty()) {
+            qCWarning(lcData) << "Empty or failed to read" << slot.fileNames.first();
+            break;
+        }
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            qCWarning(lcData) << "JSON parse error in" << slot.fileNames.first() << ":" << parseError.errorString();
+            break;
+        }
 
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error in user_data.json:" << parseError.errorString();
-        return;
+        if (doc.isObject()) {
+            setSlotValue(slot, doc.object().toVariantMap());
+        }
+        break;
+    }
+    case FeedSlot: {
+        QFile file(slotFilePath(slot, 0));
+        if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+            qCWarning(lcData) << "Empty or failed to read" << slot.fileNames.first();
+            break;
+        }
+        loadFeedSlot(slot, &file);
+        break;
+    }
+    case ImageSlot: {
+        QString url;
+        for (int c = 0; c < slot.fileNames.size(); c++) {
+            QFileInfo fileInfo(slotFilePath(slot, c));
+            if (fileInfo.exists()) {
+                url = QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
+                break;
+            }
+        }
+        setSlotValue(slot, url);
+        break;
+    }
+    case ExistsSlot: {
+        bool exists = false;
+        for (int c = 0; c < slot.fileNames.size() && !exists; c++) {
+            exists = QFile::exists(slotFilePath(slot, c));
+        }
+        setSlotValue(slot, exists);
+        break;
+    }
     }
 
-    if (doc.isObject()) {
-        m_userData = doc.object().toVariantMap();
-        emit userDataChanged();
-        qDebug() << "User data loaded successfully";
+    QStringList filePaths;
+    for (int c = 0; c < slot.fileNames.size(); c++) {
+        filePaths.append(slotFilePath(slot, c));
     }
+    emit slotReloaded(slot.name, filePaths);
 }
 
-void DataManager::loadFacilityName()
+void DataManager::loadFeedSlot(DataSlot &slot, QIODevice *device)
 {
-    QString filePath = m_dataPath + "/facility_name.txt";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read facility_name.txt";
+    // Previous value and rows are kept on parse errors, like JsonSlot
+    QElapsedTimer timer;
+    timer.start();
+    QVariantMap summary;
+    QString error;
+    if (!PlayerFeed::ingest(device, &summary, m_players, m_leaderboard, &error)) {
+        qCWarning(lcData) << "JSON parse error in" << slot.fileNames.first() << ":" << error;
         return;
     }
-
-    QString name = QString::fromUtf8(data).trimmed();
-    if (m_facilityName != name) {
-        m_facilityName = name;
-        emit facilityNameChanged();
-        qDebug() << "Facility name loaded:" << m_facilityName;
-    }
+    Metrics::instance()->observe("gladis_feed_parse_seconds", timer.nsecsElapsed() / 1e9);
+    Metrics::instance()->setGauge("gladis_feed_records", m_players->count() + m_leaderboard->count());
+    setSlotValue(slot, summary);
 }
 
-void DataManager::loadFacilityColors()
+void DataManager::clearFeedModels()
 {
-    QString filePath = m_dataPath + "/facility_colors";
-    QByteArray data = safeReadFile(filePath);
+    m_players->clear();
+    m_leaderboard->clear();
+    Metrics::instance()->setGauge("gladis_feed_records", 0);
+}
 
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read facility_colors";
+void DataManager::setSlotValue(DataSlot &slot, const QVariant &value)
+{
+    if (slot.value == value) {
         return;
     }
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    slot.value = value;
+    m_slotValues->insert(slot.name, value);
+    qCDebug(lcData) << "Data slot loaded:" << slot.name;
 
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error in facility_colors:" << parseError.errorString();
-        return;
+    // Slots that are also classic properties notify through the property's signal
+    int propertyIndex = metaObject()->indexOfProperty(slot.name.toLatin1().constData());
+    if (propertyIndex >= 0) {
+        QMetaProperty property = metaObject()->property(propertyIndex);
+        if (property.hasNotifySignal()) {
+            property.notifySignal().invoke(this, Qt::DirectConnection);
+        }
     }
 
-    if (doc.isObject()) {
-        m_facilityColors = doc.object().toVariantMap();
-        emit facilityColorsChanged();
-        qDebug() << "Facility colors loaded successfully";
-    }
+    emit slotChanged(slot.name);
 }
 
 QString DataManager::getGameImagePath(int index) const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl(QString("game%1_image.jpg").arg(index));
+    }
     QString relativePath = m_dataPath + QString("/game%1_image.jpg").arg(index);
     QFileInfo fileInfo(relativePath);
     return QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
@@ -304,6 +691,9 @@ QString DataManager::getGameImagePath(int index) const
 
 QString DataManager::getBannerImagePath() const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl("banner_image.png");
+    }
     QString relativePath = m_dataPath + "/banner_image.png";
     QFileInfo fileInfo(relativePath);
     return QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
@@ -312,6 +702,10 @@ QString DataManager::getBannerImagePath() const
 QString DataManager::getFacilityLogoPath() const
 {
     // Check for .png first, then .gif
+    if (m_bundleMode) {
+        QString url = bundleImageUrl("facility_logo.png");
+        return url.isEmpty() ? bundleImageUrl("facility_logo.gif") : url;
+    }
     QString pngPath = m_dataPath + "/facility_logo.png";
     QString gifPath = m_dataPath + "/facility_logo.gif";
 
@@ -329,6 +723,9 @@ QString DataManager::getFacilityLogoPath() const
 
 QString DataManager::getLeftImagePath() const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl("left_image.png");
+    }
     QString relativePath = m_dataPath + "/left_image.png";
     QFileInfo fileInfo(relativePath);
     return QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
@@ -336,6 +733,9 @@ QString DataManager::getLeftImagePath() const
 
 QString DataManager::getRightImagePath() const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl("right_image.png");
+    }
     QString relativePath = m_dataPath + "/right_image.png";
     QFileInfo fileInfo(relativePath);
     return QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
@@ -343,6 +743,9 @@ QString DataManager::getRightImagePath() const
 
 QString DataManager::getQRCodePath() const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl("qr_support.png");
+    }
     QString relativePath = m_dataPath + "/qr_support.png";
     QFileInfo fileInfo(relativePath);
     return QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
@@ -350,6 +753,9 @@ QString DataManager::getQRCodePath() const
 
 QString DataManager::getGameLabGifPath() const
 {
+    if (m_bundleMode) {
+        return bundleImageUrl("gamelab.gif");
+    }
     QString relativePath = m_dataPath + "/gamelab.gif";
     QFileInfo fileInfo(relativePath);
     if (fileInfo.exists()) {
@@ -358,126 +764,34 @@ QString DataManager::getGameLabGifPath() const
     return "";
 }
 
-void DataManager::loadScrollUpperText()
-{
-    QString filePath = m_dataPath + "/scroll_upper.txt";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read scroll_upper.txt";
-        m_scrollUpperText = "SEAMLESS SCROLLING TEXT NOTIFICATION";
-        emit scrollUpperTextChanged();
-        return;
-    }
-
-    QString text = QString::fromUtf8(data).trimmed();
-    if (m_scrollUpperText != text) {
-        m_scrollUpperText = text;
-        emit scrollUpperTextChanged();
-        qDebug() << "Scroll upper text loaded:" << m_scrollUpperText;
-    }
-}
-
-void DataManager::loadScrollLowerText()
-{
-    QString filePath = m_dataPath + "/scroll_lower.txt";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read scroll_lower.txt";
-        m_scrollLowerText = "SEAMLESS SCROLLING TEXT NOTIFICATION";
-        emit scrollLowerTextChanged();
-        return;
-    }
-
-    QString text = QString::fromUtf8(data).trimmed();
-    if (m_scrollLowerText != text) {
-        m_scrollLowerText = text;
-        emit scrollLowerTextChanged();
-        qDebug() << "Scroll lower text loaded:" << m_scrollLowerText;
-    }
-}
-
-void DataManager::checkQRCodeAvailability()
-{
-    QString filePath = m_dataPath + "/qr_support.png";
-    bool available = QFile::exists(filePath);
-
-    if (m_qrCodeAvailable != available) {
-        m_qrCodeAvailable = available;
-        emit qrCodeAvailableChanged();
-        qDebug() << "QR code availability:" << m_qrCodeAvailable;
-    }
-}
-
-void DataManager::checkFacilityLogoType()
-{
-    QString gifPath = m_dataPath + "/facility_logo.gif";
-    bool isGif = QFile::exists(gifPath);
-
-    if (m_facilityLogoIsGif != isGif) {
-        m_facilityLogoIsGif = isGif;
-        emit facilityLogoIsGifChanged();
-        qDebug() << "Facility logo is GIF:" << m_facilityLogoIsGif;
-    }
-}
-
-void DataManager::loadTextDaily()
-{
-    QString filePath = m_dataPath + "/text_daily";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read text_daily";
-        m_textDaily = "LAB HOURS";  // Default value
-        emit textDailyChanged();
-        return;
-    }
-
-    QString text = QString::fromUtf8(data).trimmed();
-    if (m_textDaily != text) {
-        m_textDaily = text;
-        emit textDailyChanged();
-        qDebug() << "Text daily loaded:" << m_textDaily;
-    }
-}
-
-void DataManager::loadTextCount()
+BundleImageProvider::BundleImageProvider(DataManager *dataManager)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_dataManager(dataManager)
 {
-    QString filePath = m_dataPath + "/text_count";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read text_count";
-        m_textCount = "PLAYERS";  // Default value
-        emit textCountChanged();
-        return;
-    }
-
-    QString text = QString::fromUtf8(data).trimmed();
-    if (m_textCount != text) {
-        m_textCount = text;
-        emit textCountChanged();
-        qDebug() << "Text count loaded:" << m_textCount;
-    }
 }
 
-void DataManager::loadTextRound()
+QImage BundleImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
 {
-    QString filePath = m_dataPath + "/text_round";
-    QByteArray data = safeReadFile(filePath);
-
-    if (data.isEmpty()) {
-        qWarning() << "Empty or failed to read text_round";
-        m_textRound = "NEW RELEASES";  // Default value
-        emit textRoundChanged();
-        return;
+    // "<generation>/<entry name>"; the bundle reference keeps the mapping alive while decoding
+    QSharedPointer<const ContentBundle> bundle = m_dataManager->bundle();
+    QString name = id.section('/', 1);
+    QImage image;
+    if (bundle && bundle->contains(name)) {
+        QBuffer buffer;
+        buffer.setData(bundle->data(name));
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        if (requestedSize.width() > 0 && requestedSize.height() > 0 && reader.size().isValid()) {
+            reader.setScaledSize(reader.size().scaled(requestedSize, Qt::KeepAspectRatio));
+        }
+        image = reader.read();
+        if (image.isNull()) {
+            qCWarning(lcData) << "Bundle image" << name << "failed to decode:" << reader.errorString();
+        }
     }
 
-    QString text = QString::fromUtf8(data).trimmed();
-    if (m_textRound != text) {
-        m_textRound = text;
-        emit textRoundChanged();
-        qDebug() << "Text round loaded:" << m_textRound;
+    if (size) {
+        *size = image.size();
     }
+    return image;
 }
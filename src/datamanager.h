@@ -3,10 +3,20 @@
 
 #include <QObject>
 #include <QFileSystemWatcher>
-#include <QTimer>
 #include <QVariantMap>
 #include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QQmlPropertyMap>
+#include <QQuickImageProvider>
+#include <QSharedPointer>
+#include <QMutex>
+#include "playerfeed.h"
+
+class ContentBundle;
+class ClockTimer;
 
 class DataManager : public QObject
 {
@@ -24,24 +34,57 @@ class DataManager : public QObject
     Q_PROPERTY(QString textCount READ textCount NOTIFY textCountChanged)
     Q_PROPERTY(QString textRound READ textRound NOTIFY textRoundChanged)
 
+    // Every registered data slot by name (e.g. dataManager.slotValues.textDaily)
+    Q_PROPERTY(QQmlPropertyMap *slotValues READ slotValues CONSTANT)
+    Q_PROPERTY(QStringList activeApps READ activeApps NOTIFY activeAppsChanged)
+
+    // Row models of the player feed (user_data.json "players" and "leaderboard")
+    Q_PROPERTY(PlayerFeedModel *players READ players CONSTANT)
+    Q_PROPERTY(PlayerFeedModel *leaderboard READ leaderboard CONSTANT)
+
 public:
+    // How a slot's file is turned into a value
+    enum SlotKind {
+        TextSlot,    // Trimmed UTF-8 text, default when missing or empty
+        JsonSlot,    // JSON object as QVariantMap, previous value kept on parse errors
+        ImageSlot,   // File URL of the first existing candidate, "" if none
+        ExistsSlot,  // True if any candidate file exists
+        FeedSlot     // Player feed: streamed, summary map as value, arrays into the feed models
+    };
+
     explicit DataManager(QObject *parent = nullptr);
 
-    QVariantMap facilityData() const { return m_facilityData; }
-    QVariantMap userData() const { return m_userData; }
-    QString facilityName() const { return m_facilityName; }
-    QVariantMap facilityColors() const { return m_facilityColors; }
+    QVariantMap facilityData() const { return slotValue("facilityData").toMap(); }
+    QVariantMap userData() const { return slotValue("userData").toMap(); }
+    QString facilityName() const { return slotValue("facilityName").toString(); }
+    QVariantMap facilityColors() const { return slotValue("facilityColors").toMap(); }
     QString dataPath() const { return m_dataPath; }
-    QString scrollUpperText() const { return m_scrollUpperText; }
-    QString scrollLowerText() const { return m_scrollLowerText; }
-    bool qrCodeAvailable() const { return m_qrCodeAvailable; }
-    bool facilityLogoIsGif() const { return m_facilityLogoIsGif; }
-    QString textDaily() const { return m_textDaily; }
-    QString textCount() const { return m_textCount; }
-    QString textRound() const { return m_textRound; }
+    QString scrollUpperText() const { return slotValue("scrollUpperText").toString(); }
+    QString scrollLowerText() const { return slotValue("scrollLowerText").toString(); }
+    bool qrCodeAvailable() const { return slotValue("qrCodeAvailable").toBool(); }
+    bool facilityLogoIsGif() const { return slotValue("facilityLogoIsGif").toBool(); }
+    QString textDaily() const { return slotValue("textDaily").toString(); }
+    QString textCount() const { return slotValue("textCount").toString(); }
+    QString textRound() const { return slotValue("textRound").toString(); }
+    QQmlPropertyMap *slotValues() const { return m_slotValues; }
+    QStringList activeApps() const;
+    PlayerFeedModel *players() const { return m_players; }
+    PlayerFeedModel *leaderboard() const { return m_leaderboard; }
 
+    // A directory of loose files, or a content bundle (path ending in .bundle,
+    // see ContentBundle) that all slots are served from
     void setDataPath(const QString &path);
+    bool isBundle() const { return m_bundleMode; }
+
+    // Current bundle, null in directory mode (any thread, for the image provider)
+    QSharedPointer<const ContentBundle> bundle() const;
 
+    // Layer apps currently configured; only their slots are watched and loaded.
+    // Newly needed slots are loaded immediately, slots no longer needed are
+    // unwatched and reset to their defaults.
+    void setActiveApps(const QStringList &apps);
+
+    Q_INVOKABLE QVariant slotValue(const QString &name) const;
     Q_INVOKABLE QString getGameImagePath(int index) const;
     Q_INVOKABLE QString getBannerImagePath() const;
     Q_INVOKABLE QString getFacilityLogoPath() const;
@@ -64,46 +107,86 @@ signals:
     void textDailyChanged();
     void textCountChanged();
     void textRoundChanged();
+    void activeAppsChanged();
+    void slotChanged(const QString &name);
+
+    // Instrumentation hooks (event journal): raw watcher notifications and
+    // every slot (re)load with the candidate files it was read from
+    void fileEventReceived(const QString &path);
+    void slotReloaded(const QString &name, const QStringList &filePaths);
 
 private slots:
     void onFileChanged(const QString &path);
+    void onDirectoryChanged(const QString &path);
     void onDelayedFileRead();
 
 private:
+    friend class MicroBench;  // bench/microbench.cpp times the private loaders
+
+    struct DataSlot {
+        QString name;
+        QStringList fileNames;  // Candidates relative to the data path, first existing wins
+        SlotKind kind;
+        QVariant defaultValue;
+        QVariant value;
+        bool active = false;
+    };
+
+    void registerSlots();
+    void addSlot(const QString &name, const QStringList &fileNames, SlotKind kind,
+                 const QVariant &defaultValue = QVariant());
+    void declareAppData(const QString &app, const QStringList &slotNames);
+    void updateActiveSlots();
     void setupFileWatching();
     void loadAllData();
-    void loadFacilityData();
-    void loadUserData();
-    void loadFacilityName();
-    void loadFacilityColors();
-    void loadScrollUpperText();
-    void loadScrollLowerText();
-    void checkQRCodeAvailability();
-    void checkFacilityLogoType();
-    void loadTextDaily();
-    void loadTextCount();
-    void loadTextRound();
+    void loadSlot(DataSlot &slot);
+    void setSlotValue(DataSlot &slot, const QVariant &value);
+    void applyFileChange(const QString &path);
+    QString slotFilePath(const DataSlot &slot, int candidate) const;
     bool isFileStable(const QString &path);
     QByteArray safeReadFile(const QString &path);
+    void loadFeedSlot(DataSlot &slot, QIODevice *device);
+    void clearFeedModels();
+    bool reloadBundle();
+    void loadBundleSlot(DataSlot &slot);
+    QString bundleImageUrl(const QString &name) const;
 
     QFileSystemWatcher *m_fileWatcher;
-    QTimer *m_delayTimer;
+    ClockTimer *m_delayTimer;
     QHash<QString, QDateTime> m_fileModificationTimes;
     QHash<QString, qint64> m_fileSizes;
-    QString m_pendingFile;
+    QSet<QString> m_pendingFiles;
+    QHash<QString, qint64> m_pendingSince;  // Path -> first unapplied event (m_latencyClock ns)
+    QElapsedTimer m_latencyClock;
+
+    QVector<DataSlot> m_slots;
+    QHash<QString, int> m_slotIndex;         // Slot name -> index in m_slots
+    QHash<QString, QList<int>> m_pathSlots;  // Watched file path -> active slots reading it
+    QHash<QString, QStringList> m_appSlots;  // Layer app -> slots it consumes
+    QSet<QString> m_activeApps;
+    QQmlPropertyMap *m_slotValues;
+    PlayerFeedModel *m_players;
+    PlayerFeedModel *m_leaderboard;
 
-    QVariantMap m_facilityData;
-    QVariantMap m_userData;
-    QString m_facilityName;
-    QVariantMap m_facilityColors;
     QString m_dataPath;
-    QString m_scrollUpperText;
-    QString m_scrollLowerText;
-    bool m_qrCodeAvailable;
-    bool m_facilityLogoIsGif;
-    QString m_textDaily;
-    QString m_textCount;
-    QString m_textRound;
+
+    // Bundle mode: one mapped file, one watched path
+    bool m_bundleMode;
+    mutable QMutex m_bundleMutex;
+    QSharedPointer<const ContentBundle> m_bundle;
+    quint64 m_bundleGeneration;  // Makes every swapped bundle's images new URLs
+};
+
+// image://bundle/<generation>/<entry name>, decoded from the mapped bundle
+class BundleImageProvider : public QQuickImageProvider
+{
+public:
+    explicit BundleImageProvider(DataManager *dataManager);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    DataManager *m_dataManager;
 };
 
 #endif // DATAMANAGER_H
@@ -0,0 +1,140 @@
+#include "displayrotation.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+#include <QDebug>
+
+DisplayRotation::DisplayRotation(QObject *parent)
+    : QObject(parent)
+    , m_rotate(0)
+    , m_requestedMode("auto")
+    , m_mode("none")
+    , m_contentRotation(0)
+    , m_offscreen(false)
+{
+    setScreen(QGuiApplication::primaryScreen());
+}
+
+bool DisplayRotation::isValidMode(const QString &mode)
+{
+    return mode == "auto" || mode == "platform" || mode == "offscreen" || mode == "transform";
+}
+
+void DisplayRotation::setConfig(int rotate, const QString &requestedMode, const QSize &contentSize)
+{
+    rotate = ((rotate % 360) + 360) % 360;
+    if (rotate % 90 != 0) {
+        qWarning() << "render_rotate must be 0, 90, 180 or 270, got" << rotate << "- ignoring";
+        rotate = 0;
+    }
+
+    QString mode = requestedMode.trimmed().toLower();
+    if (!isValidMode(mode)) {
+        qWarning() << "Unknown render_rotate_mode" << requestedMode << "- using auto";
+        mode = "auto";
+    }
+
+    m_rotate = rotate;
+    m_requestedMode = mode;
+    m_contentSize = contentSize;
+    update();
+}
+
+void DisplayRotation::setModeOverride(const QString &mode)
+{
+    if (!mode.isEmpty() && !isValidMode(mode)) {
+        qWarning() << "Unknown rotate mode override" << mode << "- ignoring";
+        return;
+    }
+
+    m_modeOverride = mode;
+    update();
+}
+
+void DisplayRotation::attach(QWindow *window)
+{
+    if (!window) {
+        return;
+    }
+
+    connect(window, &QWindow::screenChanged, this, &DisplayRotation::setScreen);
+    setScreen(window->screen());
+}
+
+void DisplayRotation::setScreen(QScreen *screen)
+{
+    if (m_screen == screen) {
+        return;
+    }
+
+    if (m_screen) {
+        disconnect(m_screen, nullptr, this, nullptr);
+    }
+
+    m_screen = screen;
+    if (m_screen) {
+        // xrandr / wlr-randr / hotplug can rotate the output while we run
+        connect(m_screen, &QScreen::geometryChanged, this, &DisplayRotation::update);
+        connect(m_screen, &QScreen::orientationChanged, this, &DisplayRotation::update);
+    }
+
+    update();
+}
+
+bool DisplayRotation::platformRotated() const
+{
+    if (!m_screen || m_rotate == 0) {
+        return false;
+    }
+
+    // Platforms that report orientation tell us the angle directly
+    Qt::ScreenOrientation native = m_screen->nativeOrientation();
+    Qt::ScreenOrientation current = m_screen->orientation();
+    if (native != Qt::PrimaryOrientation && current != Qt::PrimaryOrientation) {
+        int angle = m_screen->angleBetween(native, current);
+        return m_rotate == 180 ? angle == 180 : (angle == 90 || angle == 270);
+    }
+
+    // Otherwise (eglfs, most X11/Wayland outputs) a screen whose aspect already
+    // matches the unrotated content must have been rotated by the display stack.
+    // A 180 degree rotation cannot be detected this way.
+    if (m_rotate == 180 || m_contentSize.isEmpty()) {
+        return false;
+    }
+
+    QSize screenSize = m_screen->geometry().size();
+    if (screenSize.width() == screenSize.height() || m_contentSize.width() == m_contentSize.height()) {
+        return false;
+    }
+    return (screenSize.width() > screenSize.height()) == (m_contentSize.width() > m_contentSize.height());
+}
+
+void DisplayRotation::update()
+{
+    QString requested = m_modeOverride.isEmpty() ? m_requestedMode : m_modeOverride;
+
+    QString mode = requested;
+    if (m_rotate == 0) {
+        mode = "none";
+    } else if (requested == "auto") {
+        mode = platformRotated() ? "platform" : "offscreen";
+    } else if (requested == "platform" && !platformRotated()) {
+        qWarning() << "render_rotate_mode = platform but the output does not look rotated by"
+                   << m_rotate << "degrees - rotate it with the compositor/KMS (or xrandr)";
+    }
+
+    int contentRotation = (mode == "none" || mode == "platform") ? 0 : m_rotate;
+    bool offscreen = (mode == "offscreen");
+
+    if (mode == m_mode && contentRotation == m_contentRotation && offscreen == m_offscreen) {
+        return;
+    }
+
+    m_mode = mode;
+    m_contentRotation = contentRotation;
+    m_offscreen = offscreen;
+
+    qDebug() << "Display rotation:" << m_rotate << "degrees, mode" << m_mode
+             << "(requested" << requested << ") content rotation" << m_contentRotation;
+    emit changed();
+}
@@ -0,0 +1,66 @@
+#ifndef DISPLAYROTATION_H
+#define DISPLAYROTATION_H
+
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QSize>
+
+class QScreen;
+class QWindow;
+
+// Decides where [app_live] render_rotate is applied (render_rotate_mode):
+//   platform   the output is already rotated by the display stack (KMS plane
+//              rotation, compositor transform, xrandr); content is drawn upright
+//              and unrotated, text stays pixel aligned
+//   offscreen  contentContainer is rendered unrotated into a layer texture which
+//              is blitted once per frame with the rotation applied
+//   transform  the rotation is applied to the whole item tree (old behaviour)
+//   auto       platform when the screen reports the rotated geometry, offscreen otherwise
+class DisplayRotation : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString mode READ mode NOTIFY changed)
+    Q_PROPERTY(int contentRotation READ contentRotation NOTIFY changed)
+    Q_PROPERTY(bool swapsAxes READ swapsAxes NOTIFY changed)
+    Q_PROPERTY(bool offscreen READ offscreen NOTIFY changed)
+
+public:
+    explicit DisplayRotation(QObject *parent = nullptr);
+
+    // render_rotate (degrees), render_rotate_mode and the unrotated render_window size
+    void setConfig(int rotate, const QString &requestedMode, const QSize &contentSize);
+
+    // Command line --rotate-mode, wins over render_rotate_mode
+    void setModeOverride(const QString &mode);
+
+    // Follow the screen the window is on (initially the primary screen)
+    void attach(QWindow *window);
+
+    // Effective mode: "none" when render_rotate is 0
+    QString mode() const { return m_mode; }
+    int contentRotation() const { return m_contentRotation; }
+    bool swapsAxes() const { return m_contentRotation == 90 || m_contentRotation == 270; }
+    bool offscreen() const { return m_offscreen; }
+
+    static bool isValidMode(const QString &mode);
+
+signals:
+    void changed();
+
+private:
+    void setScreen(QScreen *screen);
+    bool platformRotated() const;
+    void update();
+
+    QPointer<QScreen> m_screen;
+    int m_rotate;
+    QSize m_contentSize;
+    QString m_requestedMode;
+    QString m_modeOverride;
+    QString m_mode;
+    int m_contentRotation;
+    bool m_offscreen;
+};
+
+#endif // DISPLAYROTATION_H
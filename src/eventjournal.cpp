@@ -0,0 +1,545 @@
+#include "eventjournal.h"
+#include "configmanager.h"
+#include "datamanager.h"
+#include <QTimer>
+#include <QFileInfo>
+#include <QEvent>
+#include <QMouseEvent>
+#include <QTouchEvent>
+#include <QKeyEvent>
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+
+const char kMagic[4] = { 'G', 'L', 'D', 'J' };
+const char kVersion = 1;
+
+// Files above this are journaled by hash only (large images)
+const qint64 kMaxBlobSize = 4 * 1024 * 1024;
+
+enum FileStateFlags {
+    FileExists = 0x01,
+    ContentStored = 0x02
+};
+
+// Sequential decoder over the journal bytes; sets ok = false on truncation
+struct Reader {
+    const QByteArray &data;
+    int pos = 0;
+    bool ok = true;
+
+    explicit Reader(const QByteArray &bytes) : data(bytes) {}
+
+    bool atEnd() const { return pos >= data.size(); }
+
+    quint8 byte()
+    {
+        if (pos >= data.size()) {
+            ok = false;
+            return 0;
+        }
+        return quint8(data.at(pos++));
+    }
+
+    quint64 varint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64 && ok; shift += 7) {
+            quint8 b = byte();
+            value |= quint64(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    qint64 signedVarint()
+    {
+        quint64 value = varint();
+        return qint64(value >> 1) ^ -qint64(value & 1);
+    }
+
+    quint64 hash()
+    {
+        if (pos + 8 > data.size()) {
+            ok = false;
+            return 0;
+        }
+        quint64 value = qFromLittleEndian<quint64>(data.constData() + pos);
+        pos += 8;
+        return value;
+    }
+
+    QByteArray bytes()
+    {
+        quint64 size = varint();
+        if (!ok || size > quint64(data.size() - pos)) {
+            ok = false;
+            return QByteArray();
+        }
+        QByteArray value = data.mid(pos, int(size));
+        pos += int(size);
+        return value;
+    }
+};
+
+// Journal paths are absolute so a replay does not depend on the working directory
+QString absolute(const QString &path)
+{
+    return QFileInfo(path).absoluteFilePath();
+}
+
+QString changeValue(const QVariant &value)
+{
+    // Comma lists come back from QSettings as string lists
+    if (value.userType() == QMetaType::QStringList) {
+        return value.toStringList().join(QLatin1Char(','));
+    }
+    return value.toString();
+}
+
+} // namespace
+
+EventJournal::EventJournal(QObject *parent)
+    : QObject(parent)
+    , m_flushTimer(new QTimer(this))
+    , m_lastTimeUs(0)
+{
+    // Buffered; at most a second of events is lost if the process dies
+    m_flushTimer->setInterval(1000);
+    connect(m_flushTimer, &QTimer::timeout, this, [this]() {
+        if (m_file.isOpen() && !m_buffer.isEmpty()) {
+            m_file.write(m_buffer);
+            m_file.flush();
+            m_buffer.clear();
+        }
+    });
+}
+
+EventJournal::~EventJournal()
+{
+    close();
+}
+
+bool EventJournal::open(const QString &filePath)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open event journal:" << filePath << m_file.errorString();
+        return false;
+    }
+
+    m_file.write(kMagic, sizeof(kMagic));
+    m_file.write(&kVersion, 1);
+
+    m_strings.clear();
+    m_blobs.clear();
+    m_fileHashes.clear();
+    m_lastTimeUs = 0;
+    m_clock.start();
+    m_flushTimer->start();
+
+    qDebug() << "Recording event journal to:" << filePath;
+    return true;
+}
+
+void EventJournal::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    m_flushTimer->stop();
+    m_file.write(m_buffer);
+    m_buffer.clear();
+    m_file.close();
+}
+
+void EventJournal::attach(ConfigManager *configManager, DataManager *dataManager)
+{
+    connect(configManager, &ConfigManager::fileEventReceived, this, [this](const QString &path) {
+        recordWatcherEvent(ConfigFile, path);
+    });
+    connect(configManager, &ConfigManager::sourceReloaded, this,
+            [this](const QString &path, const QVariantMap &changes) {
+        recordFileState(ConfigFile, path);
+        recordConfigDiff(path, changes);
+    });
+
+    connect(dataManager, &DataManager::fileEventReceived, this, [this](const QString &path) {
+        recordWatcherEvent(DataFile, path);
+    });
+    connect(dataManager, &DataManager::slotReloaded, this, &EventJournal::recordDataReload);
+}
+
+void EventJournal::attachInput(QObject *window)
+{
+    window->installEventFilter(this);
+}
+
+void EventJournal::recordSession(const QString &configPath, const QString &dataPath)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    int configId = stringId(absolute(configPath));
+    int dataId = stringId(absolute(dataPath));
+    beginRecord(SessionRecord);
+    writeVarint(configId);
+    writeVarint(dataId);
+}
+
+void EventJournal::recordStarted()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    beginRecord(StartedRecord);
+}
+
+bool EventJournal::eventFilter(QObject *watched, QEvent *event)
+{
+    if (!isOpen()) {
+        return QObject::eventFilter(watched, event);
+    }
+
+    QPointF position;
+    int code = 0;
+    bool record = true;
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        // Hover moves are noise for replay, drags are not
+        record = event->type() != QEvent::MouseMove || mouseEvent->buttons() != Qt::NoButton;
+        position = mouseEvent->position();
+        code = int(event->type() == QEvent::MouseMove ? mouseEvent->buttons() : mouseEvent->button());
+        break;
+    }
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd: {
+        QTouchEvent *touchEvent = static_cast<QTouchEvent *>(event);
+        record = !touchEvent->points().isEmpty();
+        if (record) {
+            position = touchEvent->points().first().position();
+            code = int(touchEvent->pointCount());
+        }
+        break;
+    }
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+        code = static_cast<QKeyEvent *>(event)->key();
+        break;
+    default:
+        record = false;
+        break;
+    }
+
+    if (record) {
+        // Quarter-pixel resolution is plenty for hit testing
+        beginRecord(InputRecord);
+        writeVarint(quint64(event->type()));
+        writeSignedVarint(qRound64(position.x() * 4));
+        writeSignedVarint(qRound64(position.y() * 4));
+        writeVarint(quint64(code));
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void EventJournal::recordWatcherEvent(int kind, const QString &path)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    int pathId = stringId(absolute(path));
+    beginRecord(WatcherRecord);
+    writeVarint(quint64(kind));
+    writeVarint(pathId);
+}
+
+void EventJournal::recordFileState(int kind, const QString &filePath)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    QString path = absolute(filePath);
+    QFile file(path);
+    quint64 hash = 0;
+    QByteArray content;
+    bool storable = false;
+    if (file.open(QIODevice::ReadOnly)) {
+        content = file.readAll();
+        hash = contentHash(content);
+        storable = content.size() <= kMaxBlobSize;
+    }
+
+    // Unchanged since the last record (e.g. a rewrite with the same bytes)
+    auto last = m_fileHashes.constFind(path);
+    if (last != m_fileHashes.constEnd() && last.value() == hash) {
+        return;
+    }
+    m_fileHashes.insert(path, hash);
+
+    if (hash != 0 && storable && !m_blobs.contains(hash)) {
+        m_blobs.insert(hash);
+        beginRecord(BlobRecord);
+        writeHash(hash);
+        writeBytes(content);
+    }
+
+    quint8 flags = 0;
+    if (hash != 0) {
+        flags |= FileExists;
+        if (m_blobs.contains(hash)) {
+            flags |= ContentStored;
+        }
+    }
+
+    int pathId = stringId(path);
+    beginRecord(FileStateRecord);
+    writeVarint(quint64(kind));
+    writeVarint(pathId);
+    m_buffer.append(char(flags));
+    if (hash != 0) {
+        writeHash(hash);
+    }
+}
+
+void EventJournal::recordConfigDiff(const QString &path, const QVariantMap &changes)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    QList<int> keyIds;
+    for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+        keyIds.append(stringId(it.key()));
+    }
+
+    int pathId = stringId(absolute(path));
+    beginRecord(ConfigDiffRecord);
+    writeVarint(pathId);
+    writeVarint(quint64(changes.size()));
+    int i = 0;
+    for (auto it = changes.constBegin(); it != changes.constEnd(); ++it, ++i) {
+        writeVarint(keyIds.at(i));
+        m_buffer.append(char(it.value().isValid() ? 1 : 0));
+        if (it.value().isValid()) {
+            writeBytes(changeValue(it.value()).toUtf8());
+        }
+    }
+}
+
+void EventJournal::recordDataReload(const QString &slot, const QStringList &filePaths)
+{
+    if (!isOpen() || filePaths.isEmpty()) {
+        return;
+    }
+
+    for (const QString &path : filePaths) {
+        recordFileState(DataFile, path);
+    }
+
+    // The candidate the slot actually reads is the first one present
+    QString loadedPath = absolute(filePaths.first());
+    for (const QString &path : filePaths) {
+        if (m_fileHashes.value(absolute(path)) != 0) {
+            loadedPath = absolute(path);
+            break;
+        }
+    }
+
+    int slotId = stringId(slot);
+    int pathId = stringId(loadedPath);
+    beginRecord(DataReloadRecord);
+    writeVarint(slotId);
+    writeVarint(pathId);
+    writeHash(m_fileHashes.value(loadedPath));
+}
+
+quint64 EventJournal::contentHash(const QByteArray &content)
+{
+    if (content.isEmpty()) {
+        return 1;  // Present but empty; 0 means the file is missing
+    }
+
+    QByteArray digest = QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+    quint64 hash = qFromLittleEndian<quint64>(digest.constData());
+    return hash > 1 ? hash : 2;
+}
+
+void EventJournal::beginRecord(RecordType type)
+{
+    qint64 now = m_clock.nsecsElapsed() / 1000;
+    m_buffer.append(char(type));
+    writeVarint(quint64(qMax<qint64>(0, now - m_lastTimeUs)));
+    m_lastTimeUs = qMax(now, m_lastTimeUs);
+
+    if (m_buffer.size() > 64 * 1024) {
+        m_file.write(m_buffer);
+        m_buffer.clear();
+    }
+}
+
+int EventJournal::stringId(const QString &value)
+{
+    auto it = m_strings.constFind(value);
+    if (it != m_strings.constEnd()) {
+        return it.value();
+    }
+
+    int id = m_strings.size();
+    m_strings.insert(value, id);
+    beginRecord(StringRecord);
+    writeBytes(value.toUtf8());
+    return id;
+}
+
+void EventJournal::writeVarint(quint64 value)
+{
+    while (value >= 0x80) {
+        m_buffer.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    m_buffer.append(char(value));
+}
+
+void EventJournal::writeSignedVarint(qint64 value)
+{
+    // Zigzag so small negative coordinates stay small
+    writeVarint((quint64(value) << 1) ^ quint64(value >> 63));
+}
+
+void EventJournal::writeHash(quint64 hash)
+{
+    char bytes[8];
+    qToLittleEndian(hash, bytes);
+    m_buffer.append(bytes, 8);
+}
+
+void EventJournal::writeBytes(const QByteArray &bytes)
+{
+    writeVarint(quint64(bytes.size()));
+    m_buffer.append(bytes);
+}
+
+bool EventJournal::read(const QString &filePath, QList<Record> *records, QString *error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    if (data.size() < 5 || !data.startsWith(QByteArray(kMagic, sizeof(kMagic))) || data.at(4) != kVersion) {
+        if (error) *error = "Not a GLADIS event journal (or unsupported version)";
+        return false;
+    }
+
+    Reader reader(data);
+    reader.pos = 5;
+
+    QStringList strings;
+    QHash<quint64, QByteArray> blobs;
+    qint64 timeUs = 0;
+
+    auto string = [&strings, &reader]() {
+        quint64 id = reader.varint();
+        if (id >= quint64(strings.size())) {
+            reader.ok = false;
+            return QString();
+        }
+        return strings.at(int(id));
+    };
+
+    while (reader.ok && !reader.atEnd()) {
+        Record record;
+        record.type = RecordType(reader.byte());
+        timeUs += qint64(reader.varint());
+        record.timeUs = timeUs;
+
+        switch (record.type) {
+        case StringRecord:
+            strings.append(QString::fromUtf8(reader.bytes()));
+            continue;
+        case BlobRecord: {
+            quint64 hash = reader.hash();
+            blobs.insert(hash, reader.bytes());
+            continue;
+        }
+        case FileStateRecord: {
+            record.kind = int(reader.varint());
+            record.path = string();
+            quint8 flags = reader.byte();
+            record.exists = flags & FileExists;
+            record.hash = record.exists ? reader.hash() : 0;
+            record.hasContent = flags & ContentStored;
+            if (record.hasContent) {
+                record.content = blobs.value(record.hash);
+            }
+            break;
+        }
+        case WatcherRecord:
+            record.kind = int(reader.varint());
+            record.path = string();
+            break;
+        case ConfigDiffRecord: {
+            record.path = string();
+            quint64 count = reader.varint();
+            for (quint64 i = 0; i < count && reader.ok; i++) {
+                QString key = string();
+                bool present = reader.byte() != 0;
+                record.changes.insert(key, present ? QVariant(QString::fromUtf8(reader.bytes())) : QVariant());
+            }
+            break;
+        }
+        case DataReloadRecord:
+            record.name = string();
+            record.path = string();
+            record.hash = reader.hash();
+            break;
+        case InputRecord: {
+            record.kind = int(reader.varint());
+            qreal x = reader.signedVarint() / 4.0;
+            qreal y = reader.signedVarint() / 4.0;
+            record.position = QPointF(x, y);
+            record.code = int(reader.varint());
+            break;
+        }
+        case SessionRecord:
+            record.path = string();
+            record.name = string();
+            break;
+        case StartedRecord:
+            break;
+        default:
+            reader.ok = false;
+            break;
+        }
+
+        if (reader.ok) {
+            records->append(record);
+        }
+    }
+
+    if (!reader.ok) {
+        // A journal cut short by a crash is still useful up to the damage
+        qWarning() << "Event journal truncated or corrupt at byte" << reader.pos << "in" << filePath;
+    }
+
+    return true;
+}
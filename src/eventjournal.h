@@ -0,0 +1,107 @@
+#ifndef EVENTJOURNAL_H
+#define EVENTJOURNAL_H
+
+#include <QObject>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QPointF>
+#include <QVariantMap>
+
+class QTimer;
+class ConfigManager;
+class DataManager;
+
+// Compact binary log of everything that drives the display from outside:
+// watcher notifications, config diffs, data reloads and input events, each
+// stamped with a monotonic time. Changed file contents are stored once per
+// distinct content hash so JournalReplayer can reproduce the sequence.
+//
+// File layout: "GLDJ" + version byte, then records of
+//   type (1 byte) | time delta in microseconds (varint) | payload
+// Strings (paths, keys, slot names) are interned and referenced by id.
+class EventJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum RecordType {
+        StringRecord = 1,   // Defines the next string id
+        BlobRecord,         // Content for a hash
+        FileStateRecord,    // File content (hash) or removal
+        WatcherRecord,      // Raw QFileSystemWatcher notification
+        ConfigDiffRecord,   // Keys changed by a config source
+        DataReloadRecord,   // Data slot reloaded
+        InputRecord,        // Mouse/touch/key event on the window
+        SessionRecord,      // Config and data paths of the recording
+        StartedRecord       // End of startup, the event loop is running
+    };
+
+    enum FileKind {
+        ConfigFile = 0,
+        DataFile = 1
+    };
+
+    // Decoded record, as returned by read()
+    struct Record {
+        RecordType type = StringRecord;
+        qint64 timeUs = 0;          // Since the start of the recording
+        int kind = 0;               // FileKind, or QEvent::Type for input
+        QString path;               // File/watched path, config path for sessions
+        QString name;               // Slot name, data path for sessions
+        quint64 hash = 0;
+        bool exists = false;
+        bool hasContent = false;
+        QByteArray content;
+        QVariantMap changes;        // Config diff: key -> value ("" and invalid = removed)
+        QPointF position;
+        int code = 0;               // Mouse button (buttons for moves), touch point count or key
+    };
+
+    explicit EventJournal(QObject *parent = nullptr);
+    ~EventJournal();
+
+    bool open(const QString &filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void attach(ConfigManager *configManager, DataManager *dataManager);
+    void attachInput(QObject *window);
+
+    void recordSession(const QString &configPath, const QString &dataPath);
+    void recordStarted();
+
+    // Parse a whole journal, blobs resolved into FileState records
+    static bool read(const QString &filePath, QList<Record> *records, QString *error = nullptr);
+
+    static quint64 contentHash(const QByteArray &content);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void recordWatcherEvent(int kind, const QString &path);
+    void recordFileState(int kind, const QString &filePath);
+    void recordConfigDiff(const QString &path, const QVariantMap &changes);
+    void recordDataReload(const QString &slot, const QStringList &filePaths);
+
+    void beginRecord(RecordType type);
+    int stringId(const QString &value);
+    void writeVarint(quint64 value);
+    void writeSignedVarint(qint64 value);
+    void writeHash(quint64 hash);
+    void writeBytes(const QByteArray &bytes);
+
+    QFile m_file;
+    QByteArray m_buffer;
+    QTimer *m_flushTimer;
+    QElapsedTimer m_clock;
+    qint64 m_lastTimeUs;
+    QHash<QString, int> m_strings;
+    QSet<quint64> m_blobs;                  // Hashes whose content is already in the file
+    QHash<QString, quint64> m_fileHashes;   // Last recorded state per path (0 = missing)
+};
+
+#endif // EVENTJOURNAL_H
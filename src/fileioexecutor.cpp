@@ -0,0 +1,173 @@
+#include "fileioexecutor.h"
+#include "metrics.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QMutexLocker>
+#include <QDebug>
+
+FileIOExecutor::FileIOExecutor(QObject *parent)
+    : QObject(parent)
+    , m_pool(new QThreadPool(this))
+    , m_nextRequestId(1)
+    , m_coalescedWrites(0)
+{
+    // Button and alert files are tiny, two threads are enough to keep one slow
+    // path (e.g. a stalled SD card) from blocking writes to /dev/shm
+    m_pool->setMaxThreadCount(2);
+    m_pool->setExpiryTimeout(30000);
+}
+
+FileIOExecutor::~FileIOExecutor()
+{
+    // Let queued writes reach the disk before the helper goes away
+    m_pool->waitForDone();
+}
+
+quint64 FileIOExecutor::submit(Operation op, const QString &filePath, const QString &content)
+{
+    QMutexLocker locker(&m_mutex);
+
+    quint64 requestId = m_nextRequestId++;
+    PathQueue &queue = m_queues[filePath];
+
+    // Coalesce with a write that is queued (not yet running) for the same path
+    if (op == Write && !queue.pending.isEmpty()) {
+        PendingOp &last = queue.pending.last();
+        if (last.op == Write) {
+            last.content = content;
+            last.requestIds.append(requestId);
+            m_coalescedWrites++;
+            Metrics::instance()->increment("gladis_fileio_writes_coalesced_total");
+            return requestId;
+        }
+    }
+
+    PendingOp pending;
+    pending.op = op;
+    pending.content = content;
+    pending.requestIds.append(requestId);
+    queue.pending.append(pending);
+
+    if (!queue.running) {
+        startNextLocked(filePath);
+    }
+
+    return requestId;
+}
+
+int FileIOExecutor::coalescedWrites() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_coalescedWrites;
+}
+
+void FileIOExecutor::startNextLocked(const QString &filePath)
+{
+    PathQueue &queue = m_queues[filePath];
+    if (queue.pending.isEmpty()) {
+        m_queues.remove(filePath);
+        return;
+    }
+
+    PendingOp op = queue.pending.takeFirst();
+    queue.running = true;
+
+    m_pool->start([this, filePath, op]() {
+        runOp(filePath, op);
+    });
+}
+
+void FileIOExecutor::runOp(const QString &filePath, const PendingOp &op)
+{
+    QVariant result;
+    switch (op.op) {
+    case Write:
+        result = writeNow(filePath, op.content);
+        break;
+    case Read:
+        result = readNow(filePath);
+        break;
+    case Delete:
+        result = deleteNow(filePath);
+        break;
+    case Exists:
+        result = existsNow(filePath);
+        break;
+    }
+
+    // Before the next op for this path can start, so callbacks arrive in submission order
+    for (quint64 requestId : op.requestIds) {
+        emit finished(requestId, op.op, filePath, result);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_queues[filePath].running = false;
+    startNextLocked(filePath);
+}
+
+bool FileIOExecutor::writeNow(const QString &filePath, const QString &content)
+{
+    QFile file(filePath);
+
+    // Ensure directory exists
+    QFileInfo fileInfo(filePath);
+    QDir dir = fileInfo.absoluteDir();
+    if (!dir.exists()) {
+        if (!dir.mkpath(".")) {
+            qWarning() << "Failed to create directory for file:" << filePath;
+            return false;
+        }
+    }
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Failed to open file for writing:" << filePath << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << content;
+    file.close();
+
+    qDebug() << "Wrote file:" << filePath;
+    return true;
+}
+
+QString FileIOExecutor::readNow(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Failed to open file for reading:" << filePath;
+        return QString();
+    }
+
+    QTextStream in(&file);
+    QString content = in.readAll();
+    file.close();
+
+    return content;
+}
+
+bool FileIOExecutor::deleteNow(const QString &filePath)
+{
+    if (!QFile::exists(filePath)) {
+        return false;
+    }
+
+    bool success = QFile::remove(filePath);
+    if (success) {
+        qDebug() << "Deleted file:" << filePath;
+    } else {
+        qWarning() << "Failed to delete file:" << filePath;
+    }
+
+    return success;
+}
+
+bool FileIOExecutor::existsNow(const QString &filePath)
+{
+    return QFile::exists(filePath);
+}
@@ -0,0 +1,70 @@
+#ifndef FILEIOEXECUTOR_H
+#define FILEIOEXECUTOR_H
+
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+class QThreadPool;
+
+// Small I/O thread pool used by FileIOHelper's async API.
+// Operations on the same path run strictly in submission order; operations on
+// different paths run in parallel. A write queued behind another pending write
+// to the same path replaces it (write coalescing), and both requests complete
+// with the result of the single write that actually hits the disk.
+class FileIOExecutor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Operation {
+        Write,
+        Read,
+        Delete,
+        Exists
+    };
+
+    explicit FileIOExecutor(QObject *parent = nullptr);
+    ~FileIOExecutor();
+
+    // Queue an operation, returns the request id reported back in finished()
+    quint64 submit(Operation op, const QString &filePath, const QString &content = QString());
+
+    int coalescedWrites() const;
+
+    // Blocking implementations, shared with FileIOHelper's synchronous API
+    static bool writeNow(const QString &filePath, const QString &content);
+    static QString readNow(const QString &filePath);
+    static bool deleteNow(const QString &filePath);
+    static bool existsNow(const QString &filePath);
+
+signals:
+    // Emitted from a pool thread; receivers in the GUI thread get it queued
+    void finished(quint64 requestId, int operation, const QString &filePath, const QVariant &result);
+
+private:
+    struct PendingOp {
+        Operation op;
+        QString content;
+        QList<quint64> requestIds;
+    };
+
+    struct PathQueue {
+        QList<PendingOp> pending;
+        bool running = false;
+    };
+
+    void startNextLocked(const QString &filePath);
+    void runOp(const QString &filePath, const PendingOp &op);
+
+    QThreadPool *m_pool;
+    mutable QMutex m_mutex;
+    QHash<QString, PathQueue> m_queues;
+    quint64 m_nextRequestId;
+    int m_coalescedWrites;
+};
+
+#endif // FILEIOEXECUTOR_H
@@ -1,20 +1,26 @@
 #include "fileiohelper.h"
+#include "fileioexecutor.h"
+#include "virtualclock.h"
+#include "metrics.h"
 #include <QFile>
-#include <QTextStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QUrl>
 #include <QDebug>
-#include <QTimer>
-#include <QDir>
 
 FileIOHelper::FileIOHelper(QObject *parent)
     : QObject(parent)
     , m_watcher(new QFileSystemWatcher(this))
-    , m_checkTimer(new QTimer(this))
+    , m_checkTimer(new ClockTimer(this))
+    , m_executor(new FileIOExecutor(this))
 {
     connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &FileIOHelper::onFileChanged);
+    connect(m_executor, &FileIOExecutor::finished, this, &FileIOHelper::onAsyncFinished,
+            Qt::QueuedConnection);
 
     // Timer to periodically check for files that don't exist yet
     m_checkTimer->setInterval(500);  // Check every 500ms
-    connect(m_checkTimer, &QTimer::timeout, this, &FileIOHelper::checkForNewFiles);
+    connect(m_checkTimer, &ClockTimer::timeout, this, &FileIOHelper::checkForNewFiles);
     m_checkTimer->start();
 }
 
@@ -24,66 +30,88 @@ FileIOHelper::~FileIOHelper()
 
 bool FileIOHelper::writeFile(const QString &filePath, const QString &content)
 {
-    QFile file(filePath);
+    return FileIOExecutor::writeNow(filePath, content);
+}
 
-    // Ensure directory exists
-    QFileInfo fileInfo(filePath);
-    QDir dir = fileInfo.absoluteDir();
-    if (!dir.exists()) {
-        if (!dir.mkpath(".")) {
-            qWarning() << "Failed to create directory for file:" << filePath;
-            return false;
-        }
-    }
+bool FileIOHelper::fileExists(const QString &filePath)
+{
+    return FileIOExecutor::existsNow(filePath);
+}
 
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file for writing:" << filePath << file.errorString();
-        return false;
+QString FileIOHelper::cacheUrl(const QString &path) const
+{
+    if (path.isEmpty() || path.startsWith("qrc:")) {
+        return path;
     }
 
-    QTextStream out(&file);
-    out << content;
-    file.close();
+    QString localPath = path.startsWith("file:") ? QUrl(path).toLocalFile() : path;
+    QUrl url = QUrl::fromLocalFile(localPath);
+    QFileInfo info(localPath);
+    if (info.exists()) {
+        url.setQuery("v=" + QString::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+    return url.toString();
+}
 
-    qDebug() << "Wrote file:" << filePath;
-    return true;
+bool FileIOHelper::deleteFile(const QString &filePath)
+{
+    return FileIOExecutor::deleteNow(filePath);
 }
 
-bool FileIOHelper::fileExists(const QString &filePath)
+QString FileIOHelper::readFile(const QString &filePath)
 {
-    return QFile::exists(filePath);
+    return FileIOExecutor::readNow(filePath);
 }
 
-bool FileIOHelper::deleteFile(const QString &filePath)
+void FileIOHelper::writeFileAsync(const QString &filePath, const QString &content, const QJSValue &callback)
 {
-    if (!QFile::exists(filePath)) {
-        return false;
+    quint64 requestId = m_executor->submit(FileIOExecutor::Write, filePath, content);
+    if (callback.isCallable()) {
+        m_callbacks.insert(requestId, callback);
     }
+}
 
-    bool success = QFile::remove(filePath);
-    if (success) {
-        qDebug() << "Deleted file:" << filePath;
-    } else {
-        qWarning() << "Failed to delete file:" << filePath;
+void FileIOHelper::fileExistsAsync(const QString &filePath, const QJSValue &callback)
+{
+    quint64 requestId = m_executor->submit(FileIOExecutor::Exists, filePath);
+    if (callback.isCallable()) {
+        m_callbacks.insert(requestId, callback);
     }
+}
 
-    return success;
+void FileIOHelper::deleteFileAsync(const QString &filePath, const QJSValue &callback)
+{
+    quint64 requestId = m_executor->submit(FileIOExecutor::Delete, filePath);
+    if (callback.isCallable()) {
+        m_callbacks.insert(requestId, callback);
+    }
 }
 
-QString FileIOHelper::readFile(const QString &filePath)
+void FileIOHelper::readFileAsync(const QString &filePath, const QJSValue &callback)
 {
-    QFile file(filePath);
+    quint64 requestId = m_executor->submit(FileIOExecutor::Read, filePath);
+    if (callback.isCallable()) {
+        m_callbacks.insert(requestId, callback);
+    }
+}
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file for reading:" << filePath;
-        return QString();
+void FileIOHelper::onAsyncFinished(quint64 requestId, int operation, const QString &filePath, const QVariant &result)
+{
+    if (operation == FileIOExecutor::Write) {
+        emit writeFinished(filePath, result.toBool());
     }
 
-    QTextStream in(&file);
-    QString content = in.readAll();
-    file.close();
+    QJSValue callback = m_callbacks.take(requestId);
+    if (!callback.isCallable()) {
+        return;
+    }
 
-    return content;
+    QJSValue value = (operation == FileIOExecutor::Read) ? QJSValue(result.toString())
+                                                         : QJSValue(result.toBool());
+    QJSValue ret = callback.call({ value });
+    if (ret.isError()) {
+        qWarning() << "FileIOHelper: async callback failed for" << filePath << ":" << ret.toString();
+    }
 }
 
 void FileIOHelper::watchFile(const QString &filePath)
@@ -118,6 +146,7 @@ void FileIOHelper::unwatchFile(const QString &filePath)
 void FileIOHelper::onFileChanged(const QString &path)
 {
     qDebug() << "File changed:" << path;
+    Metrics::instance()->increment("gladis_watcher_events_total", "source=\"fileio\",kind=\"file\"");
 
     // Re-add to watcher (some systems remove it after change)
     if (!m_watcher->files().contains(path) && QFile::exists(path)) {
@@ -4,7 +4,12 @@
 #include <QObject>
 #include <QString>
 #include <QFileSystemWatcher>
-#include <QTimer>
+#include <QHash>
+#include <QJSValue>
+#include <QVariant>
+
+class FileIOExecutor;
+class ClockTimer;
 
 class FileIOHelper : public QObject
 {
@@ -26,6 +31,20 @@ public:
     // Read file content
     Q_INVOKABLE QString readFile(const QString &filePath);
 
+    // URL of a local image for Image.source with its modification time as query,
+    // so Qt's image cache can be on: a rewritten file gets a new cache entry.
+    // qrc: URLs are returned unchanged.
+    Q_INVOKABLE QString cacheUrl(const QString &path) const;
+
+    // Asynchronous variants - run on the I/O pool, ordered per path.
+    // The optional callback is invoked on the GUI thread with the result
+    // (bool for write/delete/exists, string for read).
+    Q_INVOKABLE void writeFileAsync(const QString &filePath, const QString &content,
+                                    const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void fileExistsAsync(const QString &filePath, const QJSValue &callback);
+    Q_INVOKABLE void deleteFileAsync(const QString &filePath, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void readFileAsync(const QString &filePath, const QJSValue &callback);
+
     // Watch a file for changes
     Q_INVOKABLE void watchFile(const QString &filePath);
 
@@ -35,14 +54,18 @@ public:
 signals:
     void fileChanged(const QString &filePath);
     void fileAppeared(const QString &filePath);
+    void writeFinished(const QString &filePath, bool success);
 
 private slots:
     void onFileChanged(const QString &path);
+    void onAsyncFinished(quint64 requestId, int operation, const QString &filePath, const QVariant &result);
 
 private:
     QFileSystemWatcher *m_watcher;
-    QTimer *m_checkTimer;
+    ClockTimer *m_checkTimer;
     QStringList m_watchedFiles;
+    FileIOExecutor *m_executor;
+    QHash<quint64, QJSValue> m_callbacks;
 
     void checkForNewFiles();
 };
@@ -0,0 +1,347 @@
+#include "framesnapshot.h"
+#include "metrics.h"
+#include <QQuickWindow>
+#include <QTimer>
+#include <QThreadPool>
+#include <QImage>
+#include <QImageWriter>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#endif
+#if QT_CONFIG(opengl)
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#endif
+
+FrameSnapshot::FrameSnapshot(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_timer(new QTimer(this))
+    , m_pool(new QThreadPool(this))
+    , m_width(320)
+    , m_paused(false)
+    , m_captureRequested(0)
+    , m_inFlight(0)
+    , m_overheadNs(0)
+    , m_frameCount(0)
+    , m_issueFrame(0)
+    , m_mirrored(false)
+    , m_pbo(0)
+    , m_fence(nullptr)
+    , m_glWarned(false)
+{
+    m_clock.start();
+    m_pool->setMaxThreadCount(1);
+    connect(m_timer, &QTimer::timeout, this, &FrameSnapshot::requestCapture);
+
+    Metrics::instance()->describe("gladis_snapshot_captures_total", Metrics::Counter, "Frame snapshots written");
+    Metrics::instance()->describe("gladis_snapshot_errors_total", Metrics::Counter, "Frame snapshots that could not be written");
+    Metrics::instance()->describe("gladis_snapshot_frame_overhead_seconds", Metrics::Histogram,
+                                  "Render thread time spent recording a capture's readback and collecting its pixels");
+    Metrics::instance()->describe("gladis_snapshot_encode_seconds", Metrics::Histogram, "Snapshot scaling and encoding (worker thread)");
+    Metrics::instance()->describe("gladis_snapshot_readback_frames", Metrics::Gauge, "Frames between recording the readback and getting the pixels");
+}
+
+FrameSnapshot::~FrameSnapshot()
+{
+    m_pool->waitForDone();
+}
+
+void FrameSnapshot::attach(QQuickWindow *window)
+{
+    m_window = window;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    connect(window, &QQuickWindow::afterRendering, this, &FrameSnapshot::onAfterRendering,
+            Qt::DirectConnection);
+    connect(window, &QQuickWindow::frameSwapped, this, &FrameSnapshot::onFrameSwapped,
+            Qt::DirectConnection);
+    // The GL context is current here, the pixel buffer goes with it
+    connect(window, &QQuickWindow::sceneGraphInvalidated, this, &FrameSnapshot::onSceneGraphInvalidated,
+            Qt::DirectConnection);
+#endif
+}
+
+void FrameSnapshot::configure(const QString &path, int intervalSeconds, int width)
+{
+    m_path = path;
+    m_width = qMax(16, width);
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 6, 0)
+    if (!m_path.isEmpty()) {
+        qWarning() << "Frame snapshot: needs Qt 6.6 or newer, frame_snapshot ignored";
+    }
+    m_path.clear();
+#endif
+
+    if (m_path.isEmpty() || !m_window) {
+        m_timer->stop();
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    int intervalMs = qMax(1, intervalSeconds) * 1000;
+    if (!m_timer->isActive() || m_timer->interval() != intervalMs) {
+        m_timer->start(intervalMs);
+        qDebug() << "Frame snapshot:" << m_path << "every" << intervalMs / 1000 << "s," << m_width << "px wide";
+    }
+}
+
+void FrameSnapshot::setPaused(bool paused)
+{
+    m_paused = paused;
+}
+
+void FrameSnapshot::requestCapture()
+{
+    if (m_paused || m_path.isEmpty() || !m_window || !m_inFlight.testAndSetAcquire(0, 1)) {
+        return;
+    }
+
+    m_captureRequested.storeRelease(1);
+    // A static scene renders nothing on its own
+    m_window->update();
+}
+
+void FrameSnapshot::requestFrame()
+{
+    // Render thread: the pixels are collected with a later frame, which a
+    // static scene would never render
+    QMetaObject::invokeMethod(m_window, "update", Qt::QueuedConnection);
+}
+
+void FrameSnapshot::onAfterRendering()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    QRhi *rhi = m_window->rhi();
+    if (!rhi) {
+        return;
+    }
+    const bool openGL = rhi->backend() == QRhi::OpenGLES2;
+    if (openGL && m_fence) {
+        pollGLReadback();
+    }
+
+    if (!m_captureRequested.testAndSetAcquire(1, 0)) {
+        return;
+    }
+
+    QRhiSwapChain *swapChain = m_window->swapChain();
+    if (!swapChain) {
+        m_inFlight.storeRelease(0);
+        return;
+    }
+
+    const qint64 startNs = m_clock.nsecsElapsed();
+    m_mirrored = rhi->isYUpInFramebuffer();
+    m_issueFrame = m_frameCount;
+    m_overheadNs = 0;
+
+    if (openGL) {
+        if (!issueGLReadback(swapChain->currentPixelSize())) {
+            m_inFlight.storeRelease(0);
+            return;
+        }
+    } else {
+        // An empty description reads the backbuffer once the frame's passes are done;
+        // the result is owned by its own completion callback
+        QRhiReadbackResult *result = new QRhiReadbackResult;
+        result->completed = [this, result]() {
+            const bool bgra = result->format == QRhiTexture::BGRA8;
+            onReadbackCompleted(result->data, result->pixelSize, bgra);
+            delete result;
+        };
+
+        QRhiResourceUpdateBatch *batch = rhi->nextResourceUpdateBatch();
+        batch->readBackTexture(QRhiReadbackDescription(), result);
+        swapChain->currentFrameCommandBuffer()->resourceUpdate(batch);
+    }
+
+    m_overheadNs += m_clock.nsecsElapsed() - startNs;
+    requestFrame();
+#endif
+}
+
+bool FrameSnapshot::issueGLReadback(const QSize &size)
+{
+#if QT_CONFIG(opengl) && QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    // Pixel pack buffers, fences and buffer mapping are GLES 3.0 / OpenGL 3.0
+    if (!context || context->format().majorVersion() < 3) {
+        if (!m_glWarned) {
+            m_glWarned = true;
+            qWarning() << "Frame snapshot: needs GLES 3.0 / OpenGL 3.0 for an asynchronous readback,"
+                       << "frame_snapshot ignored";
+        }
+        return false;
+    }
+
+    QOpenGLExtraFunctions *gl = context->extraFunctions();
+    m_window->beginExternalCommands();
+
+    if (!m_pbo) {
+        gl->glGenBuffers(1, &m_pbo);
+    }
+    gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo);
+    if (m_pboSize != size) {
+        gl->glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(size.width()) * size.height() * 4, nullptr, GL_STREAM_READ);
+        m_pboSize = size;
+    }
+
+    // Into the buffer, not client memory: returns without waiting for the frame
+    gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, context->defaultFramebufferObject());
+    gl->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    gl->glReadPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_fence = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_window->endExternalCommands();
+    return m_fence != nullptr;
+#else
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+void FrameSnapshot::pollGLReadback()
+{
+    // A later frame than the one that recorded the readback: never waits, the
+    // fence is only asked whether it has passed
+#if QT_CONFIG(opengl) && QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    QOpenGLExtraFunctions *gl = QOpenGLContext::currentContext()->extraFunctions();
+    const qint64 startNs = m_clock.nsecsElapsed();
+    m_window->beginExternalCommands();
+
+    GLsync fence = static_cast<GLsync>(m_fence);
+    const GLenum state = gl->glClientWaitSync(fence, 0, 0);
+    if (state == GL_TIMEOUT_EXPIRED) {
+        // Still on the GPU, look again next frame
+        m_window->endExternalCommands();
+        m_overheadNs += m_clock.nsecsElapsed() - startNs;
+        requestFrame();
+        return;
+    }
+    gl->glDeleteSync(fence);
+    m_fence = nullptr;
+
+    QByteArray pixels;
+    if (state != GL_WAIT_FAILED) {
+        const int bytes = m_pboSize.width() * m_pboSize.height() * 4;
+        gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo);
+        if (void *mapped = gl->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT)) {
+            pixels = QByteArray(static_cast<const char *>(mapped), bytes);
+            gl->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    m_window->endExternalCommands();
+    m_overheadNs += m_clock.nsecsElapsed() - startNs;
+
+    if (pixels.isEmpty()) {
+        qWarning() << "Frame snapshot: the OpenGL readback failed";
+        QMetaObject::invokeMethod(this, [this]() {
+            finishCapture(false);
+        }, Qt::QueuedConnection);
+        return;
+    }
+    // glReadPixels: RGBA, bottom row first (m_mirrored)
+    onReadbackCompleted(pixels, m_pboSize, false);
+#endif
+}
+
+void FrameSnapshot::onSceneGraphInvalidated()
+{
+#if QT_CONFIG(opengl)
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (context && (m_pbo || m_fence)) {
+        QOpenGLExtraFunctions *gl = context->extraFunctions();
+        if (m_fence) {
+            gl->glDeleteSync(static_cast<GLsync>(m_fence));
+            // The capture it belonged to is gone
+            QMetaObject::invokeMethod(this, [this]() {
+                finishCapture(false);
+            }, Qt::QueuedConnection);
+        }
+        if (m_pbo) {
+            gl->glDeleteBuffers(1, &m_pbo);
+        }
+    }
+#endif
+    m_fence = nullptr;
+    m_pbo = 0;
+    m_pboSize = QSize();
+}
+
+void FrameSnapshot::onReadbackCompleted(const QByteArray &pixels, const QSize &size, bool bgra)
+{
+    // Render thread, inside the frame that delivered the pixels
+    Metrics::instance()->setGauge("gladis_snapshot_readback_frames", double(m_frameCount - m_issueFrame));
+    Metrics::instance()->observe("gladis_snapshot_frame_overhead_seconds", m_overheadNs / 1e9);
+    m_overheadNs = 0;
+
+    const bool mirrored = m_mirrored;
+    QMetaObject::invokeMethod(this, [this, pixels, size, bgra, mirrored]() {
+        encode(pixels, size, bgra, mirrored);
+    }, Qt::QueuedConnection);
+}
+
+void FrameSnapshot::onFrameSwapped()
+{
+    m_frameCount++;
+}
+
+void FrameSnapshot::encode(const QByteArray &pixels, const QSize &size, bool bgra, bool mirrored)
+{
+    if (m_path.isEmpty() || pixels.size() < qint64(size.width()) * size.height() * 4) {
+        finishCapture(false);
+        return;
+    }
+
+    const QString path = m_path;
+    const int width = m_width;
+    m_pool->start([this, pixels, size, bgra, mirrored, path, width]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        // Tightly packed RGBA8/BGRA8; the QImage only borrows the readback buffer
+        QImage frame(reinterpret_cast<const uchar *>(pixels.constData()), size.width(), size.height(),
+                     size.width() * 4,
+                     bgra ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGBA8888_Premultiplied);
+        QImage thumbnail = frame.scaledToWidth(qMin(width, size.width()), Qt::SmoothTransformation);
+        if (mirrored) {
+            thumbnail.mirror();
+        }
+        thumbnail = thumbnail.convertToFormat(QImage::Format_RGB888);
+
+        QByteArray format = QFileInfo(path).suffix().toLower().toLatin1();
+        QSaveFile file(path);
+        bool ok = file.open(QIODevice::WriteOnly);
+        if (ok) {
+            QImageWriter writer(&file, format.isEmpty() ? QByteArray("jpg") : format);
+            writer.setQuality(80);
+            ok = writer.write(thumbnail) && file.commit();
+            if (!ok) {
+                qWarning() << "Frame snapshot: cannot write" << path << "-" << writer.errorString() << file.errorString();
+            }
+        } else {
+            qWarning() << "Frame snapshot: cannot write" << path << "-" << file.errorString();
+        }
+
+        Metrics::instance()->observe("gladis_snapshot_encode_seconds", timer.nsecsElapsed() / 1e9);
+        QMetaObject::invokeMethod(this, [this, ok]() {
+            finishCapture(ok);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void FrameSnapshot::finishCapture(bool ok)
+{
+    Metrics::instance()->increment(ok ? "gladis_snapshot_captures_total" : "gladis_snapshot_errors_total");
+    m_inFlight.storeRelease(0);
+}
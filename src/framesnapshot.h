@@ -0,0 +1,87 @@
+#ifndef FRAMESNAPSHOT_H
+#define FRAMESNAPSHOT_H
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QSize>
+
+class QQuickWindow;
+class QTimer;
+class QThreadPool;
+
+// Thumbnail of what the kiosk is showing ([app_live] frame_snapshot), for
+// support staff: every frame_snapshot_interval seconds the composed frame is
+// written to the configured path (e.g. /dev/shm/app/snapshot.jpg).
+//
+// grabWindow()/grabToImage() block the render loop until the GPU has finished
+// and the pixels are copied. Here the render thread only records a readback
+// and picks the pixels up with a later frame, so nothing waits on the GPU:
+// Vulkan/Metal/D3D through QRhi readBackTexture; OpenGL (where QRhi would
+// glReadPixels at the end of the same frame) through glReadPixels into a pixel
+// pack buffer plus a fence, mapped once the fence has passed.
+// gladis_snapshot_frame_overhead_seconds is the render thread time this takes.
+// Scaling and encoding run on a worker thread.
+//
+// The thumbnail is the frame as sent to the display: rotated when
+// render_rotate_mode rotates in the scene, unrotated when the platform does.
+//
+// Needs Qt 6.6 (public QRhi API), and GLES 3.0 / OpenGL 3.0 on OpenGL.
+class FrameSnapshot : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameSnapshot(QObject *parent = nullptr);
+    ~FrameSnapshot();
+
+    void attach(QQuickWindow *window);
+
+    // Empty path = off; width in pixels, height follows the aspect ratio
+    void configure(const QString &path, int intervalSeconds, int width);
+    // A standby leaves the snapshot to the active process
+    void setPaused(bool paused);
+
+    // Captures with the next frame; ignored while the previous one is still in flight
+    void requestCapture();
+
+private:
+    // Render thread
+    void onAfterRendering();
+    void onFrameSwapped();
+    void onSceneGraphInvalidated();
+    bool issueGLReadback(const QSize &size);
+    void pollGLReadback();
+    void onReadbackCompleted(const QByteArray &pixels, const QSize &size, bool bgra);
+    void requestFrame();
+
+    // GUI thread, then worker
+    void encode(const QByteArray &pixels, const QSize &size, bool bgra, bool mirrored);
+    void finishCapture(bool ok);
+
+    QQuickWindow *m_window;
+    QTimer *m_timer;
+    QThreadPool *m_pool;
+    QString m_path;
+    int m_width;
+    bool m_paused;
+
+    QAtomicInt m_captureRequested;
+    QAtomicInt m_inFlight;
+
+    // Render thread only
+    QElapsedTimer m_clock;
+    qint64 m_overheadNs;        // Summed over the frames a capture touched
+    quint64 m_frameCount;
+    quint64 m_issueFrame;
+    bool m_mirrored;
+
+    // OpenGL: the pixel pack buffer and the fence of the readback in it
+    uint m_pbo;
+    QSize m_pboSize;
+    void *m_fence;              // GLsync
+    bool m_glWarned;
+};
+
+#endif // FRAMESNAPSHOT_H
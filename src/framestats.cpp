@@ -0,0 +1,151 @@
+#include "framestats.h"
+#include <QQuickWindow>
+#include <QScreen>
+#include <QEvent>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+FrameStats::FrameStats(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_lastFrameNs(-1)
+    , m_requestNs(-1)
+    , m_frameStartNs(-1)
+    , m_refreshMs(1000.0 / 60.0)
+    , m_excludeIdle(false)
+{
+    m_clock.start();
+}
+
+void FrameStats::attach(QQuickWindow *window)
+{
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+        m_window->removeEventFilter(this);
+    }
+
+    m_window = window;
+    if (!m_window) {
+        reset();
+        return;
+    }
+
+    if (m_window->screen() && m_window->screen()->refreshRate() > 1.0) {
+        m_refreshMs = 1000.0 / m_window->screen()->refreshRate();
+    }
+
+    // Direct connection: timestamp on the render thread, as close to the swap as possible
+    connect(m_window, &QQuickWindow::frameSwapped, this, &FrameStats::onFrameSwapped,
+            Qt::DirectConnection);
+
+    if (m_excludeIdle) {
+        // Every frame the render loop schedules arrives as an UpdateRequest on
+        // the GUI thread; the sync that follows consumes it
+        m_window->installEventFilter(this);
+        connect(m_window, &QQuickWindow::beforeSynchronizing, this,
+                &FrameStats::onBeforeSynchronizing, Qt::DirectConnection);
+    }
+
+    reset();
+}
+
+void FrameStats::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_intervalsMs.clear();
+    m_lastFrameNs = -1;
+    m_requestNs = -1;
+    m_frameStartNs = -1;
+}
+
+bool FrameStats::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::UpdateRequest) {
+        qint64 now = m_clock.nsecsElapsed();
+        QMutexLocker locker(&m_mutex);
+        if (m_requestNs < 0) {
+            m_requestNs = now;
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void FrameStats::onBeforeSynchronizing()
+{
+    qint64 now = m_clock.nsecsElapsed();
+
+    // A sync without a request (expose, resize) starts its frame here
+    QMutexLocker locker(&m_mutex);
+    m_frameStartNs = m_requestNs >= 0 ? m_requestNs : now;
+    m_requestNs = -1;
+}
+
+void FrameStats::onFrameSwapped()
+{
+    qint64 now = m_clock.nsecsElapsed();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_lastFrameNs >= 0) {
+        // While animating, the next request arrives before this swap and the
+        // interval runs swap to swap; after an idle stretch it starts at the
+        // request that woke the render loop. A stall after the request counts.
+        qint64 startNs = m_lastFrameNs;
+        if (m_excludeIdle && m_frameStartNs > startNs) {
+            startNs = m_frameStartNs;
+        }
+        m_intervalsMs.append(float((now - startNs) / 1000000.0));
+    }
+    m_lastFrameNs = now;
+}
+
+FrameStats::Summary FrameStats::summary() const
+{
+    QVector<float> intervals;
+    {
+        QMutexLocker locker(&m_mutex);
+        intervals = m_intervalsMs;
+    }
+
+    Summary result;
+    result.frames = intervals.size();
+    if (intervals.isEmpty()) {
+        return result;
+    }
+
+    double total = 0.0;
+    for (float interval : intervals) {
+        total += interval;
+        if (interval > m_refreshMs * 1.5) {
+            result.jankFrames++;
+            result.droppedFrames += qMax(1, int(interval / m_refreshMs + 0.5) - 1);
+        }
+    }
+
+    std::sort(intervals.begin(), intervals.end());
+    auto percentile = [&intervals](double p) {
+        int index = qBound(0, int(p * (intervals.size() - 1) + 0.5), int(intervals.size()) - 1);
+        return double(intervals.at(index));
+    };
+
+    result.meanMs = total / intervals.size();
+    result.p50Ms = percentile(0.50);
+    result.p95Ms = percentile(0.95);
+    result.p99Ms = percentile(0.99);
+    result.maxMs = intervals.last();
+    return result;
+}
+
+QString FrameStats::summaryLine() const
+{
+    Summary s = summary();
+    return QString("frames=%1 mean_ms=%2 p50_ms=%3 p95_ms=%4 p99_ms=%5 max_ms=%6 jank=%7 dropped=%8")
+        .arg(s.frames)
+        .arg(s.meanMs, 0, 'f', 2)
+        .arg(s.p50Ms, 0, 'f', 2)
+        .arg(s.p95Ms, 0, 'f', 2)
+        .arg(s.p99Ms, 0, 'f', 2)
+        .arg(s.maxMs, 0, 'f', 2)
+        .arg(s.jankFrames)
+        .arg(s.droppedFrames);
+}
@@ -0,0 +1,65 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QString>
+
+class QQuickWindow;
+
+// Frame interval statistics for a QQuickWindow, taken from frameSwapped().
+// The signal comes from the render thread, so samples are collected under a
+// mutex and read back from the GUI thread.
+class FrameStats : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Summary {
+        int frames = 0;
+        double meanMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        int jankFrames = 0;     // Intervals longer than 1.5 refresh periods
+        int droppedFrames = 0;  // Refresh periods missed in total
+    };
+
+    explicit FrameStats(QObject *parent = nullptr);
+
+    void attach(QQuickWindow *window);
+    void reset();
+
+    // The scene graph only renders on request. With this set, a frame that
+    // nobody asked for until after the previous swap is timed from the update
+    // request instead, so time spent idle is not counted as a long interval.
+    // Off (default): every swap-to-swap interval counts.
+    void setExcludeIdle(bool exclude) { m_excludeIdle = exclude; }
+
+    Summary summary() const;
+
+    // One line, key=value pairs - easy to grep out of a benchmark log
+    QString summaryLine() const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void onBeforeSynchronizing();
+    void onFrameSwapped();
+
+    QQuickWindow *m_window;
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    qint64 m_lastFrameNs;
+    qint64 m_requestNs;     // First update request not yet picked up by a sync
+    qint64 m_frameStartNs;  // Request that started the frame being rendered
+    QVector<float> m_intervalsMs;
+    double m_refreshMs;
+    bool m_excludeIdle;
+};
+
+#endif // FRAMESTATS_H
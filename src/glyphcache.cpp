@@ -0,0 +1,138 @@
+#include "glyphcache.h"
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QMetaProperty>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Printable ASCII and Latin-1 supplement
+bool isBaseCharacter(uint codePoint)
+{
+    return (codePoint >= 0x20 && codePoint < 0x7f) || (codePoint >= 0xa0 && codePoint <= 0xff);
+}
+
+QString fromCodePoint(uint codePoint)
+{
+    char32_t ucs4 = codePoint;
+    return QString::fromUcs4(&ucs4, 1);
+}
+
+}
+
+GlyphCache::GlyphCache(QObject *parent)
+    : QObject(parent)
+    , m_saveTimer(new QTimer(this))
+{
+    // New characters come in bursts (a whole config reload); write once per burst
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(2000);
+    connect(m_saveTimer, &QTimer::timeout, this, &GlyphCache::save);
+
+    rebuild();
+}
+
+void GlyphCache::setPath(const QString &path)
+{
+    QString resolved = path == "auto"
+        ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/glyphs.txt"
+        : path;
+    if (resolved == m_path) {
+        return;
+    }
+    m_path = resolved;
+    if (m_path.isEmpty()) {
+        return;
+    }
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    int before = m_extra.size();
+    for (uint codePoint : QString::fromUtf8(file.readAll()).toUcs4()) {
+        if (!isBaseCharacter(codePoint) && QChar::isPrint(codePoint)) {
+            m_extra.insert(codePoint);
+        }
+    }
+    qDebug() << "Glyph cache:" << m_extra.size() << "extra characters from" << m_path;
+
+    if (m_extra.size() != before) {
+        rebuild();
+    }
+}
+
+void GlyphCache::addText(const QString &text)
+{
+    bool added = false;
+    for (uint codePoint : text.toUcs4()) {
+        if (!isBaseCharacter(codePoint) && QChar::isPrint(codePoint) && !m_extra.contains(codePoint)) {
+            m_extra.insert(codePoint);
+            added = true;
+        }
+    }
+
+    if (added) {
+        rebuild();
+        if (!m_path.isEmpty()) {
+            m_saveTimer->start();
+        }
+    }
+}
+
+void GlyphCache::addStrings(const QObject *object)
+{
+    const QMetaObject *meta = object->metaObject();
+    for (int i = meta->propertyOffset(); i < meta->propertyCount(); i++) {
+        QMetaProperty property = meta->property(i);
+        if (property.typeId() == QMetaType::QString) {
+            addText(property.read(object).toString());
+        } else if (property.typeId() == QMetaType::QStringList) {
+            addText(property.read(object).toStringList().join(QString()));
+        }
+    }
+}
+
+void GlyphCache::rebuild()
+{
+    QList<uint> codePoints(m_extra.begin(), m_extra.end());
+    std::sort(codePoints.begin(), codePoints.end());
+
+    QString characters;
+    for (uint codePoint = 0x20; codePoint <= 0xff; codePoint++) {
+        if (isBaseCharacter(codePoint)) {
+            characters += QChar(char16_t(codePoint));
+        }
+    }
+    for (uint codePoint : codePoints) {
+        characters += fromCodePoint(codePoint);
+    }
+
+    m_characters = characters;
+    emit charactersChanged();
+}
+
+void GlyphCache::save()
+{
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Glyph cache: cannot write" << m_path << "-" << file.errorString();
+        return;
+    }
+    QString extra;
+    for (uint codePoint : m_extra) {
+        extra += fromCodePoint(codePoint);
+    }
+    file.write(extra.toUtf8());
+    if (!file.commit()) {
+        qWarning() << "Glyph cache: cannot write" << m_path << "-" << file.errorString();
+    }
+}
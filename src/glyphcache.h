@@ -0,0 +1,59 @@
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+
+class QTimer;
+
+// Character inventory for glyph prewarming ([app_live] render_glyph_cache).
+//
+// Qt Quick rasterizes a distance field per glyph the first time a Text shows
+// it. GlyphPrewarm.qml draws every character in `characters` once, in each
+// font and size the apps use, right after the window is shown, so countdown
+// digits and new ticker strings find their glyphs in the atlas already.
+//
+// `characters` is printable Latin-1 plus every other character that has
+// appeared in a config or data string. The extra characters are stored in the
+// cache file, so a string seen once is prewarmed from then on at every launch.
+//
+// The rasterized glyphs themselves can be persisted too, in the font file:
+// qdistancefieldgenerator (Qt Tools) writes a "qdf" table with pregenerated
+// distance fields into a copy of the font, and Qt Quick loads that table
+// instead of rasterizing when the font is first used. Fonts in fonts/ that
+// carry one (e.g. Countdown.ttf with its digits) then cost no rasterization at
+// all; the prewarm still covers characters the table does not have.
+class GlyphCache : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString characters READ characters NOTIFY charactersChanged)
+
+public:
+    explicit GlyphCache(QObject *parent = nullptr);
+
+    // "auto" = <cache dir>/glyphs.txt, empty = nothing persisted
+    void setPath(const QString &path);
+
+    QString characters() const { return m_characters; }
+
+    // Add the characters of a string
+    Q_INVOKABLE void addText(const QString &text);
+
+    // Add the characters of every QString / QStringList property of an object
+    void addStrings(const QObject *object);
+
+signals:
+    void charactersChanged();
+
+private:
+    void rebuild();
+    void save();
+
+    QString m_path;
+    QString m_characters;
+    QSet<uint> m_extra;      // Code points beyond the base set
+    QTimer *m_saveTimer;
+};
+
+#endif // GLYPHCACHE_H
@@ -0,0 +1,280 @@
+#include "journalreplayer.h"
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QQuickWindow>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QCoreApplication>
+#include <QDebug>
+
+JournalReplayer::JournalReplayer(QObject *parent)
+    : QObject(parent)
+    , m_startIndex(0)
+    , m_next(0)
+    , m_startTimeUs(0)
+    , m_speed(1.0)
+    , m_timer(new QTimer(this))
+    , m_sandbox(nullptr)
+    , m_fileWrites(0)
+    , m_missingContent(0)
+    , m_inputEvents(0)
+    , m_recordedWatcherEvents(0)
+    , m_recordedConfigDiffs(0)
+    , m_recordedDataReloads(0)
+    , m_maxLateUs(0)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &JournalReplayer::processDue);
+}
+
+JournalReplayer::~JournalReplayer()
+{
+    delete m_sandbox;
+}
+
+bool JournalReplayer::load(const QString &filePath)
+{
+    QString error;
+    m_records.clear();
+    if (!EventJournal::read(filePath, &m_records, &error)) {
+        qWarning() << "Failed to read event journal:" << filePath << error;
+        return false;
+    }
+
+    // Everything up to the Started record is the state the app booted with
+    m_startIndex = 0;
+    for (int i = 0; i < m_records.size(); i++) {
+        const EventJournal::Record &record = m_records.at(i);
+        if (record.type == EventJournal::SessionRecord && m_recordedConfigPath.isEmpty()) {
+            m_recordedConfigPath = record.path;
+            m_recordedDataPath = record.name;
+        } else if (record.type == EventJournal::StartedRecord && m_startIndex == 0) {
+            m_startIndex = i + 1;
+            m_startTimeUs = record.timeUs;
+        }
+    }
+
+    if (m_recordedConfigPath.isEmpty()) {
+        qWarning() << "Event journal has no session record:" << filePath;
+        return false;
+    }
+
+    qDebug() << "Loaded event journal:" << filePath << m_records.size() << "records,"
+             << (m_records.isEmpty() ? 0 : (m_records.last().timeUs - m_startTimeUs) / 1000) << "ms after startup";
+    return true;
+}
+
+bool JournalReplayer::prepare()
+{
+    delete m_sandbox;
+
+    // tmpfs like the kiosk's /dev/shm, so file timing is comparable
+    QString base = QDir("/dev/shm").exists() ? "/dev/shm/gladis-replay-XXXXXX" : QString();
+    m_sandbox = base.isEmpty() ? new QTemporaryDir() : new QTemporaryDir(base);
+    if (!m_sandbox->isValid()) {
+        qWarning() << "Failed to create replay sandbox:" << m_sandbox->errorString();
+        return false;
+    }
+
+    // Directories must exist up front so the managers can watch them for
+    // files that only appear later in the journal
+    QDir().mkpath(mapPath(m_recordedDataPath));
+    QDir().mkpath(QFileInfo(configPath()).absolutePath());
+    for (const EventJournal::Record &record : m_records) {
+        if (record.type == EventJournal::FileStateRecord) {
+            QDir().mkpath(QFileInfo(mapPath(record.path)).absolutePath());
+        }
+    }
+
+    for (int i = 0; i < m_startIndex; i++) {
+        if (m_records.at(i).type == EventJournal::FileStateRecord) {
+            applyFileState(m_records.at(i));
+        }
+    }
+
+    qDebug() << "Replay sandbox:" << sandboxRoot();
+    return true;
+}
+
+QString JournalReplayer::sandboxRoot() const
+{
+    return m_sandbox ? m_sandbox->path() : QString();
+}
+
+QString JournalReplayer::configPath() const
+{
+    return mapPath(m_recordedConfigPath);
+}
+
+QString JournalReplayer::dataPath() const
+{
+    return mapPath(m_recordedDataPath);
+}
+
+void JournalReplayer::setSpeed(double speed)
+{
+    m_speed = speed > 0.0 ? speed : 1.0;
+}
+
+void JournalReplayer::setWindow(QQuickWindow *window)
+{
+    m_window = window;
+}
+
+void JournalReplayer::start()
+{
+    m_next = m_startIndex;
+    m_clock.start();
+    qDebug() << "Replaying" << (m_records.size() - m_startIndex) << "records at" << m_speed << "x";
+    processDue();
+}
+
+void JournalReplayer::processDue()
+{
+    qint64 elapsedUs = qint64(m_clock.nsecsElapsed() / 1000 * m_speed);
+
+    while (m_next < m_records.size()) {
+        const EventJournal::Record &record = m_records.at(m_next);
+        qint64 dueUs = record.timeUs - m_startTimeUs;
+        if (dueUs > elapsedUs) {
+            break;
+        }
+        m_maxLateUs = qMax(m_maxLateUs, elapsedUs - dueUs);
+
+        switch (record.type) {
+        case EventJournal::FileStateRecord:
+            applyFileState(record);
+            break;
+        case EventJournal::InputRecord:
+            applyInput(record);
+            break;
+        case EventJournal::WatcherRecord:
+            m_recordedWatcherEvents++;
+            break;
+        case EventJournal::ConfigDiffRecord:
+            m_recordedConfigDiffs++;
+            break;
+        case EventJournal::DataReloadRecord:
+            m_recordedDataReloads++;
+            break;
+        default:
+            break;
+        }
+        m_next++;
+    }
+
+    if (m_next >= m_records.size()) {
+        qDebug() << "Replay finished:" << summaryLine();
+        emit finished();
+        return;
+    }
+
+    qint64 waitUs = qint64((m_records.at(m_next).timeUs - m_startTimeUs) - elapsedUs);
+    m_timer->start(int(qMax<qint64>(0, waitUs / 1000 / m_speed)));
+}
+
+void JournalReplayer::applyFileState(const EventJournal::Record &record)
+{
+    QString target = mapPath(record.path);
+
+    if (!record.exists) {
+        QFile::remove(target);
+        m_fileWrites++;
+        return;
+    }
+
+    if (record.hasContent) {
+        // Rewrite in place like the field writers do, not an atomic rename
+        QFile file(target);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(record.content);
+            file.close();
+            m_fileWrites++;
+        } else {
+            qWarning() << "Replay: failed to write" << target << file.errorString();
+        }
+        return;
+    }
+
+    // Too large to journal - usable only if the original is still the same file
+    QFile original(record.path);
+    if (original.open(QIODevice::ReadOnly) &&
+        EventJournal::contentHash(original.readAll()) == record.hash) {
+        QFile::remove(target);
+        QFile::copy(record.path, target);
+        m_fileWrites++;
+    } else {
+        qWarning() << "Replay: content of" << record.path << "is not in the journal, skipped";
+        m_missingContent++;
+    }
+}
+
+void JournalReplayer::applyInput(const EventJournal::Record &record)
+{
+    if (!m_window) {
+        return;
+    }
+
+    m_inputEvents++;
+    QEvent::Type type = QEvent::Type(record.kind);
+    QPointF global = m_window->mapToGlobal(record.position);
+
+    switch (type) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove: {
+        Qt::MouseButton button = type == QEvent::MouseMove ? Qt::NoButton : Qt::MouseButton(record.code);
+        Qt::MouseButtons buttons = type == QEvent::MouseButtonPress ? Qt::MouseButtons(button)
+                                 : type == QEvent::MouseMove ? Qt::MouseButtons(record.code)
+                                 : Qt::MouseButtons(Qt::NoButton);
+        QMouseEvent event(type, record.position, global, button, buttons, Qt::NoModifier);
+        QCoreApplication::sendEvent(m_window, &event);
+        break;
+    }
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd: {
+        // Single-point touch is replayed as the mouse events Qt would synthesize
+        QEvent::Type mouseType = type == QEvent::TouchBegin ? QEvent::MouseButtonPress
+                               : type == QEvent::TouchEnd ? QEvent::MouseButtonRelease
+                               : QEvent::MouseMove;
+        Qt::MouseButtons buttons = mouseType == QEvent::MouseButtonRelease ? Qt::MouseButtons(Qt::NoButton)
+                                                                           : Qt::MouseButtons(Qt::LeftButton);
+        QMouseEvent event(mouseType, record.position, global,
+                          mouseType == QEvent::MouseMove ? Qt::NoButton : Qt::LeftButton,
+                          buttons, Qt::NoModifier);
+        QCoreApplication::sendEvent(m_window, &event);
+        break;
+    }
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease: {
+        QKeyEvent event(type, record.code, Qt::NoModifier);
+        QCoreApplication::sendEvent(m_window, &event);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+QString JournalReplayer::mapPath(const QString &path) const
+{
+    return QDir::cleanPath(sandboxRoot() + "/" + QFileInfo(path).absoluteFilePath());
+}
+
+QString JournalReplayer::summaryLine() const
+{
+    return QString("file_writes=%1 missing_content=%2 inputs=%3 recorded_watcher_events=%4 "
+                   "recorded_config_diffs=%5 recorded_data_reloads=%6 max_late_ms=%7")
+        .arg(m_fileWrites)
+        .arg(m_missingContent)
+        .arg(m_inputEvents)
+        .arg(m_recordedWatcherEvents)
+        .arg(m_recordedConfigDiffs)
+        .arg(m_recordedDataReloads)
+        .arg(m_maxLateUs / 1000.0, 0, 'f', 1);
+}
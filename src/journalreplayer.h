@@ -0,0 +1,78 @@
+#ifndef JOURNALREPLAYER_H
+#define JOURNALREPLAYER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QList>
+#include "eventjournal.h"
+
+class QTimer;
+class QTemporaryDir;
+class QQuickWindow;
+
+// Plays an EventJournal back. Recorded files are mirrored into a sandbox
+// directory (recorded path P lives at <sandbox>/P), ConfigManager and
+// DataManager are pointed at the sandbox, and file changes are re-written
+// there at their recorded times - so the managers go through the same
+// watcher -> reload -> QML path as in the field. Input events are sent to the
+// window. Watcher, diff and reload records are only counted; they are what
+// the replayed run is expected to reproduce.
+class JournalReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit JournalReplayer(QObject *parent = nullptr);
+    ~JournalReplayer();
+
+    bool load(const QString &filePath);
+
+    // Create the sandbox with the file state at the end of recorded startup
+    bool prepare();
+
+    // Sandbox paths to hand to ConfigManager/DataManager (valid after prepare)
+    QString sandboxRoot() const;
+    QString configPath() const;
+    QString dataPath() const;
+
+    // 1.0 = recorded speed, 4.0 = four times faster
+    void setSpeed(double speed);
+    void setWindow(QQuickWindow *window);
+
+    void start();
+
+    // One line, key=value pairs, like FrameStats::summaryLine()
+    QString summaryLine() const;
+
+signals:
+    void finished();
+
+private:
+    void processDue();
+    void applyFileState(const EventJournal::Record &record);
+    void applyInput(const EventJournal::Record &record);
+    QString mapPath(const QString &path) const;
+
+    QList<EventJournal::Record> m_records;
+    QString m_recordedConfigPath;
+    QString m_recordedDataPath;
+    int m_startIndex;
+    int m_next;
+    qint64 m_startTimeUs;
+    double m_speed;
+    QElapsedTimer m_clock;
+    QTimer *m_timer;
+    QTemporaryDir *m_sandbox;
+    QPointer<QQuickWindow> m_window;
+
+    int m_fileWrites;
+    int m_missingContent;
+    int m_inputEvents;
+    int m_recordedWatcherEvents;
+    int m_recordedConfigDiffs;
+    int m_recordedDataReloads;
+    qint64 m_maxLateUs;
+};
+
+#endif // JOURNALREPLAYER_H
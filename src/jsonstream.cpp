@@ -0,0 +1,337 @@
+#include "jsonstream.h"
+#include <QIODevice>
+#include <QVariantMap>
+#include <QVariantList>
+
+JsonStreamReader::JsonStreamReader(QIODevice *device)
+    : m_device(device)
+    , m_buffer(BufferSize, Qt::Uninitialized)
+    , m_pos(0)
+    , m_end(0)
+    , m_offset(0)
+    , m_eof(false)
+    , m_expectName(false)
+    , m_token(Null)
+    , m_number(0.0)
+    , m_integer(false)
+    , m_bool(false)
+{
+    m_stack.reserve(MaxDepth);
+}
+
+JsonStreamReader::Token JsonStreamReader::next()
+{
+    if (m_token == Invalid || m_token == EndDocument) {
+        return m_token;
+    }
+
+    for (;;) {
+        skipWhitespace();
+        char c;
+        if (!peekChar(&c)) {
+            if (!m_stack.isEmpty()) {
+                return fail("unexpected end of document");
+            }
+            return m_token = EndDocument;
+        }
+        m_pos++;
+
+        switch (c) {
+        case ',':
+            if (m_stack.isEmpty()) {
+                return fail("unexpected ','");
+            }
+            m_expectName = m_stack.last() == '{';
+            continue;
+        case ':':
+            continue;
+        case '{':
+        case '[':
+            if (m_stack.size() >= MaxDepth) {
+                return fail("nesting too deep");
+            }
+            m_stack.append(c);
+            m_expectName = c == '{';
+            return m_token = (c == '{') ? StartObject : StartArray;
+        case '}':
+        case ']':
+            if (m_stack.isEmpty() || m_stack.last() != (c == '}' ? '{' : '[')) {
+                return fail(QString("unexpected '%1'").arg(QLatin1Char(c)));
+            }
+            m_stack.removeLast();
+            m_expectName = false;
+            return m_token = (c == '}') ? EndObject : EndArray;
+        case '"':
+            if (!readString()) {
+                return fail("invalid string");
+            }
+            if (m_expectName && !m_stack.isEmpty() && m_stack.last() == '{') {
+                m_expectName = false;
+                return m_token = Name;
+            }
+            return m_token = String;
+        case 't':
+        case 'f':
+            if (!readLiteral(c == 't' ? "rue" : "alse")) {
+                return fail("invalid literal");
+            }
+            m_bool = c == 't';
+            return m_token = Bool;
+        case 'n':
+            if (!readLiteral("ull")) {
+                return fail("invalid literal");
+            }
+            return m_token = Null;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                if (!readNumber(c)) {
+                    return fail("invalid number");
+                }
+                return m_token = Number;
+            }
+            return fail(QString("unexpected '%1'").arg(QLatin1Char(c)));
+        }
+    }
+}
+
+bool JsonStreamReader::skipValue()
+{
+    if (m_token != StartObject && m_token != StartArray) {
+        Token token = next();
+        if (token == Invalid || token == EndDocument) {
+            return false;
+        }
+        if (token != StartObject && token != StartArray) {
+            return true;
+        }
+    }
+
+    const int target = depth() - 1;
+    while (depth() > target) {
+        Token token = next();
+        if (token == Invalid || token == EndDocument) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QVariant JsonStreamReader::readVariant()
+{
+    next();
+    return variantFromCurrent();
+}
+
+QVariant JsonStreamReader::variantFromCurrent()
+{
+    // Same types as QJsonValue::toVariant()
+    switch (m_token) {
+    case String:
+        return text();
+    case Number:
+        if (m_integer) {
+            return m_text.toLongLong();
+        }
+        return m_number;
+    case Bool:
+        return m_bool;
+    case Null:
+        return QVariant::fromValue(nullptr);
+    case StartObject: {
+        QVariantMap map;
+        while (next() == Name) {
+            QString key = text();
+            map.insert(key, readVariant());
+        }
+        return m_token == EndObject ? QVariant(map) : QVariant();
+    }
+    case StartArray: {
+        QVariantList list;
+        for (Token token = next(); token != EndArray; token = next()) {
+            if (token == Invalid || token == EndDocument) {
+                return QVariant();
+            }
+            list.append(variantFromCurrent());
+        }
+        return list;
+    }
+    default:
+        return QVariant();
+    }
+}
+
+bool JsonStreamReader::fill()
+{
+    if (m_eof) {
+        return false;
+    }
+    m_offset += m_end;
+    m_pos = 0;
+    qint64 count = m_device->read(m_buffer.data(), BufferSize);
+    m_end = count > 0 ? int(count) : 0;
+    if (m_end == 0) {
+        m_eof = true;
+        return false;
+    }
+    return true;
+}
+
+bool JsonStreamReader::peekChar(char *c)
+{
+    if (m_pos >= m_end && !fill()) {
+        return false;
+    }
+    *c = m_buffer.at(m_pos);
+    return true;
+}
+
+void JsonStreamReader::skipWhitespace()
+{
+    char c;
+    while (peekChar(&c) && (c == ' ' || c == '\n' || c == '\r' || c == '\t')) {
+        m_pos++;
+    }
+}
+
+JsonStreamReader::Token JsonStreamReader::fail(const QString &message)
+{
+    if (m_error.isEmpty()) {
+        m_error = QString("%1 at offset %2").arg(message).arg(m_offset + m_pos);
+    }
+    return m_token = Invalid;
+}
+
+bool JsonStreamReader::readString()
+{
+    m_text.clear();
+    for (;;) {
+        if (m_pos >= m_end && !fill()) {
+            return false;
+        }
+
+        // Copy the run up to the next quote or escape in one go
+        const char *begin = m_buffer.constData() + m_pos;
+        const char *end = m_buffer.constData() + m_end;
+        const char *p = begin;
+        while (p < end && *p != '"' && *p != '\\') {
+            p++;
+        }
+        m_text.append(begin, p - begin);
+        m_pos += int(p - begin);
+        if (p == end) {
+            continue;
+        }
+        m_pos++;
+        if (*p == '"') {
+            return true;
+        }
+
+        char escape;
+        if (!peekChar(&escape)) {
+            return false;
+        }
+        m_pos++;
+        switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+            m_text.append(escape);
+            break;
+        case 'b': m_text.append('\b'); break;
+        case 'f': m_text.append('\f'); break;
+        case 'n': m_text.append('\n'); break;
+        case 'r': m_text.append('\r'); break;
+        case 't': m_text.append('\t'); break;
+        case 'u': {
+            uint code;
+            if (!readHex4(&code)) {
+                return false;
+            }
+            // Surrogate pair: a second \uXXXX must follow
+            if (code >= 0xd800 && code < 0xdc00) {
+                char backslash;
+                char u;
+                uint low;
+                if (!peekChar(&backslash) || backslash != '\\') {
+                    return false;
+                }
+                m_pos++;
+                if (!peekChar(&u) || u != 'u') {
+                    return false;
+                }
+                m_pos++;
+                if (!readHex4(&low) || low < 0xdc00 || low > 0xdfff) {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            }
+            char32_t ucs4 = char32_t(code);
+            m_text.append(QString::fromUcs4(&ucs4, 1).toUtf8());
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+bool JsonStreamReader::readHex4(uint *code)
+{
+    *code = 0;
+    for (int i = 0; i < 4; i++) {
+        char c;
+        if (!peekChar(&c)) {
+            return false;
+        }
+        m_pos++;
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        *code = (*code << 4) | uint(digit);
+    }
+    return true;
+}
+
+bool JsonStreamReader::readNumber(char first)
+{
+    m_text.clear();
+    m_text.append(first);
+    bool fraction = false;
+    char c;
+    while (peekChar(&c) && ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')) {
+        fraction = fraction || c == '.' || c == 'e' || c == 'E';
+        m_text.append(c);
+        m_pos++;
+    }
+
+    bool ok = false;
+    m_number = m_text.toDouble(&ok);
+    if (!ok) {
+        return false;
+    }
+    bool fits = false;
+    if (!fraction) {
+        m_text.toLongLong(&fits);
+    }
+    m_integer = fits;
+    return true;
+}
+
+bool JsonStreamReader::readLiteral(const char *rest)
+{
+    for (const char *p = rest; *p; p++) {
+        char c;
+        if (!peekChar(&c) || c != *p) {
+            return false;
+        }
+        m_pos++;
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+class QIODevice;
+
+// Pull (SAX-style) JSON reader over a QIODevice.
+//
+// Reads through a fixed BufferSize window and hands out one token at a time,
+// so memory use does not depend on the document size; callers build their
+// own records from the tokens instead of a QJsonDocument. Names and strings
+// are unescaped UTF-8 in a reused buffer, valid until the next call.
+// Separators are not validated beyond nesting: a missing comma or colon is
+// tolerated, unbalanced brackets and bad tokens are errors.
+//
+//   JsonStreamReader reader(&file);
+//   while (reader.next() == JsonStreamReader::Name) { ... reader.skipValue(); }
+class JsonStreamReader
+{
+public:
+    enum Token {
+        Invalid,        // Syntax error or read failure, see errorString()
+        EndDocument,
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Name,           // Object member name; the value follows
+        String,
+        Number,
+        Bool,
+        Null
+    };
+
+    static const int BufferSize = 64 * 1024;
+    static const int MaxDepth = 64;
+
+    explicit JsonStreamReader(QIODevice *device);
+
+    Token next();
+    Token token() const { return m_token; }
+
+    // Name/String: raw UTF-8 (no allocation to compare against a literal)
+    const QByteArray &utf8() const { return m_text; }
+    QString text() const { return QString::fromUtf8(m_text); }
+    double number() const { return m_number; }
+    // Number written without fraction or exponent that fits in 64 bits
+    bool isInteger() const { return m_integer; }
+    bool boolean() const { return m_bool; }
+
+    // After a Name: skips its value. After StartObject/StartArray: skips to the
+    // matching end. Returns false on a syntax error.
+    bool skipValue();
+
+    // The value starting at the next token as a QVariant (maps, lists,
+    // scalars); for small values only, it is built in memory
+    QVariant readVariant();
+
+    int depth() const { return m_stack.size(); }
+    bool hasError() const { return m_token == Invalid; }
+    QString errorString() const { return m_error; }
+
+private:
+    bool fill();
+    bool peekChar(char *c);
+    void skipWhitespace();
+    Token fail(const QString &message);
+    bool readString();
+    bool readHex4(uint *code);
+    bool readNumber(char first);
+    bool readLiteral(const char *rest);
+    QVariant variantFromCurrent();
+
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_pos;
+    int m_end;
+    qint64 m_offset;        // Device offset of m_buffer[0]
+    bool m_eof;
+
+    QVector<char> m_stack;  // '{' or '['
+    bool m_expectName;      // Next string in the current object is a member name
+    Token m_token;
+    QByteArray m_text;
+    double m_number;
+    bool m_integer;
+    bool m_bool;
+    QString m_error;
+};
+
+#endif // JSONSTREAM_H
@@ -0,0 +1,377 @@
+#include "logging.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QtEndian>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+Q_LOGGING_CATEGORY(lcConfig, "gladis.config", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcData, "gladis.data", QtInfoMsg)
+
+namespace {
+
+const quint32 BinaryMagic = 0x474c4f47;   // "GLOG"
+const quint16 BinaryVersion = 1;
+
+qint64 wallClockNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const char *levelName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "debug";
+    case QtInfoMsg: return "info";
+    case QtWarningMsg: return "warning";
+    case QtCriticalMsg: return "critical";
+    case QtFatalMsg: return "fatal";
+    }
+    return "debug";
+}
+
+} // namespace
+
+AsyncLogger *AsyncLogger::instance()
+{
+    // Never destroyed: messages can arrive from static destructors and atexit handlers
+    static AsyncLogger *logger = new AsyncLogger();
+    return logger;
+}
+
+AsyncLogger::AsyncLogger()
+    : m_slots(new Slot[Capacity])
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_dropped(0)
+    , m_running(false)
+    , m_installed(false)
+    , m_outputChanged(false)
+    , m_rateLimit(200)
+    , m_format(TextFormat)
+    , m_file(stderr)
+    , m_reportedDropped(0)
+{
+    for (int i = 0; i < Capacity; i++) {
+        m_slots[i].sequence.store(quint64(i), std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogger::install()
+{
+    if (m_installed) {
+        return;
+    }
+    m_installed = true;
+
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&AsyncLogger::writerLoop, this);
+    qInstallMessageHandler(&AsyncLogger::messageHandler);
+    std::atexit([]() { AsyncLogger::instance()->shutdown(); });
+}
+
+void AsyncLogger::shutdown()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    if (m_writer.joinable() && m_writer.get_id() != std::this_thread::get_id()) {
+        m_writer.join();
+    }
+}
+
+void AsyncLogger::setOutput(const QString &output)
+{
+    QMutexLocker locker(&m_configMutex);
+    if (output == m_pendingOutput) {
+        return;
+    }
+    m_pendingOutput = output;
+    m_outputChanged = true;
+}
+
+void AsyncLogger::setRateLimit(int messagesPerSecond)
+{
+    m_rateLimit.store(qMax(0, messagesPerSecond), std::memory_order_relaxed);
+}
+
+void AsyncLogger::setRules(const QString &rules)
+{
+    QMutexLocker locker(&m_rulesMutex);
+    if (rules == m_rules) {
+        return;
+    }
+    m_rules = rules;
+    applyRules();
+}
+
+void AsyncLogger::setRuleOverride(const QString &category, bool enabled)
+{
+    QMutexLocker locker(&m_rulesMutex);
+    m_ruleOverrides.insert(category, enabled);
+    applyRules();
+}
+
+void AsyncLogger::applyRules()
+{
+    QStringList lines = m_rules.split(';', Qt::SkipEmptyParts);
+    for (QString &line : lines) {
+        line = line.trimmed();
+    }
+    for (auto it = m_ruleOverrides.constBegin(); it != m_ruleOverrides.constEnd(); ++it) {
+        lines.append(QString("%1.debug=%2").arg(it.key(), QLatin1String(it.value() ? "true" : "false")));
+    }
+    QLoggingCategory::setFilterRules(lines.join('\n'));
+}
+
+void AsyncLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    AsyncLogger *self = instance();
+    if (type == QtFatalMsg || !self->m_running.load(std::memory_order_acquire)) {
+        // Written synchronously: Qt aborts right after a fatal message
+        if (type == QtFatalMsg) {
+            self->shutdown();
+        }
+        QByteArray line = qFormatLogMessage(type, context, message).toLocal8Bit();
+        fprintf(stderr, "%s\n", line.constData());
+        fflush(stderr);
+        return;
+    }
+
+    self->enqueue(type, context.category, message);
+}
+
+bool AsyncLogger::enqueue(QtMsgType type, const char *category, const QString &message)
+{
+    // Bounded MPMC ring (Vyukov): claim a position, fill the slot, publish its sequence
+    quint64 position = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+        slot = &m_slots[position & (Capacity - 1)];
+        quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+        qint64 difference = qint64(sequence) - qint64(position);
+        if (difference == 0) {
+            if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Full: the writer is behind, never wait for it
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    Record &record = slot->record;
+    record.timeNs = wallClockNs();
+    record.type = type;
+    qstrncpy(record.category, category ? category : "default", sizeof(record.category));
+    record.thread = quintptr(QThread::currentThreadId());
+    record.message = message;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogger::dequeue(Record *record)
+{
+    Slot &slot = m_slots[m_dequeuePos & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+        return false;
+    }
+
+    *record = std::move(slot.record);
+    slot.record.message = QString();
+    slot.sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+    m_dequeuePos++;
+    return true;
+}
+
+void AsyncLogger::writerLoop()
+{
+    while (m_running.load(std::memory_order_acquire)) {
+        applyPendingConfig();
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(DrainIntervalMs));
+    }
+
+    // Whatever was queued before shutdown
+    applyPendingConfig();
+    drain();
+    if (m_file && m_file != stderr) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void AsyncLogger::applyPendingConfig()
+{
+    QString output;
+    {
+        QMutexLocker locker(&m_configMutex);
+        if (!m_outputChanged) {
+            return;
+        }
+        m_outputChanged = false;
+        output = m_pendingOutput;
+    }
+
+    // Everything logged so far goes to the old output
+    drain();
+    if (m_file && m_file != stderr) {
+        fclose(m_file);
+    }
+    m_file = stderr;
+    m_format = TextFormat;
+    if (output.isEmpty() || output == "stderr") {
+        return;
+    }
+
+    FILE *file = fopen(QFile::encodeName(output).constData(), "ab");
+    if (!file) {
+        fprintf(stderr, "gladis.log: cannot open %s, logging to stderr\n", qPrintable(output));
+        return;
+    }
+    m_file = file;
+    m_format = output.endsWith(".jsonl") ? JsonFormat : BinaryFormat;
+
+    // New binary files start with a header
+    if (m_format == BinaryFormat && ftell(m_file) == 0) {
+        uchar header[6];
+        qToLittleEndian(BinaryMagic, header);
+        qToLittleEndian(BinaryVersion, header + 4);
+        fwrite(header, 1, sizeof(header), m_file);
+    }
+}
+
+void AsyncLogger::drain()
+{
+    Record record;
+    bool wrote = false;
+    while (dequeue(&record)) {
+        if (allow(record)) {
+            write(record);
+            wrote = true;
+        }
+    }
+
+    // Lost messages are reported, not silently gone
+    quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        Record report;
+        report.timeNs = wallClockNs();
+        report.type = QtWarningMsg;
+        qstrncpy(report.category, "gladis.log", sizeof(report.category));
+        report.message = QString("%1 messages dropped (queue full)").arg(dropped - m_reportedDropped);
+        m_reportedDropped = dropped;
+        write(report);
+        wrote = true;
+    }
+
+    if (wrote && m_file) {
+        fflush(m_file);
+    }
+}
+
+bool AsyncLogger::allow(const Record &record)
+{
+    const int limit = m_rateLimit.load(std::memory_order_relaxed);
+    if (limit <= 0 || record.type == QtCriticalMsg) {
+        return true;
+    }
+
+    // One second windows per category; the first message of a new window reports the rest
+    Bucket &bucket = m_buckets[QByteArray(record.category)];
+    if (record.timeNs - bucket.windowStartNs >= 1000000000LL) {
+        if (bucket.suppressed > 0) {
+            Record report;
+            report.timeNs = record.timeNs;
+            report.type = QtWarningMsg;
+            memcpy(report.category, record.category, sizeof(report.category));
+            report.message = QString("%1 messages suppressed (log_rate_limit %2/s)").arg(bucket.suppressed).arg(limit);
+            write(report);
+        }
+        bucket.windowStartNs = record.timeNs;
+        bucket.count = 0;
+        bucket.suppressed = 0;
+    }
+
+    if (bucket.count >= limit) {
+        bucket.suppressed++;
+        return false;
+    }
+    bucket.count++;
+    return true;
+}
+
+void AsyncLogger::write(const Record &record)
+{
+    if (!m_file) {
+        return;
+    }
+
+    switch (m_format) {
+    case TextFormat:
+        writeText(record);
+        break;
+    case JsonFormat:
+        writeJson(record);
+        break;
+    case BinaryFormat:
+        writeBinary(record);
+        break;
+    }
+}
+
+void AsyncLogger::writeText(const Record &record)
+{
+    // "12:00:01.250 W gladis.config: message"
+    QString time = QDateTime::fromMSecsSinceEpoch(record.timeNs / 1000000).toString("HH:mm:ss.zzz");
+    QChar level = QChar(QLatin1Char(levelName(record.type)[0])).toUpper();
+    QByteArray line = QString("%1 %2 %3: %4\n")
+                          .arg(time, QString(level), QLatin1String(record.category), record.message)
+                          .toLocal8Bit();
+    fwrite(line.constData(), 1, line.size(), m_file);
+}
+
+void AsyncLogger::writeJson(const Record &record)
+{
+    QJsonObject object {
+        { "time", double(record.timeNs / 1000) / 1e6 },
+        { "level", QLatin1String(levelName(record.type)) },
+        { "category", QLatin1String(record.category) },
+        { "thread", QString::number(record.thread, 16) },
+        { "message", record.message }
+    };
+    QByteArray line = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    fwrite(line.constData(), 1, line.size(), m_file);
+}
+
+void AsyncLogger::writeBinary(const Record &record)
+{
+    // qint64 time (ns since epoch), quint8 level, quint8 category length + bytes,
+    // quint64 thread, quint32 message length + UTF-8 (all little endian)
+    QByteArray category(record.category);
+    QByteArray message = record.message.toUtf8();
+    QByteArray out;
+    out.resize(8 + 1 + 1 + category.size() + 8 + 4 + message.size());
+    uchar *p = reinterpret_cast<uchar *>(out.data());
+    qToLittleEndian<qint64>(record.timeNs, p);
+    p += 8;
+    *p++ = uchar(record.type);
+    *p++ = uchar(category.size());
+    memcpy(p, category.constData(), category.size());
+    p += category.size();
+    qToLittleEndian<quint64>(quint64(record.thread), p);
+    p += 8;
+    qToLittleEndian<quint32>(quint32(message.size()), p);
+    p += 4;
+    memcpy(p, message.constData(), message.size());
+    fwrite(out.constData(), 1, out.size(), m_file);
+}
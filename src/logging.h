@@ -0,0 +1,116 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QLoggingCategory>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+// Logging categories. Debug output is off unless enabled by [app_live]
+// log_rules (e.g. "gladis.config.debug=true") or QT_LOGGING_RULES; a disabled
+// qCDebug() costs one flag check, the message is never formatted. Builds
+// configured with GLADIS_DEBUG_LOG=OFF compile qDebug/qCDebug out entirely.
+Q_DECLARE_LOGGING_CATEGORY(lcConfig)   // gladis.config
+Q_DECLARE_LOGGING_CATEGORY(lcData)     // gladis.data
+
+// Asynchronous log writer, installed as the Qt message handler.
+//
+// The handler only moves the formatted message into a fixed-size lock-free
+// ring (multi-producer, any thread); a background thread drains it every
+// DrainIntervalMs, applies the per-category rate limit and writes the batch.
+// A full ring drops the message and counts it instead of blocking the caller.
+//
+// Output ([app_live] log_output):
+//   empty / "stderr"   text lines on stderr (journald under systemd)
+//   *.jsonl            one JSON object per line (time, level, category, thread, message)
+//   anything else      binary records, see writeBinary()
+class AsyncLogger
+{
+public:
+    static const int Capacity = 4096;           // Power of two
+    static const int DrainIntervalMs = 25;
+
+    static AsyncLogger *instance();
+
+    // Installs the message handler and starts the writer; flushed at exit
+    void install();
+    // Stops the writer after writing everything queued (also runs at exit)
+    void shutdown();
+
+    void setOutput(const QString &output);
+    // Messages per second and category, warnings included (0 = unlimited)
+    void setRateLimit(int messagesPerSecond);
+
+    // Category rules from the config, ';' separated like QT_LOGGING_RULES
+    void setRules(const QString &rules);
+    // Rules owned by code (e.g. the render stats texture category), kept across setRules()
+    void setRuleOverride(const QString &category, bool enabled);
+
+    quint64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        qint64 timeNs = 0;           // Wall clock, ns since epoch
+        QtMsgType type = QtDebugMsg;
+        char category[40] = {};
+        quintptr thread = 0;
+        QString message;
+    };
+
+    struct Slot {
+        std::atomic<quint64> sequence;
+        Record record;
+    };
+
+    struct Bucket {
+        qint64 windowStartNs = 0;
+        int count = 0;
+        int suppressed = 0;
+    };
+
+    AsyncLogger();
+
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    bool enqueue(QtMsgType type, const char *category, const QString &message);
+    bool dequeue(Record *record);
+
+    void writerLoop();
+    void drain();
+    bool allow(const Record &record);
+    void write(const Record &record);
+    void writeText(const Record &record);
+    void writeJson(const Record &record);
+    void writeBinary(const Record &record);
+    void applyPendingConfig();
+    void applyRules();
+
+    Slot *m_slots;
+    std::atomic<quint64> m_enqueuePos;
+    quint64 m_dequeuePos;   // Writer thread only
+    std::atomic<quint64> m_dropped;
+    std::atomic<bool> m_running;
+    std::thread m_writer;
+    bool m_installed;
+
+    // Set from the GUI thread, picked up by the writer between batches
+    QMutex m_configMutex;
+    QString m_pendingOutput;
+    bool m_outputChanged;
+    std::atomic<int> m_rateLimit;
+
+    // Writer thread only
+    enum Format { TextFormat, JsonFormat, BinaryFormat };
+    Format m_format;
+    FILE *m_file;
+    QHash<QByteArray, Bucket> m_buckets;
+    quint64 m_reportedDropped;
+
+    QMutex m_rulesMutex;
+    QString m_rules;
+    QHash<QString, bool> m_ruleOverrides;
+};
+
+#endif // LOGGING_H
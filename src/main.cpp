@@ -1,20 +1,64 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickWindow>
 #include <QSurfaceFormat>
 #include <QDir>
 #include <QFile>
+#include <QCommandLineParser>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
 #include "datamanager.h"
 #include "configmanager.h"
 #include "fileiohelper.h"
+#include "eventjournal.h"
+#include "journalreplayer.h"
+#include "framesnapshot.h"
+#include "soakrunner.h"
+#include "virtualclock.h"
+#include "framestats.h"
+#include "metrics.h"
+#include "metricsserver.h"
+#include "buttonlatency.h"
+#include "renderstats.h"
+#include "qualitygovernor.h"
+#include "displayrotation.h"
+#include "renderbenchmark.h"
+#include "renderbackend.h"
+#include "transitionitem.h"
+#include "playlistscheduler.h"
+#include "screenmanager.h"
+#include "videostats.h"
+#include "statesnapshot.h"
+#include "pipelinecache.h"
+#include "glyphcache.h"
+#include "logging.h"
+
+// SIGUSR1 wakes a warm standby, SIGTERM quits cleanly (state snapshot saved);
+// the handler only writes the signal number to a socket pair that a
+// QSocketNotifier watches in the event loop
+static int signalFd[2] = { -1, -1 };
+
+static void signalHandler(int signal)
+{
+    char byte = char(signal);
+    ssize_t written = ::write(signalFd[0], &byte, sizeof(byte));
+    Q_UNUSED(written);
+}
 
 int main(int argc, char *argv[])
 {
-    // Enable vsync for smooth animations (critical for Raspberry Pi)
-    QSurfaceFormat format;
-    format.setSwapInterval(1);  // 1 = vsync enabled, 0 = vsync disabled
-    QSurfaceFormat::setDefaultFormat(format);
+    // Time to first frame for --benchmark-startup
+    QElapsedTimer startupClock;
+    startupClock.start();
+
+    // Log output is written by a background thread from here on ([app_live] log_*)
+    AsyncLogger::instance()->install();
 
     // Enable high DPI scaling
     QGuiApplication::setHighDpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy::PassThrough);
@@ -26,6 +70,66 @@ int main(int argc, char *argv[])
     app.setOrganizationDomain("gamelab.com");
     app.setApplicationName("GLADIS");
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption journalOption("journal",
+        "Record config/data/input events to a binary journal.", "file");
+    QCommandLineOption replayOption("replay",
+        "Replay a recorded journal, print frame stats and exit.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay speed factor (1 = recorded timing).", "factor", "1");
+    QCommandLineOption benchmarkOption("benchmark",
+        "Render continuously with vsync off, print frame cost and text sharpness and exit.", "seconds");
+    QCommandLineOption benchmarkOutputOption("benchmark-output",
+        "Append benchmark results to a CSV file (window grabs are saved next to it).", "file");
+    QCommandLineOption benchmarkStartupOption("benchmark-startup",
+        "With --benchmark: measure from launch with vsync on (time to first frame, jank of the first seconds).");
+    QCommandLineOption rotateModeOption("rotate-mode",
+        "Override render_rotate_mode: auto, platform, offscreen or transform.", "mode");
+    QCommandLineOption renderBackendOption("render-backend",
+        "Override render_backend: opengl, vulkan or software.", "backend");
+    QCommandLineOption configOverlayOption("config-overlay",
+        "Extra config overlay merged over gladis.ini (highest precedence).", "file");
+    QCommandLineOption standbyOption("standby",
+        "Load everything with the window hidden and take over on SIGUSR1 (warm standby, see gladis-supervisor.sh).");
+    QCommandLineOption soakOption("soak",
+        "Run simulated kiosk time on a virtual clock as fast as possible with config/data churn, print resource growth and exit.", "hours");
+    QCommandLineOption soakScriptOption("soak-script",
+        "Churn script for --soak (default: data every 10 min, config every hour).", "file");
+    QCommandLineOption soakOutputOption("soak-output",
+        "Write --soak samples (one per simulated hour) to a CSV file.", "file", "soak-results/soak.csv");
+    QCommandLineOption soakStepOption("soak-step",
+        "Virtual milliseconds per --soak step.", "ms", "250");
+    parser.addOptions({ journalOption, replayOption, replaySpeedOption, benchmarkOption,
+                        benchmarkOutputOption, benchmarkStartupOption, rotateModeOption, renderBackendOption, configOverlayOption, standbyOption,
+                        soakOption, soakScriptOption, soakOutputOption, soakStepOption });
+    parser.process(app);
+
+    bool benchmarking = parser.isSet(benchmarkOption);
+    bool benchmarkingStartup = benchmarking && parser.isSet(benchmarkStartupOption);
+
+    // Soak runs put content timers and QML animations on a virtual clock; it has to be
+    // in place before the first timer is created. Animations only follow the installed
+    // driver with the GUI-thread render loop.
+    bool soaking = parser.isSet(soakOption) && !parser.isSet(replayOption) && !benchmarking;
+    if (soaking) {
+        qputenv("QSG_RENDER_LOOP", "basic");
+        VirtualClock::instance()->enableVirtual(QDateTime::currentDateTime());
+    }
+
+    // Catch the takeover and stop signals from the start, a SIGUSR1 that arrives
+    // while the QML is still loading waits in the socket pair
+    bool standby = parser.isSet(standbyOption) && !parser.isSet(replayOption) && !benchmarking && !soaking;
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFd) == 0) {
+        std::signal(SIGTERM, signalHandler);
+        if (standby) {
+            std::signal(SIGUSR1, signalHandler);
+        }
+    } else if (standby) {
+        qWarning() << "Standby: cannot create signal socket pair, starting active";
+        standby = false;
+    }
+
     // Create data manager
     DataManager dataManager;
 
@@ -35,39 +139,213 @@ int main(int argc, char *argv[])
     // Create file I/O helper
     FileIOHelper fileIOHelper;
 
+    // Button press -> controller ack round-trip tracing
+    ButtonLatencyTracker buttonLatency(&fileIOHelper);
+    QObject::connect(&configManager, &ConfigManager::liveChanged, &buttonLatency, [&]() {
+        buttonLatency.setOutlierThreshold(configManager.buttonOutlierMs());
+    });
+
+    // Optional event journal (record) or journal replay
+    EventJournal journal;
+    JournalReplayer replayer;
+    FrameStats frameStats;
+    SoakRunner soakRunner;
+    if (soaking && !soakRunner.loadScript(parser.value(soakScriptOption))) {
+        return -1;
+    }
+    bool replaying = parser.isSet(replayOption);
+    if (replaying) {
+        if (!replayer.load(parser.value(replayOption)) || !replayer.prepare()) {
+            return -1;
+        }
+        replayer.setSpeed(parser.value(replaySpeedOption).toDouble());
+    } else if (parser.isSet(journalOption) && journal.open(parser.value(journalOption))) {
+        journal.attach(&configManager, &dataManager);
+    }
+
+    // Data is loaded on demand: only for apps configured on a layer, starting
+    // as soon as the layer is configured (before its Loader becomes active)
+    QObject::connect(&configManager, &ConfigManager::layerAppsChanged,
+                     &dataManager, &DataManager::setActiveApps);
+
+    // app_image playlist mode, scheduled and decoded ahead in C++; runs only while app_image is on a layer
+    PlaylistScheduler playlist;
+    QObject::connect(&configManager, &ConfigManager::layerAppsChanged, &playlist,
+                     [&playlist](const QStringList &apps) { playlist.setEnabled(apps.contains("app_image")); });
+    auto configurePlaylist = [&]() {
+        playlist.setTargetSize(QSize(configManager.renderWidth(), configManager.renderHeight()));
+        playlist.setPlaylist(configManager.imagePlaylist(), configManager.imageDuration(), configManager.imagePreload());
+    };
+    QObject::connect(&configManager, &ConfigManager::imageChanged, &playlist, configurePlaylist);
+    QObject::connect(&configManager, &ConfigManager::liveChanged, &playlist, configurePlaylist);
+
     // Set data path and config path based on deployment location
-    // Check if ~/app/vars exists (Pi deployment), otherwise use welcome-data (local dev)
+    // ~/app/vars on the Pi (deployment), otherwise welcome-data (local dev)
     QString piDataPath = QDir::homePath() + "/app/vars";
-    QString piConfigPath = "/dev/shm/app/gladis.ini";
     QString localDataPath = "welcome-data";
-    QString localConfigPath = "gladis.ini";
-    QString defaultConfigPath = "gladis.ini";  // Default fallback
-
-    if (QDir(piDataPath).exists()) {
-        qDebug() << "Running on Pi - using data path:" << piDataPath;
-        dataManager.setDataPath(piDataPath);
-
-        // Try Pi config first, fallback to default if not present
-        if (QFile::exists(piConfigPath)) {
-            qDebug() << "Using Pi config:" << piConfigPath;
-            configManager.setConfigPath(piConfigPath);
-        } else {
-            qDebug() << "Pi config not found, falling back to default:" << defaultConfigPath;
-            configManager.setConfigPath(defaultConfigPath);
+
+    // gladis.ini is the static base; the runtime config written to
+    // /dev/shm/app/gladis.ini is layered over it via [app_live] live_config
+    QString configPath = "gladis.ini";
+
+    // A content bundle (gladis-pack or gladis-sync output) takes precedence over its
+    // directory; ~/app/vars.bundle may be published without a ~/app/vars directory
+    QString dataPath = localDataPath;
+    if (QFile::exists(piDataPath + ".bundle")) {
+        dataPath = piDataPath + ".bundle";
+    } else if (QDir(piDataPath).exists()) {
+        dataPath = piDataPath;
+    } else if (QFile::exists(localDataPath + ".bundle")) {
+        dataPath = localDataPath + ".bundle";
+    }
+    if (replaying) {
+        // Recorded paths, mirrored into the replay sandbox
+        dataPath = replayer.dataPath();
+        configPath = replayer.configPath();
+        configManager.setPathRoot(replayer.sandboxRoot());
+        qDebug() << "Replaying - using data path:" << dataPath;
+    } else if (soaking) {
+        // Copies the churn can rewrite, mirrored like the replay sandbox
+        if (!soakRunner.prepare(configPath, dataPath, { parser.value(configOverlayOption) })) {
+            return -1;
         }
+        dataPath = soakRunner.dataPath();
+        configPath = soakRunner.configPath();
+        configManager.setPathRoot(soakRunner.sandboxRoot());
+        qDebug() << "Soak - using data path:" << dataPath;
+    } else if (dataPath.startsWith(piDataPath)) {
+        qDebug() << "Running on Pi - using data path:" << dataPath;
     } else {
-        qDebug() << "Running locally - using data path:" << localDataPath;
-        dataManager.setDataPath(localDataPath);
-        configManager.setConfigPath(localConfigPath);
+        qDebug() << "Running locally - using data path:" << dataPath;
+    }
+
+    journal.recordSession(configPath, dataPath);
+    dataManager.setDataPath(dataPath);
+    configManager.addOverlayPath(parser.value(configOverlayOption));
+    configManager.setConfigPath(configPath);
+
+    auto configureLogging = [&]() {
+        AsyncLogger::instance()->setOutput(configManager.logOutput());
+        AsyncLogger::instance()->setRateLimit(configManager.logRateLimit());
+        AsyncLogger::instance()->setRules(configManager.logRules());
+    };
+    configureLogging();
+    QObject::connect(&configManager, &ConfigManager::liveChanged, &app, configureLogging);
+
+    // Graphics API ([app_live] render_backend) and vsync, before the first window exists.
+    // Vsync keeps animations smooth (critical for Raspberry Pi); benchmark frames are not
+    // capped by the refresh rate. Startup benchmarks keep vsync: they look for missed
+    // refreshes, not frame cost
+    RenderBackend renderBackend;
+    renderBackend.setOverride(parser.value(renderBackendOption));
+    renderBackend.apply(configManager.renderBackend(), !benchmarking || benchmarkingStartup);
+    configurePlaylist();
+
+    // Running state kept across restarts ([app_live] state_snapshot). Replays and
+    // benchmarks start from a clean state and leave the snapshot alone.
+    bool useSnapshot = !replaying && !benchmarking && !soaking;
+    StateSnapshot stateSnapshot;
+    auto configureSnapshot = [&]() {
+        stateSnapshot.setPath(useSnapshot ? configManager.stateSnapshot() : QString());
+        stateSnapshot.setInterval(configManager.stateSnapshotInterval());
+        stateSnapshot.setMaxAge(configManager.stateSnapshotMaxAge() * 1000);
+    };
+    configureSnapshot();
+    QObject::connect(&configManager, &ConfigManager::liveChanged, &stateSnapshot, configureSnapshot);
+    if (!standby) {
+        // Before the QML loads, so apps pick their state up when they are created
+        stateSnapshot.restore();
+    }
+
+    // Where render_rotate is applied: display stack, offscreen blit or item transform
+    DisplayRotation displayRotation;
+    displayRotation.setModeOverride(parser.value(rotateModeOption));
+    auto configureRotation = [&]() {
+        displayRotation.setConfig(configManager.renderRotate(), configManager.renderRotateMode(),
+                                  QSize(configManager.renderWidth(), configManager.renderHeight()));
+    };
+    configureRotation();
+    QObject::connect(&configManager, &ConfigManager::liveChanged, &displayRotation, configureRotation);
+
+    // Metrics endpoint follows [app_live] metrics_port / metrics_socket; a standby
+    // leaves the port to the active process until it takes over
+    MetricsServer metricsServer;
+    auto configureMetricsServer = [&]() {
+        metricsServer.listen(configManager.metricsPort(), configManager.metricsSocket());
+    };
+    if (!standby) {
+        configureMetricsServer();
+        QObject::connect(&configManager, &ConfigManager::liveChanged, &metricsServer, configureMetricsServer);
     }
 
+    // Render statistics overlay; batch counting has to be set up before the scene graph exists
+    RenderStats renderStats;
+    if (configManager.renderStats()) {
+        RenderStats::enableBatchCounting();
+    }
+
+    // Adaptive quality tiers, settings follow [app_live]
+    QualityGovernor qualityGovernor;
+    RenderBenchmark renderBenchmark;
+
+    // Graphics pipelines persisted across launches ([app_live] render_pipeline_cache)
+    PipelineCache pipelineCache;
+
+    // Thumbnail of the composed frame for remote support ([app_live] frame_snapshot);
+    // replays, benchmarks and soak runs measure the frames without it
+    FrameSnapshot frameSnapshot;
+    auto configureFrameSnapshot = [&]() {
+        frameSnapshot.configure(configManager.frameSnapshot(), configManager.frameSnapshotInterval(),
+                                configManager.frameSnapshotWidth());
+    };
+
+    // Characters to prewarm into the glyph atlas: Latin-1 plus everything config and
+    // data strings have shown so far ([app_live] render_glyph_cache)
+    GlyphCache glyphCache;
+    glyphCache.setPath(configManager.renderGlyphCache());
+    glyphCache.addStrings(&configManager);
+    glyphCache.addStrings(&dataManager);
+    QObject::connect(&configManager, &ConfigManager::configChanged, &glyphCache, [&]() {
+        glyphCache.setPath(configManager.renderGlyphCache());
+        glyphCache.addStrings(&configManager);
+    });
+    QObject::connect(&dataManager, &DataManager::slotChanged, &glyphCache, [&]() {
+        glyphCache.addStrings(&dataManager);
+    });
+
+    // app_video playback statistics (dropped frames, frame delay, frame path)
+    VideoStats videoStats;
+    auto configureGovernor = [&]() {
+        qualityGovernor.setThermalPath(configManager.qualityThermalZone());
+        qualityGovernor.setTemperatureLimits(configManager.qualityTempHigh(), configManager.qualityTempLow());
+        qualityGovernor.setEnabled(configManager.qualityGovernor());
+    };
+
+    // GPU image transitions (SwapImageAnimation, WindshieldWiperImages, ImageApp)
+    qmlRegisterType<TransitionItem>("Gladis", 1, 0, "TransitionItem");
+
     // Create QML engine
     QQmlApplicationEngine engine;
 
-    // Expose DataManager, ConfigManager, and FileIOHelper to QML
+    // Expose DataManager, ConfigManager, FileIOHelper and instrumentation to QML
     engine.rootContext()->setContextProperty("dataManager", &dataManager);
     engine.rootContext()->setContextProperty("configManager", &configManager);
     engine.rootContext()->setContextProperty("fileIO", &fileIOHelper);
+    engine.rootContext()->setContextProperty("metrics", Metrics::instance());
+    engine.rootContext()->setContextProperty("buttonLatency", &buttonLatency);
+    engine.rootContext()->setContextProperty("renderStats", &renderStats);
+    engine.rootContext()->setContextProperty("qualityGovernor", &qualityGovernor);
+    engine.rootContext()->setContextProperty("displayRotation", &displayRotation);
+    engine.rootContext()->setContextProperty("renderBackend", &renderBackend);
+    engine.rootContext()->setContextProperty("playlist", &playlist);
+    engine.rootContext()->setContextProperty("videoStats", &videoStats);
+    engine.rootContext()->setContextProperty("stateSnapshot", &stateSnapshot);
+    engine.rootContext()->setContextProperty("glyphCache", &glyphCache);
+    engine.rootContext()->setContextProperty("clock", VirtualClock::instance());
+    // Extra screens override it in their own context (ScreenManager)
+    engine.rootContext()->setContextProperty("screenPrefix", QString());
+    engine.addImageProvider("playlist", new PlaylistImageProvider(&playlist));
+    engine.addImageProvider("bundle", new BundleImageProvider(&dataManager));
 
     // Load main QML file
     const QUrl url(QStringLiteral("qrc:/main.qml"));
@@ -82,13 +360,20 @@ int main(int argc, char *argv[])
         },
         Qt::QueuedConnection);
 
+    // A standby must not react to the button/reset files the active process handles
+    if (standby) {
+        engine.setInitialProperties({ { "standby", true } });
+        fileIOHelper.blockSignals(true);
+    }
+
     engine.load(url);
 
     if (engine.rootObjects().isEmpty()) {
         return -1;
     }
 
-    // Force vsync on the window after it's created (critical for Pi5)
+    // Force vsync on the window after it's created (critical for Pi5); the swap
+    // interval only matters to OpenGL, see RenderBackend for the other APIs
     QObject *rootObject = engine.rootObjects().first();
     QQuickWindow *window = qobject_cast<QQuickWindow *>(rootObject);
     if (window) {
@@ -96,13 +381,135 @@ int main(int argc, char *argv[])
 
         // Set the format with swap interval on the actual window
         QSurfaceFormat windowFormat = window->format();
-        windowFormat.setSwapInterval(1);
+        windowFormat.setSwapInterval(renderBackend.vsync() ? 1 : 0);
         window->setFormat(windowFormat);
 
         qDebug() << "Window format swap interval:" << window->format().swapInterval();
+        renderBackend.attach(window);
+
+        // Before the first expose, while the scene graph is not initialized yet
+        pipelineCache.setPath(configManager.renderPipelineCache());
+        pipelineCache.attach(window);
+
+        buttonLatency.attachWindow(window);
+
+        renderStats.attach(window);
+        renderStats.setEnabled(configManager.renderStats());
+        QObject::connect(&configManager, &ConfigManager::liveChanged, &renderStats, [&]() {
+            renderStats.setEnabled(configManager.renderStats());
+        });
+
+        displayRotation.attach(window);
+
+        if (!replaying && !benchmarking && !soaking) {
+            frameSnapshot.attach(window);
+            frameSnapshot.setPaused(standby);
+            configureFrameSnapshot();
+            QObject::connect(&configManager, &ConfigManager::liveChanged, &frameSnapshot, configureFrameSnapshot);
+        }
+
+        // The governor stays off while benchmarking so every run renders at full quality
+        qualityGovernor.attach(window);
+        if (!benchmarking) {
+            configureGovernor();
+            QObject::connect(&configManager, &ConfigManager::liveChanged, &qualityGovernor, configureGovernor);
+        }
+        if (journal.isOpen()) {
+            journal.attachInput(window);
+        }
+        if (replaying) {
+            frameStats.attach(window);
+            replayer.setWindow(window);
+            QObject::connect(&replayer, &JournalReplayer::finished, &app, [&]() {
+                qInfo().noquote() << "REPLAY" << replayer.summaryLine();
+                qInfo().noquote() << "FRAMESTATS" << frameStats.summaryLine();
+                qInfo().noquote() << "BUTTONS" << buttonLatency.summaryLine();
+                qInfo().noquote() << "VIDEO" << videoStats.summaryLine();
+                QCoreApplication::quit();
+            });
+            QTimer::singleShot(0, &replayer, &JournalReplayer::start);
+        } else if (benchmarking) {
+            renderBenchmark.setDuration(2000, qRound(parser.value(benchmarkOption).toDouble() * 1000));
+            renderBenchmark.setOutputPath(parser.value(benchmarkOutputOption));
+            renderBenchmark.setRenderBackend(&renderBackend);
+            QObject::connect(&renderBenchmark, &RenderBenchmark::finished, &app, &QCoreApplication::quit);
+            if (benchmarkingStartup) {
+                // Startup runs compare launches with and without the pipeline cache
+                renderBenchmark.setStartupClock(startupClock);
+                renderBenchmark.setLabel("pipeline-cache-" + pipelineCache.state());
+                renderBenchmark.start(window);
+            } else {
+                QTimer::singleShot(0, &renderBenchmark, [&]() {
+                    renderBenchmark.setLabel(displayRotation.mode());
+                    renderBenchmark.start(window);
+                });
+            }
+        } else if (soaking) {
+            soakRunner.setDuration(qint64(parser.value(soakOption).toDouble() * 3600 * 1000));
+            soakRunner.setStep(parser.value(soakStepOption).toInt());
+            soakRunner.setOutputPath(parser.value(soakOutputOption));
+            QObject::connect(&soakRunner, &SoakRunner::finished, &app, [&]() {
+                qInfo().noquote() << "SOAK" << soakRunner.summaryLine();
+                QCoreApplication::quit();
+            });
+            QTimer::singleShot(0, &soakRunner, [&]() {
+                soakRunner.start(window);
+            });
+        }
     } else {
         qDebug() << "Warning: Could not cast root object to QQuickWindow";
     }
 
+    // Extra output windows ([app_screen_N]) in the same engine
+    ScreenManager screenManager(&engine, &configManager);
+    screenManager.setStandby(standby);
+    screenManager.attachPrimary(window);
+    screenManager.sync();
+
+    // Warm standby: take over on SIGUSR1 with the state the previous process left behind
+    auto activate = [&]() {
+        fileIOHelper.blockSignals(false);
+        rootObject->setProperty("standby", false);
+        screenManager.setStandby(false);
+        frameSnapshot.setPaused(false);
+        configureMetricsServer();
+        QObject::connect(&configManager, &ConfigManager::liveChanged, &metricsServer, configureMetricsServer);
+        stateSnapshot.start();
+    };
+    bool takeoverPending = standby;
+    if (signalFd[1] >= 0) {
+        QSocketNotifier *signalNotifier = new QSocketNotifier(signalFd[1], QSocketNotifier::Read, &app);
+        QObject::connect(signalNotifier, &QSocketNotifier::activated, &app, [&]() {
+            char byte = 0;
+            ssize_t readBytes = ::read(signalFd[1], &byte, sizeof(byte));
+            Q_UNUSED(readBytes);
+
+            if (byte == SIGTERM) {
+                // Through aboutToQuit, so the active process leaves its state behind
+                qDebug() << "SIGTERM: quitting";
+                QCoreApplication::quit();
+            } else if (byte == SIGUSR1 && takeoverPending) {
+                takeoverPending = false;
+                qDebug() << "Standby: taking over";
+                stateSnapshot.restore();
+                activate();
+            }
+        });
+    }
+    if (standby) {
+        qDebug() << "Standby: ready, waiting for SIGUSR1 (pid" << QCoreApplication::applicationPid() << ")";
+    } else {
+        stateSnapshot.start();
+    }
+
+    // Last state on a clean shutdown
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &stateSnapshot, [&]() {
+        if (!rootObject->property("standby").toBool()) {
+            stateSnapshot.save();
+        }
+    });
+
+    journal.recordStarted();
+
     return app.exec();
 }
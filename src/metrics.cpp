@@ -0,0 +1,250 @@
+#include "metrics.h"
+#include <QMutexLocker>
+#include <QFile>
+#include <QDir>
+#include <QSet>
+#include <QTextStream>
+#include <QHash>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+
+QString formatValue(double value)
+{
+    return QString::number(value, 'g', 12);
+}
+
+QString seriesName(const QString &name, const QString &labels, const QString &extra = QString())
+{
+    QString all = labels;
+    if (!extra.isEmpty()) {
+        all = all.isEmpty() ? extra : all + "," + extra;
+    }
+    return all.isEmpty() ? name : name + "{" + all + "}";
+}
+
+// "1234 KiB" -> bytes
+double parseMemory(const QString &text)
+{
+    QStringList parts = text.simplified().split(' ');
+    double value = parts.value(0).toDouble();
+    QString unit = parts.value(1);
+    if (unit == "KiB" || unit == "kB") return value * 1024.0;
+    if (unit == "MiB") return value * 1024.0 * 1024.0;
+    if (unit == "GiB") return value * 1024.0 * 1024.0 * 1024.0;
+    return value;
+}
+
+} // namespace
+
+Metrics *Metrics::instance()
+{
+    static Metrics *metrics = new Metrics();
+    return metrics;
+}
+
+Metrics::Metrics(QObject *parent)
+    : QObject(parent)
+{
+    // Seconds; covers sub-millisecond parses up to multi-second stalls
+    m_bucketBounds = { 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                       0.1, 0.25, 0.5, 1.0, 2.5, 5.0 };
+
+    describe("gladis_config_load_seconds", Histogram, "Full config load (all sources) duration");
+    describe("gladis_config_reload_seconds", Histogram, "Incremental reload of one config source");
+    describe("gladis_config_noop_reloads_total", Counter, "Config file events that changed no keys");
+    describe("gladis_watcher_events_total", Counter, "QFileSystemWatcher notifications received");
+    describe("gladis_watcher_events_coalesced_total", Counter, "Watcher notifications folded into an already pending reload");
+    describe("gladis_data_unstable_retries_total", Counter, "Data reloads postponed because the file was still being written");
+    describe("gladis_data_reload_latency_seconds", Histogram, "Data file change event to applied slot value");
+    describe("gladis_fileio_writes_coalesced_total", Counter, "Async writes replaced by a newer write to the same path");
+    describe("gladis_image_decode_seconds", Histogram, "QML image source change to Image.Ready (load + decode)");
+    describe("gladis_process_resident_bytes", Gauge, "Resident set size");
+    describe("gladis_process_open_fds", Gauge, "Open file descriptors");
+    describe("gladis_gpu_memory_bytes", Gauge, "GPU buffer memory resident for this process (DRM fdinfo)");
+    describe("gladis_cma_total_bytes", Gauge, "Contiguous memory allocator pool size (system-wide)");
+    describe("gladis_cma_free_bytes", Gauge, "Contiguous memory allocator free memory (system-wide)");
+}
+
+void Metrics::describe(const QString &name, Type type, const QString &help)
+{
+    QMutexLocker locker(&m_mutex);
+    Family &family = m_families[name];
+    family.type = type;
+    family.help = help;
+}
+
+Metrics::Family &Metrics::familyLocked(const QString &name, Type type)
+{
+    auto it = m_families.find(name);
+    if (it == m_families.end()) {
+        it = m_families.insert(name, Family());
+        it->type = type;
+    }
+    return it.value();
+}
+
+void Metrics::increment(const QString &name, const QString &labels, double by)
+{
+    QMutexLocker locker(&m_mutex);
+    familyLocked(name, Counter).series[labels].value += by;
+}
+
+void Metrics::setGauge(const QString &name, double value, const QString &labels)
+{
+    QMutexLocker locker(&m_mutex);
+    familyLocked(name, Gauge).series[labels].value = value;
+}
+
+void Metrics::observe(const QString &name, double seconds, const QString &labels)
+{
+    QMutexLocker locker(&m_mutex);
+    Series &series = familyLocked(name, Histogram).series[labels];
+    if (series.buckets.isEmpty()) {
+        series.buckets.resize(m_bucketBounds.size() + 1);  // Last one is +Inf
+    }
+
+    int bucket = 0;
+    while (bucket < m_bucketBounds.size() && seconds > m_bucketBounds.at(bucket)) {
+        bucket++;
+    }
+    series.buckets[bucket]++;
+    series.sum += seconds;
+    series.count++;
+}
+
+void Metrics::observeMs(const QString &name, double milliseconds, const QString &labels)
+{
+    observe(name, milliseconds / 1000.0, labels);
+}
+
+QString Metrics::label(const QString &key, const QString &value)
+{
+    QString escaped = value;
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    return key + "=\"" + escaped + "\"";
+}
+
+QByteArray Metrics::exposition()
+{
+    sampleProcess();
+
+    QMutexLocker locker(&m_mutex);
+    QString out;
+    QTextStream stream(&out);
+
+    for (auto it = m_families.constBegin(); it != m_families.constEnd(); ++it) {
+        const Family &family = it.value();
+        if (family.series.isEmpty()) {
+            continue;
+        }
+
+        const char *type = family.type == Counter ? "counter" : family.type == Gauge ? "gauge" : "histogram";
+        if (!family.help.isEmpty()) {
+            stream << "# HELP " << it.key() << " " << family.help << "\n";
+        }
+        stream << "# TYPE " << it.key() << " " << type << "\n";
+
+        for (auto series = family.series.constBegin(); series != family.series.constEnd(); ++series) {
+            if (family.type != Histogram) {
+                stream << seriesName(it.key(), series.key()) << " " << formatValue(series->value) << "\n";
+                continue;
+            }
+
+            quint64 cumulative = 0;
+            for (int b = 0; b < series->buckets.size(); b++) {
+                cumulative += series->buckets.at(b);
+                QString bound = b < m_bucketBounds.size() ? formatValue(m_bucketBounds.at(b)) : "+Inf";
+                stream << seriesName(it.key() + "_bucket", series.key(), label("le", bound))
+                       << " " << cumulative << "\n";
+            }
+            stream << seriesName(it.key() + "_sum", series.key()) << " " << formatValue(series->sum) << "\n";
+            stream << seriesName(it.key() + "_count", series.key()) << " " << series->count << "\n";
+        }
+    }
+
+    stream.flush();
+    return out.toUtf8();
+}
+
+void Metrics::sampleProcess()
+{
+#ifdef Q_OS_LINUX
+    // statm: size resident shared ... (pages)
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            setGauge("gladis_process_resident_bytes", fields.at(1).toDouble() * sysconf(_SC_PAGESIZE));
+        }
+    }
+
+    QDir fdDir("/proc/self/fd");
+    setGauge("gladis_process_open_fds", fdDir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System).size());
+
+    // GPU buffers: DRM fdinfo (v3d/vc4 on the Pi, most desktop drivers too).
+    // drm-resident-<region> where available, the older drm-memory-<region> otherwise.
+    // Several fds can share one DRM client, count each client once.
+    QHash<QString, double> driverBytes;
+    QSet<QString> clients;
+    QDir fdinfoDir("/proc/self/fdinfo");
+    const QStringList fds = fdinfoDir.entryList(QDir::Files);
+    for (const QString &fd : fds) {
+        QFile info(fdinfoDir.filePath(fd));
+        if (!info.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QString text = QString::fromUtf8(info.readAll());
+        if (!text.contains("drm-driver:")) {
+            continue;
+        }
+
+        QString driver;
+        QString client;
+        double resident = 0.0;
+        double legacy = 0.0;
+        const QStringList lines = text.split('\n');
+        for (const QString &line : lines) {
+            int colon = line.indexOf(':');
+            if (colon < 0) {
+                continue;
+            }
+            QString key = line.left(colon);
+            QString value = line.mid(colon + 1).trimmed();
+            if (key == "drm-driver") {
+                driver = value;
+            } else if (key == "drm-client-id") {
+                client = value;
+            } else if (key.startsWith("drm-resident-")) {
+                resident += parseMemory(value);
+            } else if (key.startsWith("drm-memory-")) {
+                legacy += parseMemory(value);
+            }
+        }
+
+        if (!client.isEmpty() && clients.contains(driver + client)) {
+            continue;
+        }
+        clients.insert(driver + client);
+        driverBytes[driver] += resident > 0.0 ? resident : legacy;
+    }
+    for (auto it = driverBytes.constBegin(); it != driverBytes.constEnd(); ++it) {
+        setGauge("gladis_gpu_memory_bytes", it.value(), label("driver", it.key()));
+    }
+
+    // Older Pi GPU stacks (vc4) allocate from CMA; system-wide but still telling
+    QFile meminfo("/proc/meminfo");
+    if (meminfo.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = meminfo.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("CmaTotal:")) {
+                setGauge("gladis_cma_total_bytes", parseMemory(QString::fromLatin1(line.mid(9))));
+            } else if (line.startsWith("CmaFree:")) {
+                setGauge("gladis_cma_free_bytes", parseMemory(QString::fromLatin1(line.mid(8))));
+            }
+        }
+    }
+#endif
+}
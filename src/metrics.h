@@ -0,0 +1,67 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QVector>
+#include <QMutex>
+#include <QByteArray>
+
+// Process-wide registry of counters, gauges and histograms, rendered in the
+// Prometheus text exposition format by MetricsServer. Safe to call from any
+// thread. Series are identified by metric name plus a label string such as
+// `source="config"` (see label()).
+class Metrics : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Type {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    static Metrics *instance();
+
+    void describe(const QString &name, Type type, const QString &help);
+
+    Q_INVOKABLE void increment(const QString &name, const QString &labels = QString(), double by = 1.0);
+    Q_INVOKABLE void setGauge(const QString &name, double value, const QString &labels = QString());
+    void observe(const QString &name, double seconds, const QString &labels = QString());
+
+    // For QML, where timings come from Date.now() in milliseconds
+    Q_INVOKABLE void observeMs(const QString &name, double milliseconds, const QString &labels = QString());
+
+    // `key="value"` with the value escaped for the exposition format
+    Q_INVOKABLE static QString label(const QString &key, const QString &value);
+
+    // Full scrape body; process/GPU memory gauges are sampled on each call
+    QByteArray exposition();
+
+private:
+    explicit Metrics(QObject *parent = nullptr);
+
+    struct Series {
+        double value = 0.0;
+        QVector<quint64> buckets;   // Histograms: non-cumulative counts per bucket
+        double sum = 0.0;
+        quint64 count = 0;
+    };
+
+    struct Family {
+        Type type = Counter;
+        QString help;
+        QMap<QString, Series> series;  // Label string -> series
+    };
+
+    Family &familyLocked(const QString &name, Type type);
+    void sampleProcess();
+
+    mutable QMutex m_mutex;
+    QMap<QString, Family> m_families;
+    QVector<double> m_bucketBounds;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,109 @@
+#include "metricsserver.h"
+#include "metrics.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QHostAddress>
+#include <QDebug>
+
+MetricsServer::MetricsServer(QObject *parent)
+    : QObject(parent)
+    , m_tcpServer(new QTcpServer(this))
+    , m_localServer(new QLocalServer(this))
+    , m_port(0)
+{
+    connect(m_tcpServer, &QTcpServer::newConnection, this, [this]() {
+        while (QTcpSocket *socket = m_tcpServer->nextPendingConnection()) {
+            handleConnection(socket);
+        }
+    });
+    connect(m_localServer, &QLocalServer::newConnection, this, [this]() {
+        while (QLocalSocket *socket = m_localServer->nextPendingConnection()) {
+            handleConnection(socket);
+        }
+    });
+}
+
+void MetricsServer::listen(int port, const QString &socketPath)
+{
+    if (port != m_port) {
+        m_tcpServer->close();
+        m_port = port;
+        if (m_port > 0) {
+            if (m_tcpServer->listen(QHostAddress::LocalHost, quint16(m_port))) {
+                qDebug() << "Metrics served on http://127.0.0.1:" << m_port << "/metrics";
+            } else {
+                qWarning() << "Metrics: cannot listen on port" << m_port << m_tcpServer->errorString();
+            }
+        }
+    }
+
+    if (socketPath != m_socketPath) {
+        m_localServer->close();
+        m_socketPath = socketPath;
+        if (!m_socketPath.isEmpty()) {
+            // A stale socket from a previous run would make listen() fail
+            QLocalServer::removeServer(m_socketPath);
+            m_localServer->setSocketOptions(QLocalServer::UserAccessOption);
+            if (m_localServer->listen(m_socketPath)) {
+                qDebug() << "Metrics served on unix socket" << m_socketPath;
+            } else {
+                qWarning() << "Metrics: cannot listen on" << m_socketPath << m_localServer->errorString();
+            }
+        }
+    }
+}
+
+void MetricsServer::handleConnection(QIODevice *socket)
+{
+    // Scrapers send one small request per connection; answer once the headers are in
+    connect(socket, &QIODevice::readyRead, this, [this, socket]() {
+        if (socket->property("answered").toBool()) {
+            socket->readAll();
+            return;
+        }
+        QByteArray request = socket->property("request").toByteArray() + socket->readAll();
+        socket->setProperty("request", request);
+        if (request.contains("\r\n\r\n") || request.contains("\n\n") || request.size() > 8192) {
+            socket->setProperty("answered", true);
+            respond(socket);
+        }
+    });
+
+    if (QTcpSocket *tcp = qobject_cast<QTcpSocket *>(socket)) {
+        connect(tcp, &QTcpSocket::disconnected, tcp, &QObject::deleteLater);
+    } else if (QLocalSocket *local = qobject_cast<QLocalSocket *>(socket)) {
+        connect(local, &QLocalSocket::disconnected, local, &QObject::deleteLater);
+    }
+}
+
+void MetricsServer::respond(QIODevice *socket)
+{
+    QByteArray request = socket->property("request").toByteArray();
+    QList<QByteArray> requestLine = request.left(request.indexOf('\n')).trimmed().split(' ');
+    QByteArray path = requestLine.value(1);
+
+    QByteArray status = "200 OK";
+    QByteArray body;
+    if (requestLine.value(0) != "GET") {
+        status = "405 Method Not Allowed";
+    } else if (path != "/metrics" && path != "/") {
+        status = "404 Not Found";
+    } else {
+        body = Metrics::instance()->exposition();
+    }
+
+    QByteArray response = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                          "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                          "Connection: close\r\n\r\n" + body;
+    socket->write(response);
+
+    // disconnectFrom*() waits for the pending bytes to be written
+    if (QTcpSocket *tcp = qobject_cast<QTcpSocket *>(socket)) {
+        tcp->disconnectFromHost();
+    } else if (QLocalSocket *local = qobject_cast<QLocalSocket *>(socket)) {
+        local->disconnectFromServer();
+    }
+}
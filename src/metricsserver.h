@@ -0,0 +1,34 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QObject>
+#include <QString>
+
+class QTcpServer;
+class QLocalServer;
+class QIODevice;
+
+// Serves Metrics::exposition() over minimal HTTP/1.1 on 127.0.0.1:<port>
+// and/or a Unix socket (curl --unix-socket <path> http://localhost/metrics).
+// Never listens on a non-loopback address.
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsServer(QObject *parent = nullptr);
+
+    // Port 0 / empty path disables that listener; unchanged settings are a no-op
+    void listen(int port, const QString &socketPath);
+
+private:
+    void handleConnection(QIODevice *socket);
+    void respond(QIODevice *socket);
+
+    QTcpServer *m_tcpServer;
+    QLocalServer *m_localServer;
+    int m_port;
+    QString m_socketPath;
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,94 @@
+#include "pipelinecache.h"
+#include <QQuickWindow>
+#include <QTimer>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+#include <QQuickGraphicsConfiguration>
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#endif
+
+PipelineCache::PipelineCache(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_saveTimer(new QTimer(this))
+    , m_state("off")
+{
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SaveDelayMs);
+    connect(m_saveTimer, &QTimer::timeout, this, &PipelineCache::requestSave);
+}
+
+void PipelineCache::setPath(const QString &path)
+{
+    if (path == "auto") {
+        m_path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/pipeline.cache";
+    } else {
+        m_path = path;
+    }
+}
+
+void PipelineCache::attach(QQuickWindow *window)
+{
+    m_window = window;
+    if (!m_window || m_path.isEmpty()) {
+        m_state = "off";
+        return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    m_state = QFileInfo::exists(m_path) ? "warm" : "cold";
+
+    QQuickGraphicsConfiguration config = m_window->graphicsConfiguration();
+    config.setPipelineCacheLoadFile(m_path);
+    config.setPipelineCacheSaveFile(m_path);
+    m_window->setGraphicsConfiguration(config);
+    qDebug() << "Pipeline cache:" << m_path << "(" << m_state << ")";
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    // Written on the render thread at the end of the next frame after the delay
+    connect(m_window, &QQuickWindow::afterFrameEnd, this,
+            &PipelineCache::saveOnRenderThread, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::sceneGraphInitialized, m_saveTimer,
+            qOverload<>(&QTimer::start), Qt::QueuedConnection);
+#endif
+#else
+    m_state = "off";
+    qWarning() << "Pipeline cache: needs Qt 6.5 or newer, render_pipeline_cache ignored";
+#endif
+}
+
+void PipelineCache::requestSave()
+{
+    m_savePending.storeRelease(1);
+    m_window->update();
+}
+
+void PipelineCache::saveOnRenderThread()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    if (!m_savePending.testAndSetAcquire(1, 0)) {
+        return;
+    }
+
+    QRhi *rhi = m_window->rhi();
+    QByteArray data = rhi ? rhi->pipelineCacheData() : QByteArray();
+    if (data.isEmpty()) {
+        return;
+    }
+
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "Pipeline cache: cannot write" << m_path << "-" << file.errorString();
+        return;
+    }
+    qDebug() << "Pipeline cache: saved" << data.size() << "bytes to" << m_path;
+#endif
+}
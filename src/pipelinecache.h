@@ -0,0 +1,52 @@
+#ifndef PIPELINECACHE_H
+#define PIPELINECACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QAtomicInt>
+
+class QQuickWindow;
+class QTimer;
+
+// Persistent graphics pipeline cache ([app_live] render_pipeline_cache).
+//
+// The RHI builds a pipeline for every shader/state combination the scene uses
+// (gradients, text, opacity masks, layer effects); without a cache that happens
+// again on each launch, during the first frames and the first animations. The
+// cache is loaded when the scene graph initializes and written back by Qt on a
+// clean exit; since GLADIS is normally killed rather than quit, it is also
+// saved once the startup animations have run (saveDelay). The driver checks
+// the blob against the GPU/driver and ignores a stale one.
+//
+// Load/save needs Qt 6.5 (QQuickGraphicsConfiguration), the early save Qt 6.6.
+class PipelineCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PipelineCache(QObject *parent = nullptr);
+
+    // "auto" = <cache dir>/pipeline.cache, empty = off
+    void setPath(const QString &path);
+    QString path() const { return m_path; }
+
+    // Must run before the window is exposed (scene graph not yet initialized)
+    void attach(QQuickWindow *window);
+
+    // "off", "cold" (no cache file yet) or "warm" - benchmark label
+    QString state() const { return m_state; }
+
+    static const int SaveDelayMs = 20000;
+
+private:
+    void requestSave();
+    void saveOnRenderThread();
+
+    QQuickWindow *m_window;
+    QTimer *m_saveTimer;
+    QString m_path;
+    QString m_state;
+    QAtomicInt m_savePending;
+};
+
+#endif // PIPELINECACHE_H
@@ -0,0 +1,255 @@
+#include "playerfeed.h"
+#include "jsonstream.h"
+#include <QIODevice>
+#include <climits>
+#include <utility>
+
+PlayerFeedModel::PlayerFeedModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    m_strings.append(QString());
+    m_stringIndex.insert(QByteArray(), 0);
+}
+
+int PlayerFeedModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_records.size();
+}
+
+QVariant PlayerFeedModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_records.size()) {
+        return QVariant();
+    }
+
+    const FeedRecord &record = m_records.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole: return record.name;
+    case GameRole: return string(record.game);
+    case PlatformRole: return string(record.platform);
+    case StationRole: return record.station;
+    case MinutesRole: return record.minutes;
+    case ScoreRole: return record.score;
+    case RankRole: return index.row() + 1;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> PlayerFeedModel::roleNames() const
+{
+    return {
+        { NameRole, "name" },
+        { GameRole, "game" },
+        { PlatformRole, "platform" },
+        { StationRole, "station" },
+        { MinutesRole, "minutes" },
+        { ScoreRole, "score" },
+        { RankRole, "rank" }
+    };
+}
+
+QVariantMap PlayerFeedModel::get(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= m_records.size()) {
+        return map;
+    }
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.constBegin(); it != roles.constEnd(); ++it) {
+        map.insert(QString::fromLatin1(it.value()), data(index(row), it.key()));
+    }
+    return map;
+}
+
+quint32 PlayerFeedModel::intern(const QByteArray &utf8)
+{
+    auto it = m_stringIndex.constFind(utf8);
+    if (it != m_stringIndex.constEnd()) {
+        return it.value();
+    }
+    quint32 index = quint32(m_strings.size());
+    m_strings.append(QString::fromUtf8(utf8));
+    m_stringIndex.insert(utf8, index);
+    return index;
+}
+
+void PlayerFeedModel::update(QVector<FeedRecord> records)
+{
+    const int oldCount = m_records.size();
+    const int newCount = records.size();
+    const int common = qMin(oldCount, newCount);
+
+    // Changed rows in place, one dataChanged per contiguous run
+    int runStart = -1;
+    for (int i = 0; i < common; i++) {
+        if (m_records.at(i) != records.at(i)) {
+            m_records[i] = std::move(records[i]);
+            if (runStart < 0) {
+                runStart = i;
+            }
+        } else if (runStart >= 0) {
+            emit dataChanged(index(runStart), index(i - 1));
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0) {
+        emit dataChanged(index(runStart), index(common - 1));
+    }
+
+    if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+        m_records.reserve(newCount);
+        for (int i = oldCount; i < newCount; i++) {
+            m_records.append(std::move(records[i]));
+        }
+        endInsertRows();
+    } else if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+        m_records.resize(newCount);
+        m_records.squeeze();
+        endRemoveRows();
+    }
+
+    if (newCount != oldCount) {
+        emit countChanged();
+    }
+}
+
+namespace {
+
+qint64 clampedInteger(const JsonStreamReader &reader, qint64 min, qint64 max)
+{
+    return qBound<qint64>(min, qint64(reader.number()), max);
+}
+
+bool readRecord(JsonStreamReader &reader, PlayerFeedModel *model, FeedRecord *record)
+{
+    while (reader.next() == JsonStreamReader::Name) {
+        const QByteArray &key = reader.utf8();
+        const bool isName = key == "name";
+        const bool isGame = key == "game";
+        const bool isPlatform = key == "platform";
+        const bool isStation = key == "station";
+        const bool isMinutes = key == "minutes";
+        const bool isScore = key == "score";
+
+        JsonStreamReader::Token value = reader.next();
+        if (value == JsonStreamReader::StartObject || value == JsonStreamReader::StartArray) {
+            if (!reader.skipValue()) {
+                return false;
+            }
+            continue;
+        }
+        if (value == JsonStreamReader::String) {
+            if (isName) {
+                record->name = reader.text();
+            } else if (isGame) {
+                record->game = model->intern(reader.utf8());
+            } else if (isPlatform) {
+                record->platform = model->intern(reader.utf8());
+            }
+        } else if (value == JsonStreamReader::Number) {
+            if (isStation) {
+                record->station = qint32(clampedInteger(reader, -1, INT_MAX));
+            } else if (isMinutes) {
+                record->minutes = qint32(clampedInteger(reader, 0, INT_MAX));
+            } else if (isScore) {
+                record->score = qint64(reader.number());
+            }
+        } else if (value == JsonStreamReader::Invalid || value == JsonStreamReader::EndDocument) {
+            return false;
+        }
+    }
+    return reader.token() == JsonStreamReader::EndObject;
+}
+
+bool readRecords(JsonStreamReader &reader, PlayerFeedModel *model, QVector<FeedRecord> *records)
+{
+    JsonStreamReader::Token token = reader.next();
+    if (token == JsonStreamReader::StartObject) {
+        return reader.skipValue();
+    }
+    if (token == JsonStreamReader::Invalid || token == JsonStreamReader::EndDocument) {
+        return false;
+    }
+    if (token != JsonStreamReader::StartArray) {
+        // null or a scalar, already consumed by next()
+        return true;
+    }
+
+    // Feeds change a few rows at a time; the previous size is a good guess
+    records->reserve(model->count());
+    for (token = reader.next(); token != JsonStreamReader::EndArray; token = reader.next()) {
+        if (token == JsonStreamReader::StartObject) {
+            FeedRecord record;
+            if (!readRecord(reader, model, &record)) {
+                return false;
+            }
+            records->append(std::move(record));
+        } else if (token == JsonStreamReader::StartArray) {
+            if (!reader.skipValue()) {
+                return false;
+            }
+        } else if (token == JsonStreamReader::Invalid || token == JsonStreamReader::EndDocument) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool PlayerFeed::ingest(QIODevice *device, QVariantMap *summary, PlayerFeedModel *players,
+                        PlayerFeedModel *leaderboard, QString *error)
+{
+    auto fail = [error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    JsonStreamReader reader(device);
+    if (reader.next() != JsonStreamReader::StartObject) {
+        return fail(reader.hasError() ? reader.errorString() : "not a JSON object");
+    }
+
+    QVariantMap map;
+    QVector<FeedRecord> playerRecords;
+    QVector<FeedRecord> leaderboardRecords;
+    while (reader.next() == JsonStreamReader::Name) {
+        const QByteArray &key = reader.utf8();
+        PlayerFeedModel *model = nullptr;
+        QVector<FeedRecord> *records = nullptr;
+        if (key == "players") {
+            model = players;
+            records = &playerRecords;
+        } else if (key == "leaderboard") {
+            model = leaderboard;
+            records = &leaderboardRecords;
+        }
+
+        if (records) {
+            bool ok = model ? readRecords(reader, model, records) : reader.skipValue();
+            if (!ok) {
+                break;
+            }
+        } else {
+            QString name = reader.text();
+            map.insert(name, reader.readVariant());
+        }
+    }
+    if (reader.token() != JsonStreamReader::EndObject || reader.next() != JsonStreamReader::EndDocument) {
+        return fail(reader.hasError() ? reader.errorString() : "unexpected content");
+    }
+
+    *summary = map;
+    if (players) {
+        players->update(std::move(playerRecords));
+    }
+    if (leaderboard) {
+        leaderboard->update(std::move(leaderboardRecords));
+    }
+    return true;
+}
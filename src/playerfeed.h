@@ -0,0 +1,91 @@
+#ifndef PLAYERFEED_H
+#define PLAYERFEED_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+class QIODevice;
+
+// One row of a player feed, compact and typed: repeated strings (game,
+// platform) are indices into the model's string table.
+struct FeedRecord
+{
+    QString name;
+    quint32 game = 0;
+    quint32 platform = 0;
+    qint32 station = -1;
+    qint32 minutes = 0;
+    qint64 score = 0;
+
+    bool operator==(const FeedRecord &other) const
+    {
+        return name == other.name && game == other.game && platform == other.platform
+               && station == other.station && minutes == other.minutes && score == other.score;
+    }
+    bool operator!=(const FeedRecord &other) const { return !(*this == other); }
+};
+
+// Player session list or leaderboard for QML (dataManager.players,
+// dataManager.leaderboard). update() emits only what changed, so a ListView
+// keeps its delegates and scroll position across reloads of the same feed.
+class PlayerFeedModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Role {
+        NameRole = Qt::UserRole + 1,
+        GameRole,
+        PlatformRole,
+        StationRole,
+        MinutesRole,
+        ScoreRole,
+        RankRole        // 1-based row
+    };
+
+    explicit PlayerFeedModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_records.size(); }
+    const QVector<FeedRecord> &records() const { return m_records; }
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    // Index of a repeated string; the table only grows (distinct games/platforms)
+    quint32 intern(const QByteArray &utf8);
+    QString string(quint32 index) const { return m_strings.value(int(index)); }
+
+    // Row-by-row diff: dataChanged for changed runs, inserts/removes at the tail
+    void update(QVector<FeedRecord> records);
+    void clear() { update(QVector<FeedRecord>()); }
+
+signals:
+    void countChanged();
+
+private:
+    QVector<FeedRecord> m_records;
+    QStringList m_strings;                  // [0] = ""
+    QHash<QByteArray, quint32> m_stringIndex;
+};
+
+// Streams user_data.json without building a document:
+//   { "total": 25, "playing": 23, "xbox": 6, ...,        -> summary (QVariantMap)
+//     "players":     [ { "name", "game", "platform", "station", "minutes" }, ... ],
+//     "leaderboard": [ { "name", "game", "platform", "score" }, ... ] }
+// The arrays go straight into typed records, other members into the summary
+// map (they are small). Peak memory is the read buffer plus the old and new
+// records; the models are only touched when the whole file parsed.
+namespace PlayerFeed {
+
+bool ingest(QIODevice *device, QVariantMap *summary, PlayerFeedModel *players,
+            PlayerFeedModel *leaderboard, QString *error);
+
+} // namespace PlayerFeed
+
+#endif // PLAYERFEED_H
@@ -0,0 +1,528 @@
+#include "playlistscheduler.h"
+#include "metrics.h"
+#include "virtualclock.h"
+#include <QThreadPool>
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QDebug>
+
+namespace {
+
+const int kMinDurationMs = 1000;
+const int kMaxPreload = 8;
+
+// Nothing eligible (all items outside their time windows): look again after this
+const int kIdleRecheckMs = 30000;
+
+QTime parseTime(const QJsonValue &value)
+{
+    QString text = value.toString().trimmed();
+    if (text.isEmpty()) {
+        return QTime();
+    }
+    QTime time = QTime::fromString(text, "HH:mm");
+    if (!time.isValid()) {
+        time = QTime::fromString(text, "HH:mm:ss");
+    }
+    if (!time.isValid()) {
+        qWarning() << "Playlist: invalid time" << text << "(expected HH:mm)";
+    }
+    return time;
+}
+
+} // namespace
+
+PlaylistScheduler::PlaylistScheduler(QObject *parent)
+    : QObject(parent)
+    , m_defaultDurationMs(10000)
+    , m_preloadCount(2)
+    , m_enabled(false)
+    , m_running(false)
+    , m_switchTimer(new ClockTimer(this))
+    , m_reloadTimer(new ClockTimer(this))
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_pool(new QThreadPool(this))
+    , m_nextDeadlineMs(0)
+    , m_pendingIndex(-1)
+    , m_starting(false)
+    , m_currentIndex(-1)
+    , m_serial(0)
+    , m_lateCount(0)
+{
+    m_switchTimer->setSingleShot(true);
+    m_switchTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_switchTimer, &ClockTimer::timeout, this, &PlaylistScheduler::advance);
+
+    // Editors and sync tools write in several steps; reload once they are done
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(500);
+    connect(m_reloadTimer, &ClockTimer::timeout, this, &PlaylistScheduler::reload);
+
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &PlaylistScheduler::onWatchedPathChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &PlaylistScheduler::onWatchedPathChanged);
+
+    // Decoding competes with the render thread; two threads keep up with any sane playlist
+    m_pool->setMaxThreadCount(2);
+
+    Metrics::instance()->describe("gladis_playlist_switches_total", Metrics::Counter, "Playlist items shown");
+    Metrics::instance()->describe("gladis_playlist_late_total", Metrics::Counter, "Playlist items not decoded by their scheduled start");
+    Metrics::instance()->describe("gladis_playlist_lateness_seconds", Metrics::Histogram, "Delay of late playlist items past their scheduled start");
+    Metrics::instance()->describe("gladis_playlist_decode_seconds", Metrics::Histogram, "Playlist look-ahead decode time per image");
+    Metrics::instance()->describe("gladis_playlist_errors_total", Metrics::Counter, "Playlist items that failed to decode");
+}
+
+PlaylistScheduler::~PlaylistScheduler()
+{
+    m_pool->waitForDone();
+}
+
+void PlaylistScheduler::setPlaylist(const QString &path, int defaultDurationSec, int preloadCount)
+{
+    QString resolved = path.isEmpty() ? QString() : QFileInfo(path).absoluteFilePath();
+    int durationMs = qMax(kMinDurationMs, defaultDurationSec * 1000);
+    int preload = qBound(1, preloadCount, kMaxPreload);
+
+    if (resolved == m_playlistPath && durationMs == m_defaultDurationMs && preload == m_preloadCount) {
+        return;  // [app_image] changed something else
+    }
+
+    m_playlistPath = resolved;
+    m_defaultDurationMs = durationMs;
+    m_preloadCount = preload;
+    reload();
+}
+
+void PlaylistScheduler::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    updateRunning();
+}
+
+void PlaylistScheduler::setTargetSize(const QSize &size)
+{
+    // Applies to decodes started from now on
+    m_targetSize = size;
+}
+
+QImage PlaylistScheduler::cachedImage(const QString &filePath) const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_cache.value(filePath).image;
+}
+
+QImage PlaylistScheduler::decode(const QString &filePath, const QSize &target)
+{
+    QImageReader reader(filePath);
+    reader.setAutoTransform(true);
+
+    // Decode straight to the size it is shown at; never upscale
+    QSize size = reader.size();
+    if (size.isValid() && target.isValid() && size.width() > target.width() && size.height() > target.height()) {
+        reader.setScaledSize(size.scaled(target, Qt::KeepAspectRatioByExpanding));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Playlist: failed to decode" << filePath << reader.errorString();
+        return image;
+    }
+
+    // Formats the scene graph uploads without another conversion
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                         : QImage::Format_RGB32);
+}
+
+void PlaylistScheduler::reload()
+{
+    QString currentPath = (m_currentIndex >= 0 && m_currentIndex < m_items.size())
+        ? m_items.at(m_currentIndex).filePath : QString();
+
+    m_items.clear();
+    if (!m_watcher->files().isEmpty()) {
+        m_watcher->removePaths(m_watcher->files());
+    }
+    if (!m_watcher->directories().isEmpty()) {
+        m_watcher->removePaths(m_watcher->directories());
+    }
+
+    if (!m_playlistPath.isEmpty()) {
+        QFileInfo info(m_playlistPath);
+        if (info.isDir()) {
+            loadDirectory(m_playlistPath);
+            m_watcher->addPath(m_playlistPath);
+        } else {
+            if (info.exists()) {
+                loadManifest(m_playlistPath);
+                m_watcher->addPath(m_playlistPath);
+            } else {
+                qWarning() << "Playlist not found:" << m_playlistPath;
+            }
+            // Manifests are usually replaced by rename, watch the directory as well
+            if (info.absoluteDir().exists()) {
+                m_watcher->addPath(info.absolutePath());
+            }
+        }
+        qDebug() << "Playlist loaded:" << m_playlistPath << "-" << m_items.size() << "items";
+    }
+
+    // Keep the current item on screen if it survived the reload
+    m_currentIndex = -1;
+    for (int i = 0; i < m_items.size(); i++) {
+        if (m_items.at(i).filePath == currentPath) {
+            m_currentIndex = i;
+            break;
+        }
+    }
+    m_pendingIndex = -1;
+
+    emit itemsChanged();
+
+    if (m_running && m_currentIndex < 0) {
+        m_running = false;  // Restart from the first eligible item
+    }
+    updateRunning();
+    if (m_running && !m_switchTimer->isActive()) {
+        advance();  // Was waiting for an item that may be gone now
+    } else if (m_running) {
+        preload();
+    }
+}
+
+void PlaylistScheduler::loadDirectory(const QString &dirPath)
+{
+    QStringList filters;
+    const QList<QByteArray> formats = QImageReader::supportedImageFormats();
+    for (const QByteArray &format : formats) {
+        filters.append("*." + QString::fromLatin1(format));
+    }
+
+    QDir dir(dirPath);
+    const QStringList names = dir.entryList(filters, QDir::Files | QDir::Readable, QDir::Name);
+    for (const QString &name : names) {
+        Item item;
+        item.filePath = dir.absoluteFilePath(name);
+        item.durationMs = m_defaultDurationMs;
+        m_items.append(item);
+    }
+}
+
+void PlaylistScheduler::loadManifest(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Playlist: cannot open manifest" << filePath << file.errorString();
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "Playlist: invalid manifest" << filePath << error.errorString();
+        return;
+    }
+
+    QJsonObject root = doc.object();
+    int defaultMs = root.contains("duration") ? qRound(root.value("duration").toDouble() * 1000)
+                                              : m_defaultDurationMs;
+    QDir baseDir = QFileInfo(filePath).absoluteDir();
+
+    const QJsonArray items = root.value("items").toArray();
+    for (const QJsonValue &value : items) {
+        QJsonObject object = value.isString() ? QJsonObject{ { "source", value } } : value.toObject();
+        QString source = object.value("source").toString();
+        if (source.isEmpty()) {
+            continue;
+        }
+
+        Item item;
+        item.filePath = QFileInfo(baseDir, source).absoluteFilePath();
+        item.durationMs = qMax(kMinDurationMs, object.contains("duration")
+                               ? qRound(object.value("duration").toDouble() * 1000) : defaultMs);
+        item.from = parseTime(object.value("from"));
+        item.until = parseTime(object.value("until"));
+        m_items.append(item);
+    }
+}
+
+void PlaylistScheduler::updateRunning()
+{
+    bool running = m_enabled && !m_items.isEmpty();
+    if (running == m_running) {
+        return;
+    }
+
+    m_running = running;
+    m_switchTimer->stop();
+    m_pendingIndex = -1;
+    m_starting = m_running;
+
+    if (m_running) {
+        qDebug() << "Playlist started";
+        m_nextDeadlineMs = VirtualClock::instance()->elapsed();
+        advance();
+    } else {
+        qDebug() << "Playlist stopped";
+        m_currentIndex = -1;
+        m_currentSource.clear();
+        {
+            QMutexLocker locker(&m_cacheMutex);
+            m_cache.clear();
+        }
+        emit currentChanged();
+    }
+
+    emit activeChanged();
+}
+
+bool PlaylistScheduler::isEligible(const Item &item, const QDateTime &at) const
+{
+    if (!item.from.isValid() && !item.until.isValid()) {
+        return true;
+    }
+
+    QTime time = at.time();
+    QTime from = item.from.isValid() ? item.from : QTime(0, 0);
+    QTime until = item.until.isValid() ? item.until : QTime(23, 59, 59, 999);
+    if (from <= until) {
+        return time >= from && time < until;
+    }
+    return time >= from || time < until;  // Window across midnight
+}
+
+int PlaylistScheduler::nextEligible(int after, const QDateTime &at) const
+{
+    const int count = m_items.size();
+    for (int step = 1; step <= count; step++) {
+        int index = ((after < 0 ? -1 : after) + step) % count;
+        if (isEligible(m_items.at(index), at)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void PlaylistScheduler::preload()
+{
+    if (!m_running || m_items.isEmpty()) {
+        return;
+    }
+
+    // The current item plus the next N in schedule order, at their projected start times
+    QStringList wanted;
+    if (m_currentIndex >= 0) {
+        wanted.append(m_items.at(m_currentIndex).filePath);
+    }
+    if (m_pendingIndex >= 0) {
+        wanted.append(m_items.at(m_pendingIndex).filePath);
+    }
+
+    QDateTime at = VirtualClock::instance()->currentDateTime().addMSecs(qMax<qint64>(0, m_nextDeadlineMs - VirtualClock::instance()->elapsed()));
+    int index = (m_pendingIndex >= 0) ? m_pendingIndex : m_currentIndex;
+    for (int i = 0; i < m_preloadCount; i++) {
+        index = nextEligible(index, at);
+        if (index < 0) {
+            break;
+        }
+        const Item &item = m_items.at(index);
+        if (!wanted.contains(item.filePath)) {
+            wanted.append(item.filePath);
+        }
+        at = at.addMSecs(item.durationMs);
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        if (!wanted.contains(it.key())) {
+            it = m_cache.erase(it);
+            continue;
+        }
+        // Replaced since it was decoded (sync tools rename over the old file)
+        QFileInfo info(it.key());
+        if (info.lastModified().toMSecsSinceEpoch() != it->modifiedMs || info.size() != it->size) {
+            qDebug() << "Playlist: image changed on disk, decoding again:" << it.key();
+            it = m_cache.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    for (const QString &filePath : wanted) {
+        if (m_cache.contains(filePath) || m_decoding.contains(filePath)) {
+            continue;
+        }
+        m_decoding.insert(filePath);
+
+        QSize target = m_targetSize;
+        m_pool->start([this, filePath, target]() {
+            // Stamp before reading: a replacement mid-decode is caught next time
+            QFileInfo info(filePath);
+            CachedImage decoded;
+            decoded.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+            decoded.size = info.size();
+            QElapsedTimer timer;
+            timer.start();
+            decoded.image = decode(filePath, target);
+            qint64 decodeNs = timer.nsecsElapsed();
+            QMetaObject::invokeMethod(this, [this, filePath, decoded, decodeNs]() {
+                onDecoded(filePath, decoded, decodeNs);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void PlaylistScheduler::onDecoded(const QString &filePath, const CachedImage &decoded, qint64 decodeNs)
+{
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        m_decoding.remove(filePath);
+        if (!decoded.image.isNull()) {
+            m_cache.insert(filePath, decoded);
+        }
+    }
+
+    if (decoded.image.isNull()) {
+        Metrics::instance()->increment("gladis_playlist_errors_total");
+    } else {
+        Metrics::instance()->observe("gladis_playlist_decode_seconds", decodeNs / 1e9);
+    }
+
+    if (!m_running || m_pendingIndex < 0 || m_items.at(m_pendingIndex).filePath != filePath) {
+        return;
+    }
+
+    // The item that missed its deadline: show it now, or move on if it cannot be decoded
+    int index = m_pendingIndex;
+    if (m_starting) {
+        // First item after a start, the schedule begins now; an undecodable one is skipped
+        m_pendingIndex = -1;
+        m_nextDeadlineMs = VirtualClock::instance()->elapsed();
+        if (image.isNull()) {
+            m_currentIndex = index;
+            advance();
+        } else {
+            show(index);
+        }
+        return;
+    }
+    qint64 lateMs = VirtualClock::instance()->elapsed() - m_nextDeadlineMs;
+    m_pendingIndex = -1;
+    m_lateCount++;
+    Metrics::instance()->observe("gladis_playlist_lateness_seconds", lateMs / 1000.0);
+    emit itemLate(filePath, int(lateMs));
+
+    if (image.isNull()) {
+        qWarning() << "Playlist: skipping" << filePath << "(decode failed" << lateMs << "ms after its start)";
+        m_currentIndex = index;  // Continue after it
+        m_nextDeadlineMs = VirtualClock::instance()->elapsed();
+        advance();
+        return;
+    }
+
+    qWarning() << "Playlist: item shown" << lateMs << "ms late:" << filePath;
+    m_nextDeadlineMs = VirtualClock::instance()->elapsed();
+    show(index);
+}
+
+void PlaylistScheduler::advance()
+{
+    if (!m_running) {
+        return;
+    }
+
+    int index = nextEligible(m_currentIndex, VirtualClock::instance()->currentDateTime());
+    if (index < 0) {
+        // Outside every item's time window
+        if (!m_currentSource.isEmpty()) {
+            m_currentIndex = -1;
+            m_currentSource.clear();
+            emit currentChanged();
+        }
+        m_nextDeadlineMs = VirtualClock::instance()->elapsed() + kIdleRecheckMs;
+        scheduleNext();
+        return;
+    }
+
+    if (index == m_currentIndex && !m_currentSource.isEmpty()) {
+        // Single eligible item: keep it up, no transition
+        m_nextDeadlineMs += m_items.at(index).durationMs;
+        scheduleNext();
+        return;
+    }
+
+    const Item &item = m_items.at(index);
+    if (cachedImage(item.filePath).isNull()) {
+        if (m_starting) {
+            // Nothing could be decoded ahead yet; the schedule starts with the first image
+            qDebug() << "Playlist: waiting for the first item:" << item.filePath;
+        } else {
+            qWarning() << "Playlist: item not ready at its scheduled start:" << item.filePath;
+            Metrics::instance()->increment("gladis_playlist_late_total");
+        }
+        m_pendingIndex = index;
+        preload();  // Make sure it is being decoded
+        return;
+    }
+
+    show(index);
+}
+
+void PlaylistScheduler::show(int index)
+{
+    const Item &item = m_items.at(index);
+
+    m_currentIndex = index;
+    m_starting = false;
+    m_currentSource = QString("image://playlist/%1/%2").arg(++m_serial).arg(item.filePath);
+    Metrics::instance()->increment("gladis_playlist_switches_total");
+    emit currentChanged();
+
+    // The deadline this item was due at is its start; late items start now (set by the caller)
+    m_nextDeadlineMs += item.durationMs;
+    scheduleNext();
+    preload();
+}
+
+void PlaylistScheduler::scheduleNext()
+{
+    m_switchTimer->start(int(qMax<qint64>(0, m_nextDeadlineMs - VirtualClock::instance()->elapsed())));
+}
+
+void PlaylistScheduler::onWatchedPathChanged(const QString &path)
+{
+    Q_UNUSED(path);
+    m_reloadTimer->start();
+}
+
+PlaylistImageProvider::PlaylistImageProvider(PlaylistScheduler *scheduler)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_scheduler(scheduler)
+{
+}
+
+QImage PlaylistImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    Q_UNUSED(requestedSize);
+
+    // "<serial>/<file path>"
+    QString filePath = id.section('/', 1);
+    QImage image = m_scheduler->cachedImage(filePath);
+    if (image.isNull()) {
+        // Evicted already (e.g. QML reloaded the source), decode on the loader thread
+        image = PlaylistScheduler::decode(filePath, QSize());
+    }
+
+    if (size) {
+        *size = image.size();
+    }
+    return image;
+}
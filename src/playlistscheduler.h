@@ -0,0 +1,141 @@
+#ifndef PLAYLISTSCHEDULER_H
+#define PLAYLISTSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QImage>
+#include <QSize>
+#include <QTime>
+#include <QDateTime>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QQuickImageProvider>
+
+class ClockTimer;
+class QThreadPool;
+class QFileSystemWatcher;
+
+// Playlist mode of app_image ([app_image] image_playlist): rotates through a
+// directory of images or a JSON manifest without touching the INI.
+//
+// Manifest format (paths relative to the manifest):
+//   { "duration": 10,
+//     "items": [ { "source": "ads/a.jpg", "duration": 8 },
+//                { "source": "ads/b.png", "from": "18:00", "until": "02:00" } ] }
+//
+// The next image_preload eligible items are decoded on a thread pool ahead of
+// time and handed to QML through the "playlist" image provider, so a switch
+// only uploads a texture. Switches run on a precise timer against a monotonic
+// schedule; an item that is not decoded at its deadline is reported (log,
+// itemLate(), gladis_playlist_late_total) and shown as soon as it is ready.
+class PlaylistScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool active READ active NOTIFY activeChanged)
+    Q_PROPERTY(QString currentSource READ currentSource NOTIFY currentChanged)
+    Q_PROPERTY(int currentIndex READ currentIndex NOTIFY currentChanged)
+    Q_PROPERTY(int itemCount READ itemCount NOTIFY itemsChanged)
+    Q_PROPERTY(int lateCount READ lateCount NOTIFY itemLate)
+
+public:
+    explicit PlaylistScheduler(QObject *parent = nullptr);
+    ~PlaylistScheduler();
+
+    // Directory or manifest path; empty stops the playlist
+    void setPlaylist(const QString &path, int defaultDurationSec, int preloadCount);
+
+    // Only runs while app_image is on a layer
+    void setEnabled(bool enabled);
+
+    // Images larger than this are decoded down to cover it (render_window)
+    void setTargetSize(const QSize &size);
+
+    bool active() const { return m_running; }
+    QString currentSource() const { return m_currentSource; }
+    int currentIndex() const { return m_currentIndex; }
+    int itemCount() const { return m_items.size(); }
+    int lateCount() const { return m_lateCount; }
+
+    // Image provider side, any thread: decoded image for a file, null if not cached
+    QImage cachedImage(const QString &filePath) const;
+    static QImage decode(const QString &filePath, const QSize &target);
+
+signals:
+    void activeChanged();
+    void currentChanged();
+    void itemsChanged();
+    void itemLate(const QString &source, int lateMs);
+
+private slots:
+    void advance();
+    void onWatchedPathChanged(const QString &path);
+
+private:
+    struct Item {
+        QString filePath;
+        int durationMs = 0;
+        QTime from;    // Daily window, invalid = always; until < from wraps past midnight
+        QTime until;
+    };
+
+    // Stamped with the file's mtime and size: a file replaced under the same
+    // path must not show its old decode
+    struct CachedImage {
+        QImage image;
+        qint64 modifiedMs = -1;
+        qint64 size = -1;
+    };
+
+    void reload();
+    void loadDirectory(const QString &dirPath);
+    void loadManifest(const QString &filePath);
+    void updateRunning();
+    bool isEligible(const Item &item, const QDateTime &at) const;
+    int nextEligible(int after, const QDateTime &at) const;
+    void preload();
+    void onDecoded(const QString &filePath, const CachedImage &decoded, qint64 decodeNs);
+    void show(int index);
+    void scheduleNext();
+
+    QString m_playlistPath;
+    int m_defaultDurationMs;
+    int m_preloadCount;
+    bool m_enabled;
+    bool m_running;
+    QSize m_targetSize;
+    QVector<Item> m_items;
+
+    ClockTimer *m_switchTimer;
+    ClockTimer *m_reloadTimer;
+    QFileSystemWatcher *m_watcher;
+    QThreadPool *m_pool;
+    qint64 m_nextDeadlineMs;   // VirtualClock::elapsed() the pending item is due
+    int m_pendingIndex;        // Due but not decoded yet, -1 if none
+    bool m_starting;           // Nothing shown since start, the first item cannot be late
+    int m_currentIndex;
+    QString m_currentSource;
+    quint64 m_serial;          // Makes every switch a new image URL
+    int m_lateCount;
+
+    mutable QMutex m_cacheMutex;
+    QHash<QString, CachedImage> m_cache;   // Decoded images by file path
+    QSet<QString> m_decoding;
+};
+
+// image://playlist/<serial>/<file path>
+class PlaylistImageProvider : public QQuickImageProvider
+{
+public:
+    explicit PlaylistImageProvider(PlaylistScheduler *scheduler);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    PlaylistScheduler *m_scheduler;
+};
+
+#endif // PLAYLISTSCHEDULER_H
@@ -0,0 +1,181 @@
+#include "qualitygovernor.h"
+#include "framestats.h"
+#include "metrics.h"
+#include <QTimer>
+#include <QFile>
+#include <QQuickWindow>
+#include <QDebug>
+
+namespace {
+
+const int kMaxTier = 3;
+const int kEvaluateIntervalMs = 2000;
+const int kBadWindowsToStepDown = 2;
+const int kGoodWindowsToStepUp = 5;
+const int kMinWindowsBetweenChanges = 3;
+
+// Fewer frames than this in a window (mostly static screen) says nothing about frame time
+const int kMinFramesToJudge = 30;
+
+} // namespace
+
+QualityGovernor::QualityGovernor(QObject *parent)
+    : QObject(parent)
+    , m_evaluateTimer(new QTimer(this))
+    , m_frameStats(new FrameStats(this))
+    , m_window(nullptr)
+    , m_enabled(false)
+    , m_tempHigh(80.0)
+    , m_tempLow(72.0)
+    , m_temperature(-1.0)
+    , m_tier(0)
+    , m_badWindows(0)
+    , m_goodWindows(0)
+    , m_windowsSinceChange(kMinWindowsBetweenChanges)
+{
+    m_evaluateTimer->setInterval(kEvaluateIntervalMs);
+    // The kiosk is static most of the time; only frames someone asked for count
+    m_frameStats->setExcludeIdle(true);
+    connect(m_evaluateTimer, &QTimer::timeout, this, &QualityGovernor::evaluate);
+
+    Metrics::instance()->describe("gladis_quality_tier", Metrics::Gauge, "Current quality governor tier (0 = full quality)");
+    Metrics::instance()->describe("gladis_soc_temperature_celsius", Metrics::Gauge, "SoC temperature seen by the quality governor");
+}
+
+void QualityGovernor::attach(QQuickWindow *window)
+{
+    m_window = window;
+    // Only evaluate() drains the intervals, so only collect them while enabled
+    if (m_enabled) {
+        m_frameStats->attach(m_window);
+    }
+}
+
+void QualityGovernor::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+
+    m_enabled = enabled;
+    if (m_enabled) {
+        m_frameStats->attach(m_window);
+        m_evaluateTimer->start();
+        qDebug() << "Quality governor enabled";
+    } else {
+        m_evaluateTimer->stop();
+        m_frameStats->attach(nullptr);
+        setTier(0, "governor disabled");
+    }
+}
+
+void QualityGovernor::setThermalPath(const QString &path)
+{
+    m_thermalPath = path;
+}
+
+void QualityGovernor::setTemperatureLimits(double high, double low)
+{
+    m_tempHigh = high;
+    m_tempLow = qMin(low, high);
+}
+
+QString QualityGovernor::tierName() const
+{
+    switch (m_tier) {
+    case 0: return "full";
+    case 1: return "reduced-effects";
+    case 2: return "scaled-75";
+    default: return "scaled-50";
+    }
+}
+
+double QualityGovernor::renderScale() const
+{
+    return m_tier >= 3 ? 0.5 : m_tier == 2 ? 0.75 : 1.0;
+}
+
+double QualityGovernor::readTemperature() const
+{
+    if (m_thermalPath.isEmpty()) {
+        return -1.0;
+    }
+
+    QFile file(m_thermalPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1.0;
+    }
+
+    bool ok = false;
+    double value = file.readAll().trimmed().toDouble(&ok);
+    if (!ok) {
+        return -1.0;
+    }
+
+    // sysfs reports millidegrees
+    return value > 1000.0 ? value / 1000.0 : value;
+}
+
+void QualityGovernor::evaluate()
+{
+    FrameStats::Summary frames = m_frameStats->summary();
+    m_frameStats->reset();
+
+    m_temperature = readTemperature();
+    emit sampled();
+    if (m_temperature >= 0.0) {
+        Metrics::instance()->setGauge("gladis_soc_temperature_celsius", m_temperature);
+    }
+
+    bool judgeFrames = frames.frames >= kMinFramesToJudge;
+    double jankRatio = judgeFrames ? double(frames.jankFrames) / frames.frames : 0.0;
+    bool hot = m_temperature >= m_tempHigh;
+    bool cool = m_temperature < 0.0 || m_temperature < m_tempLow;
+    bool dropping = judgeFrames && jankRatio > 0.05;
+    bool smooth = !judgeFrames || jankRatio < 0.01;
+
+    m_windowsSinceChange++;
+    if (hot || dropping) {
+        m_badWindows++;
+        m_goodWindows = 0;
+    } else if (cool && smooth) {
+        m_goodWindows++;
+        m_badWindows = 0;
+    } else {
+        // Between the thresholds: hold the current tier
+        m_badWindows = 0;
+        m_goodWindows = 0;
+    }
+
+    if (m_windowsSinceChange < kMinWindowsBetweenChanges) {
+        return;
+    }
+
+    if (m_badWindows >= kBadWindowsToStepDown && m_tier < kMaxTier) {
+        setTier(m_tier + 1, QString("%1 jank %2% p95 %3 ms, %4 C")
+                                .arg(hot ? "hot," : "frames dropped,")
+                                .arg(jankRatio * 100.0, 0, 'f', 1)
+                                .arg(frames.p95Ms, 0, 'f', 1)
+                                .arg(m_temperature, 0, 'f', 1));
+    } else if (m_goodWindows >= kGoodWindowsToStepUp && m_tier > 0) {
+        setTier(m_tier - 1, QString("headroom, jank %1%, %2 C")
+                                .arg(jankRatio * 100.0, 0, 'f', 1)
+                                .arg(m_temperature, 0, 'f', 1));
+    }
+}
+
+void QualityGovernor::setTier(int tier, const QString &reason)
+{
+    m_badWindows = 0;
+    m_goodWindows = 0;
+
+    if (tier == m_tier) {
+        return;
+    }
+
+    qDebug() << "Quality tier" << m_tier << "->" << tier << "(" << reason << ")";
+    m_tier = tier;
+    m_windowsSinceChange = 0;
+    Metrics::instance()->setGauge("gladis_quality_tier", m_tier);
+    emit tierChanged();
+}
@@ -0,0 +1,74 @@
+#ifndef QUALITYGOVERNOR_H
+#define QUALITYGOVERNOR_H
+
+#include <QObject>
+#include <QString>
+
+class QTimer;
+class QQuickWindow;
+class FrameStats;
+
+// Steps rendering quality down when frames are missed or the SoC runs hot,
+// and back up once there is headroom again. Evaluated every 2 s:
+//   tier 0  full quality
+//   tier 1  no PixmapScrollingText motion blur, simplified carousel
+//   tier 2  + contentContainer rendered at 75% and upscaled
+//   tier 3  + rendered at 50%
+// Stepping down needs 2 bad windows in a row, stepping up 5 good ones, and
+// no change happens within 6 s of the previous one (hysteresis).
+class QualityGovernor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int tier READ tier NOTIFY tierChanged)
+    Q_PROPERTY(QString tierName READ tierName NOTIFY tierChanged)
+    Q_PROPERTY(bool motionBlurAllowed READ motionBlurAllowed NOTIFY tierChanged)
+    Q_PROPERTY(bool reducedCarousel READ reducedCarousel NOTIFY tierChanged)
+    Q_PROPERTY(double renderScale READ renderScale NOTIFY tierChanged)
+    Q_PROPERTY(double temperature READ temperature NOTIFY sampled)
+
+public:
+    explicit QualityGovernor(QObject *parent = nullptr);
+
+    void attach(QQuickWindow *window);
+
+    // Disabled: pinned to tier 0
+    void setEnabled(bool enabled);
+
+    // sysfs thermal zone file in millidegrees C (any file with a number works,
+    // which is how tests fake a hot SoC); empty = temperature not considered
+    void setThermalPath(const QString &path);
+
+    // Step down at or above high, allow stepping up only below low (degrees C)
+    void setTemperatureLimits(double high, double low);
+
+    int tier() const { return m_tier; }
+    QString tierName() const;
+    bool motionBlurAllowed() const { return m_tier < 1; }
+    bool reducedCarousel() const { return m_tier >= 1; }
+    double renderScale() const;
+    double temperature() const { return m_temperature; }
+
+signals:
+    void tierChanged();
+    void sampled();
+
+private:
+    void evaluate();
+    double readTemperature() const;
+    void setTier(int tier, const QString &reason);
+
+    QTimer *m_evaluateTimer;
+    FrameStats *m_frameStats;
+    QQuickWindow *m_window;
+    bool m_enabled;
+    QString m_thermalPath;
+    double m_tempHigh;
+    double m_tempLow;
+    double m_temperature;
+    int m_tier;
+    int m_badWindows;
+    int m_goodWindows;
+    int m_windowsSinceChange;
+};
+
+#endif // QUALITYGOVERNOR_H
@@ -0,0 +1,119 @@
+#include "renderbackend.h"
+#include "metrics.h"
+#include <QGuiApplication>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QSurfaceFormat>
+#include <QDebug>
+
+#if QT_CONFIG(vulkan)
+#include <QVulkanInstance>
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#endif
+
+RenderBackend::RenderBackend(QObject *parent)
+    : QObject(parent)
+    , m_vsync(true)
+{
+    Metrics::instance()->describe("gladis_render_backend_info", Metrics::Gauge,
+                                  "Graphics API and device the scene graph renders with (always 1)");
+}
+
+void RenderBackend::setOverride(const QString &backend)
+{
+    if (!backend.isEmpty() && !isValidBackend(backend)) {
+        qWarning() << "Unknown --render-backend" << backend << "- using render_backend";
+        return;
+    }
+    m_override = backend;
+}
+
+bool RenderBackend::isValidBackend(const QString &backend)
+{
+    return backend == "opengl" || backend == "vulkan" || backend == "software";
+}
+
+void RenderBackend::apply(const QString &requested, bool vsync)
+{
+    QString backend = m_override.isEmpty() ? requested.trimmed().toLower() : m_override;
+    if (!isValidBackend(backend)) {
+        qWarning() << "Unknown render_backend" << backend << "- using opengl";
+        backend = "opengl";
+    }
+    m_vsync = vsync;
+
+    if (!qEnvironmentVariableIsEmpty("QT_QUICK_BACKEND") || !qEnvironmentVariableIsEmpty("QSG_RHI_BACKEND")) {
+        qDebug() << "Render backend: set by the environment, render_backend =" << backend << "ignored";
+        m_name = qEnvironmentVariable("QT_QUICK_BACKEND", qEnvironmentVariable("QSG_RHI_BACKEND"));
+    } else {
+        if (backend == "vulkan" && !vulkanAvailable()) {
+            qWarning() << "render_backend = vulkan: no Vulkan driver or no Vulkan support in the"
+                       << QGuiApplication::platformName() << "platform plugin - using opengl";
+            backend = "opengl";
+        }
+
+        if (backend == "vulkan") {
+            QQuickWindow::setGraphicsApi(QSGRendererInterface::Vulkan);
+        } else if (backend == "software") {
+            QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+        } else {
+            QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
+        }
+        m_name = backend;
+    }
+
+    // Both knobs are set whatever the backend, each API reads its own
+    QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+    format.setSwapInterval(vsync ? 1 : 0);
+    QSurfaceFormat::setDefaultFormat(format);
+    if (!vsync) {
+        qputenv("QSG_NO_VSYNC", "1");
+    }
+
+    qDebug() << "Render backend:" << m_name << (vsync ? "(vsync)" : "(vsync off)");
+}
+
+void RenderBackend::attach(QQuickWindow *window)
+{
+    if (!window) {
+        return;
+    }
+
+    // Render thread; the names are handed to the GUI thread
+    connect(window, &QQuickWindow::sceneGraphInitialized, this, [this, window]() {
+        QString name;
+        QString device;
+        switch (window->rendererInterface()->graphicsApi()) {
+        case QSGRendererInterface::OpenGL: name = "opengl"; break;
+        case QSGRendererInterface::Vulkan: name = "vulkan"; break;
+        case QSGRendererInterface::Software: name = "software"; device = "raster"; break;
+        default: name = QString::number(int(window->rendererInterface()->graphicsApi())); break;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+        if (QRhi *rhi = window->rhi()) {
+            device = QString::fromUtf8(rhi->driverInfo().deviceName);
+        }
+#endif
+        QMetaObject::invokeMethod(this, [this, name, device]() {
+            m_name = name;
+            m_device = device;
+            qInfo().noquote() << "Render backend:" << m_name << "on" << (m_device.isEmpty() ? "unknown device" : m_device);
+            Metrics::instance()->setGauge("gladis_render_backend_info", 1,
+                                          Metrics::label("backend", m_name) + "," + Metrics::label("device", m_device));
+            emit changed();
+        }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+}
+
+bool RenderBackend::vulkanAvailable()
+{
+#if QT_CONFIG(vulkan)
+    // Fails without a loader/ICD, and on platform plugins without Vulkan windows (eglfs)
+    QVulkanInstance instance;
+    return instance.create();
+#else
+    return false;
+#endif
+}
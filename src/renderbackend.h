@@ -0,0 +1,59 @@
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include <QObject>
+#include <QString>
+
+class QQuickWindow;
+
+// Graphics API of the Qt Quick scene graph ([app_live] render_backend):
+//   opengl     OpenGL ES through EGL/GLX (default, the only one before)
+//   vulkan     Vulkan; falls back to opengl when no driver or the platform
+//              plugin has no Vulkan surfaces (eglfs: use QT_QPA_PLATFORM=vkkhrdisplay)
+//   software   Qt Quick's raster renderer, no GPU
+// Chosen once, before the first window exists. QT_QUICK_BACKEND or
+// QSG_RHI_BACKEND in the environment win over the config (test scripts).
+//
+// Vsync is per API: OpenGL takes the swap interval of the surface format,
+// Vulkan presents FIFO unless QSG_NO_VSYNC selects an immediate/mailbox
+// present mode, software frames are paced by the platform's update timer
+// and have no vsync to turn off.
+class RenderBackend : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name NOTIFY changed)
+    Q_PROPERTY(QString device READ device NOTIFY changed)
+
+public:
+    explicit RenderBackend(QObject *parent = nullptr);
+
+    // Command line --render-backend, wins over render_backend
+    void setOverride(const QString &backend);
+
+    // Before the first QQuickWindow is created
+    void apply(const QString &requested, bool vsync);
+
+    // Reads the API and device actually in use once the scene graph is up
+    void attach(QQuickWindow *window);
+
+    // Effective backend ("vulkan", "opengl", "software", ... once attached) and
+    // the adapter it runs on (e.g. "V3D 7.1", "llvmpipe (LLVM 15.0.6, 256 bits)")
+    QString name() const { return m_name; }
+    QString device() const { return m_device; }
+    bool vsync() const { return m_vsync; }
+
+    static bool isValidBackend(const QString &backend);
+
+signals:
+    void changed();
+
+private:
+    static bool vulkanAvailable();
+
+    QString m_override;
+    QString m_name;
+    QString m_device;
+    bool m_vsync;
+};
+
+#endif // RENDERBACKEND_H
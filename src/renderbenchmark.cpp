@@ -0,0 +1,213 @@
+#include "renderbenchmark.h"
+#include "framestats.h"
+#include "renderbackend.h"
+#include <QQuickWindow>
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+RenderBenchmark::RenderBenchmark(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_frameStats(new FrameStats(this))
+    , m_backend(nullptr)
+    , m_label("default")
+    , m_warmupMs(2000)
+    , m_measureMs(10000)
+    , m_frameStartNs(-1)
+    , m_firstFrameMs(-1)
+    , m_measuring(false)
+{
+    m_clock.start();
+}
+
+void RenderBenchmark::setDuration(int warmupMs, int measureMs)
+{
+    m_warmupMs = qMax(0, warmupMs);
+    m_measureMs = qMax(1000, measureMs);
+}
+
+void RenderBenchmark::start(QQuickWindow *window)
+{
+    m_window = window;
+    if (!m_window) {
+        emit finished();
+        return;
+    }
+
+    m_frameStats->attach(m_window);
+
+    // Render thread: time spent from sync to the end of the frame's rendering
+    connect(m_window, &QQuickWindow::beforeSynchronizing, this,
+            &RenderBenchmark::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::afterRendering, this,
+            &RenderBenchmark::onAfterRendering, Qt::DirectConnection);
+
+    if (m_startupClock.isValid()) {
+        // Only the app's own frames, measured from the very first one
+        connect(m_window, &QQuickWindow::frameSwapped, this, [this]() {
+            QMutexLocker locker(&m_mutex);
+            if (m_firstFrameMs < 0) {
+                m_firstFrameMs = m_startupClock.elapsed();
+            }
+        }, Qt::DirectConnection);
+
+        qInfo().noquote() << "Benchmark" << m_label << "- startup, measuring the first" << m_measureMs << "ms";
+        beginMeasuring();
+        return;
+    }
+
+    // Keep repainting even when nothing animates, so every mode renders the same number of frames
+    connect(m_window, &QQuickWindow::frameSwapped, this, [this]() {
+        m_window->update();
+    }, Qt::QueuedConnection);
+    m_window->update();
+
+    qInfo().noquote() << "Benchmark" << m_label << "- warming up for" << m_warmupMs << "ms";
+    QTimer::singleShot(m_warmupMs, this, &RenderBenchmark::beginMeasuring);
+}
+
+void RenderBenchmark::beginMeasuring()
+{
+    m_frameStats->reset();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_renderMs.clear();
+        m_frameStartNs = -1;
+        m_measuring = true;
+    }
+
+    QTimer::singleShot(m_measureMs, this, &RenderBenchmark::finish);
+}
+
+void RenderBenchmark::onBeforeSynchronizing()
+{
+    QMutexLocker locker(&m_mutex);
+    m_frameStartNs = m_clock.nsecsElapsed();
+}
+
+void RenderBenchmark::onAfterRendering()
+{
+    qint64 now = m_clock.nsecsElapsed();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_measuring && m_frameStartNs >= 0) {
+        m_renderMs.append(float((now - m_frameStartNs) / 1000000.0));
+    }
+    m_frameStartNs = -1;
+}
+
+void RenderBenchmark::finish()
+{
+    QVector<float> renderMs;
+    qint64 firstFrameMs;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_measuring = false;
+        renderMs = m_renderMs;
+        firstFrameMs = m_firstFrameMs;
+    }
+
+    FrameStats::Summary frames = m_frameStats->summary();
+
+    double renderMean = 0.0;
+    double renderP95 = 0.0;
+    if (!renderMs.isEmpty()) {
+        for (float ms : renderMs) {
+            renderMean += ms;
+        }
+        renderMean /= renderMs.size();
+        std::sort(renderMs.begin(), renderMs.end());
+        renderP95 = renderMs.at(qBound(0, int(0.95 * (renderMs.size() - 1) + 0.5), int(renderMs.size()) - 1));
+    }
+
+    // Device names contain spaces and commas ("llvmpipe (LLVM 15.0.6, 256 bits)")
+    QString backend = m_backend ? m_backend->name() : QString();
+    QString device = m_backend ? m_backend->device() : QString();
+
+    // Grab after the measurement so the readback does not stall a measured frame
+    QImage grab = m_window->grabWindow();
+    double sharpness = laplacianVariance(grab);
+    if (!m_outputPath.isEmpty() && !grab.isNull()) {
+        QFileInfo info(m_outputPath);
+        grab.save(info.absolutePath() + "/" + info.completeBaseName() + "-" + m_label
+                  + (backend.isEmpty() ? QString() : "-" + backend) + ".png");
+    }
+
+    m_summary = QString("label=%1 backend=%2 device=\"%3\"").arg(m_label, backend, device);
+    m_summary += QString(" %1 render_mean_ms=%2 render_p95_ms=%3 first_frame_ms=%4 sharpness=%5 grab=%6x%7")
+        .arg(m_frameStats->summaryLine())
+        .arg(renderMean, 0, 'f', 3)
+        .arg(renderP95, 0, 'f', 3)
+        .arg(firstFrameMs)
+        .arg(sharpness, 0, 'f', 1)
+        .arg(grab.width())
+        .arg(grab.height());
+    qInfo().noquote() << "BENCHMARK" << m_summary;
+
+    appendCsv({ "label", "backend", "device", "frames", "mean_ms", "p50_ms", "p95_ms", "p99_ms", "max_ms", "jank",
+                "render_mean_ms", "render_p95_ms", "first_frame_ms", "sharpness" },
+              { m_label, backend, QString(device).replace(',', ';'), QString::number(frames.frames),
+                QString::number(frames.meanMs, 'f', 3), QString::number(frames.p50Ms, 'f', 3),
+                QString::number(frames.p95Ms, 'f', 3), QString::number(frames.p99Ms, 'f', 3),
+                QString::number(frames.maxMs, 'f', 3), QString::number(frames.jankFrames),
+                QString::number(renderMean, 'f', 3), QString::number(renderP95, 'f', 3),
+                QString::number(firstFrameMs), QString::number(sharpness, 'f', 1) });
+
+    emit finished();
+}
+
+void RenderBenchmark::appendCsv(const QStringList &header, const QStringList &row) const
+{
+    if (m_outputPath.isEmpty()) {
+        return;
+    }
+
+    QFile file(m_outputPath);
+    bool writeHeader = !file.exists() || file.size() == 0;
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Failed to open benchmark output:" << m_outputPath << file.errorString();
+        return;
+    }
+
+    QTextStream out(&file);
+    if (writeHeader) {
+        out << header.join(',') << "\n";
+    }
+    out << row.join(',') << "\n";
+}
+
+double RenderBenchmark::laplacianVariance(const QImage &image)
+{
+    if (image.width() < 3 || image.height() < 3) {
+        return 0.0;
+    }
+
+    QImage gray = image.convertToFormat(QImage::Format_Grayscale8);
+    const int width = gray.width();
+    const int height = gray.height();
+
+    // 4-neighbour Laplacian; the variance is invariant to 90 degree rotations,
+    // so portrait (platform) and landscape (transform/offscreen) grabs compare directly
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    qint64 count = 0;
+    for (int y = 1; y < height - 1; y++) {
+        const uchar *above = gray.constScanLine(y - 1);
+        const uchar *line = gray.constScanLine(y);
+        const uchar *below = gray.constScanLine(y + 1);
+        for (int x = 1; x < width - 1; x++) {
+            int laplacian = above[x] + below[x] + line[x - 1] + line[x + 1] - 4 * line[x];
+            sum += laplacian;
+            sumSquares += double(laplacian) * laplacian;
+            count++;
+        }
+    }
+
+    double mean = sum / count;
+    return sumSquares / count - mean * mean;
+}
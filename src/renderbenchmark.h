@@ -0,0 +1,79 @@
+#ifndef RENDERBENCHMARK_H
+#define RENDERBENCHMARK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QString>
+#include <QImage>
+
+class QQuickWindow;
+class FrameStats;
+class RenderBackend;
+
+// --benchmark: keeps the window repainting for a fixed time, then reports
+// frame interval statistics, render thread time per frame and the sharpness
+// of the final frame (variance of the Laplacian of a window grab - higher
+// means crisper edges, mostly text). Run with vsync off so the frame interval
+// is the frame cost rather than the refresh period.
+//
+// Startup mode (setStartupClock, --benchmark-startup): measures from the first
+// frame with vsync on and without forced repaints - time to first frame since
+// process start plus the jank of the first seconds (pipeline creation, first
+// animations).
+//
+// Prints one "BENCHMARK label=... key=value ..." line and, if an output path
+// is set, appends the same numbers as a CSV row (header written once).
+class RenderBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RenderBenchmark(QObject *parent = nullptr);
+
+    void setLabel(const QString &label) { m_label = label; }
+    void setDuration(int warmupMs, int measureMs);
+    void setOutputPath(const QString &path) { m_outputPath = path; }
+    // Graphics API and device are reported with the results
+    void setRenderBackend(const RenderBackend *backend) { m_backend = backend; }
+    // Started at process start; switches to startup mode
+    void setStartupClock(const QElapsedTimer &clock) { m_startupClock = clock; }
+
+    void start(QQuickWindow *window);
+
+    // One line, key=value pairs
+    QString summaryLine() const { return m_summary; }
+
+    static double laplacianVariance(const QImage &image);
+
+signals:
+    void finished();
+
+private:
+    void beginMeasuring();
+    void finish();
+    void onBeforeSynchronizing();
+    void onAfterRendering();
+    void appendCsv(const QStringList &header, const QStringList &row) const;
+
+    QQuickWindow *m_window;
+    FrameStats *m_frameStats;
+    const RenderBackend *m_backend;
+    QString m_label;
+    QString m_outputPath;
+    QString m_summary;
+    int m_warmupMs;
+    int m_measureMs;
+
+    // Render thread timing, guarded by m_mutex
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QElapsedTimer m_startupClock;
+    qint64 m_frameStartNs;
+    qint64 m_firstFrameMs;
+    QVector<float> m_renderMs;
+    bool m_measuring;
+};
+
+#endif // RENDERBENCHMARK_H
@@ -0,0 +1,292 @@
+#include "renderstats.h"
+#include "logging.h"
+#include <QQuickWindow>
+#include <QQuickItem>
+#include <QTimer>
+#include <QUrl>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QRegularExpression>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const int kGraphFrames = 120;
+const char *kTextureCategory = "qt.scenegraph.time.texture";
+
+} // namespace
+
+RenderStats *RenderStats::s_instance = nullptr;
+QtMessageHandler RenderStats::s_previousHandler = nullptr;
+bool RenderStats::s_handlerInstalled = false;
+bool RenderStats::s_batchCounting = false;
+
+RenderStats::RenderStats(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_sampleTimer(new QTimer(this))
+    , m_enabled(false)
+    , m_lastSwapNs(-1)
+    , m_frames(0)
+    , m_batches(0)
+    , m_batchReports(0)
+    , m_uploads(0)
+    , m_uploadBytes(0)
+    , m_frameTimeMs(0.0)
+    , m_frameTimeP95Ms(0.0)
+    , m_fps(0.0)
+    , m_batchesPerFrame(-1.0)
+    , m_uploadsPerFrame(0.0)
+    , m_uploadBytesPerFrame(0.0)
+{
+    m_clock.start();
+    m_sampleTimer->setInterval(500);
+    connect(m_sampleTimer, &QTimer::timeout, this, &RenderStats::sample);
+}
+
+RenderStats::~RenderStats()
+{
+    setEnabled(false);
+}
+
+void RenderStats::enableBatchCounting()
+{
+    // Read once by the batch renderer; makes it log batch counts every frame,
+    // which the message handler below parses and swallows
+    qputenv("QSG_RENDERER_DEBUG", "render");
+    s_batchCounting = true;
+
+    // The renderer keeps logging after the overlay is switched off, so the
+    // handler stays for the whole run to keep those lines out of the log
+    installMessageHandler();
+}
+
+void RenderStats::installMessageHandler()
+{
+    if (s_handlerInstalled) {
+        return;
+    }
+    s_handlerInstalled = true;
+    s_previousHandler = qInstallMessageHandler(&RenderStats::messageHandler);
+}
+
+void RenderStats::attach(QQuickWindow *window)
+{
+    m_window = window;
+    connect(window, &QQuickWindow::frameSwapped, this, &RenderStats::onFrameSwapped,
+            Qt::DirectConnection);
+}
+
+void RenderStats::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+
+    m_enabled = enabled;
+
+    if (m_enabled) {
+        s_instance = this;
+        installMessageHandler();
+        AsyncLogger::instance()->setRuleOverride(kTextureCategory, true);
+
+        m_sampleClock.start();
+        m_frames.storeRelaxed(0);
+        m_sampleTimer->start();
+        qDebug() << "Render stats overlay enabled" << (s_batchCounting ? "" : "(batch counts need render_stats=1 at startup)");
+    } else {
+        m_sampleTimer->stop();
+        AsyncLogger::instance()->setRuleOverride(kTextureCategory, false);
+        s_instance = nullptr;
+    }
+
+    emit enabledChanged();
+}
+
+void RenderStats::onFrameSwapped()
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    qint64 now = m_clock.nsecsElapsed();
+    QMutexLocker locker(&m_frameMutex);
+    if (m_lastSwapNs >= 0) {
+        m_recentMs.append(float((now - m_lastSwapNs) / 1e6));
+        if (m_recentMs.size() > kGraphFrames) {
+            m_recentMs.remove(0, m_recentMs.size() - kGraphFrames);
+        }
+    }
+    m_lastSwapNs = now;
+    m_frames.fetchAndAddRelaxed(1);
+}
+
+void RenderStats::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    RenderStats *self = s_instance;
+    if (self && context.category && qstrcmp(context.category, kTextureCategory) == 0) {
+        // e.g. "plain texture uploaded in: 3ms (1024x600), ..."
+        static const QRegularExpression sizeRegex("\\((\\d+)x(\\d+)\\)");
+        QRegularExpressionMatch match = sizeRegex.match(message);
+        self->m_uploads.fetchAndAddRelaxed(1);
+        if (match.hasMatch()) {
+            self->m_uploadBytes.fetchAndAddRelaxed(qint64(match.captured(1).toInt()) * match.captured(2).toInt() * 4);
+        }
+        return;
+    }
+
+    // Batch renderer output is always swallowed, counted only while the overlay is on
+    if (s_batchCounting && (message.startsWith("Rendering:") || message.startsWith("Renderer::"))) {
+        if (!self) {
+            return;
+        }
+        // " -> Opaque: 14 nodes in 3 batches..." / " -> Alpha: ..."
+        static const QRegularExpression batchRegex("(\\d+) nodes in (\\d+) batches");
+        QRegularExpressionMatchIterator it = batchRegex.globalMatch(message);
+        int batches = 0;
+        bool found = false;
+        while (it.hasNext()) {
+            batches += it.next().captured(2).toInt();
+            found = true;
+        }
+        if (found) {
+            self->m_batches.fetchAndAddRelaxed(batches);
+            self->m_batchReports.fetchAndAddRelaxed(1);
+        }
+        return;
+    }
+
+    if (s_previousHandler) {
+        s_previousHandler(type, context, message);
+    } else {
+        // Default formatting when nothing else was installed
+        fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+    }
+}
+
+void RenderStats::sample()
+{
+    double elapsedMs = m_sampleClock.restart();
+    int frames = m_frames.fetchAndStoreRelaxed(0);
+    int batches = m_batches.fetchAndStoreRelaxed(0);
+    int batchReports = m_batchReports.fetchAndStoreRelaxed(0);
+    int uploads = m_uploads.fetchAndStoreRelaxed(0);
+    qint64 uploadBytes = m_uploadBytes.fetchAndStoreRelaxed(0);
+
+    QVector<float> recent;
+    {
+        QMutexLocker locker(&m_frameMutex);
+        recent = m_recentMs;
+    }
+
+    m_frameTimes.clear();
+    for (float ms : recent) {
+        m_frameTimes.append(ms);
+    }
+    m_frameTimeMs = recent.isEmpty() ? 0.0 : recent.last();
+    std::sort(recent.begin(), recent.end());
+    m_frameTimeP95Ms = recent.isEmpty() ? 0.0 : recent.at(int((recent.size() - 1) * 0.95));
+    m_fps = elapsedMs > 0 ? frames * 1000.0 / elapsedMs : 0.0;
+
+    int perFrameBase = qMax(1, frames);
+    m_batchesPerFrame = batchReports > 0 ? double(batches) / batchReports : -1.0;
+    m_uploadsPerFrame = double(uploads) / perFrameBase;
+    m_uploadBytesPerFrame = double(uploadBytes) / perFrameBase;
+
+    // Item census, grouped by layer Loader
+    m_layers.clear();
+    QQuickItem *container = m_window ? m_window->contentItem()->findChild<QQuickItem *>("contentContainer") : nullptr;
+    if (container) {
+        QHash<QString, Census> layers;
+        Census base;
+        base.name = "base";
+        censusItem(container, base, layers);
+
+        QStringList names = layers.keys();
+        std::sort(names.begin(), names.end());
+        names.prepend(QString());
+        for (const QString &name : names) {
+            const Census &census = name.isEmpty() ? base : layers[name];
+            QVariantMap entry;
+            entry["name"] = census.name;
+            entry["items"] = census.items;
+            entry["fbos"] = census.fbos;
+            entry["effects"] = census.effects;
+            entry["animations"] = census.animations;
+            entry["timers"] = census.timers;
+            m_layers.append(entry);
+        }
+    }
+
+    emit updated();
+}
+
+void RenderStats::censusItem(QQuickItem *item, Census &census, QHash<QString, Census> &layers)
+{
+    const QList<QQuickItem *> children = item->childItems();
+    for (QQuickItem *child : children) {
+        if (child->objectName() == "renderStatsOverlay") {
+            continue;  // Don't count ourselves
+        }
+
+        // Layer Loaders are named layer0..layer9
+        if (child->objectName().startsWith("layer") && child->inherits("QQuickLoader")) {
+            if (child->childItems().isEmpty()) {
+                continue;  // Inactive layer
+            }
+            Census &layer = layers[child->objectName()];
+            QString app = QFileInfo(child->property("source").toUrl().path()).baseName();
+            layer.name = child->objectName() + (app.isEmpty() ? QString() : " " + app);
+            censusItem(child, layer, layers);
+            continue;
+        }
+
+        if (!child->isVisible()) {
+            continue;
+        }
+
+        census.items++;
+        if (child->inherits("QQuickShaderEffectSource")) {
+            census.fbos++;
+        } else if (child->inherits("QQuickShaderEffect")) {
+            census.effects++;
+        }
+
+        // Animations, Behaviors and Timers are plain QObject children
+        const QObjectList objects = child->children();
+        for (QObject *object : objects) {
+            if (!qobject_cast<QQuickItem *>(object)) {
+                censusObject(object, census);
+            }
+        }
+
+        censusItem(child, census, layers);
+    }
+}
+
+void RenderStats::censusObject(QObject *object, Census &census)
+{
+    if (object->inherits("QQmlTimer")) {
+        if (object->property("running").toBool()) {
+            census.timers++;
+        }
+        return;
+    }
+
+    if (object->inherits("QQuickAbstractAnimation")) {
+        // Count top-level running animations, not every member of a group
+        if (object->property("running").toBool()) {
+            census.animations++;
+        }
+        return;
+    }
+
+    // Behavior -> animation, States/Transitions -> animations
+    const QObjectList children = object->children();
+    for (QObject *child : children) {
+        censusObject(child, census);
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QVariantList>
+#include <QAtomicInteger>
+#include <QHash>
+
+class QQuickWindow;
+class QQuickItem;
+class QTimer;
+
+// Live scene-graph counters for the RenderStatsOverlay. Everything is sampled
+// at 2 Hz and only while enabled, so it can be switched on at a misbehaving
+// kiosk without changing what it measures much.
+//
+//  - frame times: frameSwapped() intervals
+//  - batches: parsed from the batch renderer's own debug output, which Qt
+//    only produces when QSG_RENDERER_DEBUG=render is set before the scene
+//    graph starts (see enableBatchCounting()); -1 when unavailable
+//  - texture uploads/bytes: from the qt.scenegraph.time.texture log category,
+//    enabled at runtime while the overlay is on
+//  - item census per layer Loader: FBO-backed items (layer.enabled and
+//    ShaderEffectSource both create a QQuickShaderEffectSource), ShaderEffects
+//    (incl. graphical effects), running animations and QML Timers
+class RenderStats : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QVariantList frameTimes READ frameTimes NOTIFY updated)
+    Q_PROPERTY(double frameTimeMs READ frameTimeMs NOTIFY updated)
+    Q_PROPERTY(double frameTimeP95Ms READ frameTimeP95Ms NOTIFY updated)
+    Q_PROPERTY(double fps READ fps NOTIFY updated)
+    Q_PROPERTY(double batchesPerFrame READ batchesPerFrame NOTIFY updated)
+    Q_PROPERTY(double uploadsPerFrame READ uploadsPerFrame NOTIFY updated)
+    Q_PROPERTY(double uploadBytesPerFrame READ uploadBytesPerFrame NOTIFY updated)
+    Q_PROPERTY(QVariantList layers READ layers NOTIFY updated)
+
+public:
+    explicit RenderStats(QObject *parent = nullptr);
+    ~RenderStats();
+
+    // Must run before the window's scene graph is initialized
+    static void enableBatchCounting();
+
+    void attach(QQuickWindow *window);
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    QVariantList frameTimes() const { return m_frameTimes; }
+    double frameTimeMs() const { return m_frameTimeMs; }
+    double frameTimeP95Ms() const { return m_frameTimeP95Ms; }
+    double fps() const { return m_fps; }
+    double batchesPerFrame() const { return m_batchesPerFrame; }
+    double uploadsPerFrame() const { return m_uploadsPerFrame; }
+    double uploadBytesPerFrame() const { return m_uploadBytesPerFrame; }
+    QVariantList layers() const { return m_layers; }
+
+signals:
+    void enabledChanged();
+    void updated();
+
+private:
+    struct Census {
+        QString name;
+        int items = 0;
+        int fbos = 0;
+        int effects = 0;
+        int animations = 0;
+        int timers = 0;
+    };
+
+    void sample();
+    void onFrameSwapped();
+    void censusItem(QQuickItem *item, Census &census, QHash<QString, Census> &layers);
+    void censusObject(QObject *object, Census &census);
+
+    // Installed once and kept: enableBatchCounting() or the first setEnabled(true)
+    static void installMessageHandler();
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message);
+
+    QQuickWindow *m_window;
+    QTimer *m_sampleTimer;
+    bool m_enabled;
+
+    // Written on the render thread
+    QMutex m_frameMutex;
+    QElapsedTimer m_clock;
+    qint64 m_lastSwapNs;
+    QVector<float> m_recentMs;
+    QAtomicInteger<int> m_frames;
+    QAtomicInteger<int> m_batches;
+    QAtomicInteger<int> m_batchReports;
+    QAtomicInteger<int> m_uploads;
+    QAtomicInteger<qint64> m_uploadBytes;
+
+    QVariantList m_frameTimes;
+    double m_frameTimeMs;
+    double m_frameTimeP95Ms;
+    double m_fps;
+    double m_batchesPerFrame;
+    double m_uploadsPerFrame;
+    double m_uploadBytesPerFrame;
+    QVariantList m_layers;
+    QElapsedTimer m_sampleClock;
+
+    static RenderStats *s_instance;
+    static QtMessageHandler s_previousHandler;
+    static bool s_handlerInstalled;
+    static bool s_batchCounting;
+};
+
+#endif // RENDERSTATS_H
@@ -0,0 +1,30 @@
+#include "screenconfig.h"
+
+ScreenConfig::ScreenConfig(int index, QObject *parent)
+    : QObject(parent)
+    , m_index(index)
+{
+    for (int i = 0; i < LayerCount; i++) {
+        m_settings.layers.append(QString());
+        m_settings.layerTransitions.append(300);
+    }
+}
+
+void ScreenConfig::setSettings(const Settings &settings)
+{
+    bool same = settings.enabled == m_settings.enabled
+        && settings.output == m_settings.output
+        && settings.layers == m_settings.layers
+        && settings.layerTransitions == m_settings.layerTransitions
+        && settings.renderScreen == m_settings.renderScreen
+        && settings.renderWidth == m_settings.renderWidth
+        && settings.renderHeight == m_settings.renderHeight
+        && settings.renderRotate == m_settings.renderRotate
+        && settings.renderRotateMode == m_settings.renderRotateMode;
+    if (same) {
+        return;
+    }
+
+    m_settings = settings;
+    emit changed();
+}
@@ -0,0 +1,65 @@
+#ifndef SCREENCONFIG_H
+#define SCREENCONFIG_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+// One output window's layer stack and geometry. Screen 0 mirrors [app_live]
+// (main.qml); screens 1..N come from [app_screen_N] and get their own window
+// (ScreenWindow.qml, created by ScreenManager). Filled by ConfigManager.
+class ScreenConfig : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int index READ index CONSTANT)
+    Q_PROPERTY(bool enabled READ enabled NOTIFY changed)
+    Q_PROPERTY(QString output READ output NOTIFY changed)
+    Q_PROPERTY(QStringList layers READ layers NOTIFY changed)
+    Q_PROPERTY(QVariantList layerTransitions READ layerTransitions NOTIFY changed)
+    Q_PROPERTY(int renderScreen READ renderScreen NOTIFY changed)
+    Q_PROPERTY(int renderWidth READ renderWidth NOTIFY changed)
+    Q_PROPERTY(int renderHeight READ renderHeight NOTIFY changed)
+    Q_PROPERTY(int renderRotate READ renderRotate NOTIFY changed)
+    Q_PROPERTY(QString renderRotateMode READ renderRotateMode NOTIFY changed)
+
+public:
+    static const int LayerCount = 10;
+
+    struct Settings {
+        bool enabled = false;
+        QString output;              // Screen name or index, empty = primary screen
+        QStringList layers;          // layer_0 (front-most) .. layer_9
+        QVariantList layerTransitions;
+        int renderScreen = 0;        // 1 = fullscreen
+        int renderWidth = 1024;
+        int renderHeight = 600;
+        int renderRotate = 0;
+        QString renderRotateMode = "auto";
+    };
+
+    explicit ScreenConfig(int index, QObject *parent = nullptr);
+
+    // Emits changed() only if something differs
+    void setSettings(const Settings &settings);
+
+    int index() const { return m_index; }
+    bool enabled() const { return m_settings.enabled; }
+    QString output() const { return m_settings.output; }
+    QStringList layers() const { return m_settings.layers; }
+    QVariantList layerTransitions() const { return m_settings.layerTransitions; }
+    int renderScreen() const { return m_settings.renderScreen; }
+    int renderWidth() const { return m_settings.renderWidth; }
+    int renderHeight() const { return m_settings.renderHeight; }
+    int renderRotate() const { return m_settings.renderRotate; }
+    QString renderRotateMode() const { return m_settings.renderRotateMode; }
+
+signals:
+    void changed();
+
+private:
+    int m_index;
+    Settings m_settings;
+};
+
+#endif // SCREENCONFIG_H
@@ -0,0 +1,189 @@
+#include "screenmanager.h"
+#include "configmanager.h"
+#include "screenconfig.h"
+#include "displayrotation.h"
+#include <QGuiApplication>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQuickWindow>
+#include <QScreen>
+#include <QDebug>
+
+ScreenManager::ScreenManager(QQmlEngine *engine, ConfigManager *config, QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_config(config)
+    , m_component(new QQmlComponent(engine, QUrl(QStringLiteral("qrc:/Components/ScreenWindow.qml")), this))
+    , m_standby(false)
+{
+    if (m_component->isError()) {
+        qWarning() << "ScreenManager: cannot load ScreenWindow.qml:" << m_component->errors();
+    }
+
+    // Screen 0 is the primary window, owned by main.qml
+    const QList<ScreenConfig *> screens = m_config->screens();
+    for (int i = 1; i < screens.size(); i++) {
+        Output output;
+        output.config = screens.at(i);
+        m_outputs.append(output);
+    }
+
+    connect(m_config, &ConfigManager::screensChanged, this, &ScreenManager::sync);
+    connect(m_config->primaryScreen(), &ScreenConfig::changed, this, [this]() {
+        if (m_primary) {
+            place(m_primary, m_config->primaryScreen()->output());
+        }
+    });
+
+    // Hotplug: outputs that (re)appear get their windows back
+    connect(qApp, &QGuiApplication::screenAdded, this, &ScreenManager::placeAll);
+    connect(qApp, &QGuiApplication::screenRemoved, this, &ScreenManager::placeAll);
+}
+
+ScreenManager::~ScreenManager()
+{
+    for (Output &output : m_outputs) {
+        destroyWindow(output);
+    }
+}
+
+void ScreenManager::attachPrimary(QWindow *window)
+{
+    m_primary = window;
+    if (m_primary && !m_config->primaryScreen()->output().isEmpty()) {
+        place(m_primary, m_config->primaryScreen()->output());
+    }
+}
+
+void ScreenManager::setStandby(bool standby)
+{
+    m_standby = standby;
+    for (const Output &output : m_outputs) {
+        if (output.window) {
+            output.window->setProperty("standby", standby);
+        }
+    }
+}
+
+QScreen *ScreenManager::findScreen(const QString &output)
+{
+    const QList<QScreen *> screens = QGuiApplication::screens();
+    if (output.isEmpty()) {
+        return QGuiApplication::primaryScreen();
+    }
+
+    bool isIndex = false;
+    int index = output.toInt(&isIndex);
+    if (isIndex) {
+        return index >= 0 && index < screens.size() ? screens.at(index) : nullptr;
+    }
+
+    for (QScreen *screen : screens) {
+        if (screen->name() == output) {
+            return screen;
+        }
+    }
+    return nullptr;
+}
+
+void ScreenManager::sync()
+{
+    for (Output &output : m_outputs) {
+        if (output.config->enabled() && !output.window) {
+            createWindow(output);
+        } else if (!output.config->enabled() && output.window) {
+            destroyWindow(output);
+        }
+    }
+}
+
+void ScreenManager::createWindow(Output &output)
+{
+    if (!m_component->isReady()) {
+        return;
+    }
+
+    ScreenConfig *config = output.config;
+    output.rotation = new DisplayRotation(this);
+    auto configureRotation = [config, rotation = output.rotation]() {
+        rotation->setConfig(config->renderRotate(), config->renderRotateMode(),
+                            QSize(config->renderWidth(), config->renderHeight()));
+    };
+    configureRotation();
+    connect(config, &ScreenConfig::changed, output.rotation, configureRotation);
+
+    output.context = new QQmlContext(m_engine->rootContext(), this);
+    output.context->setContextProperty("screenPrefix", QString("screen%1_").arg(config->index()));
+
+    // Placed between creation and completion, before the window is first shown
+    QObject *object = m_component->beginCreate(output.context);
+    QQuickWindow *window = qobject_cast<QQuickWindow *>(object);
+    if (!window) {
+        qWarning() << "ScreenManager: ScreenWindow.qml did not create a window";
+        delete object;
+        delete output.rotation;
+        output.rotation = nullptr;
+        delete output.context;
+        output.context = nullptr;
+        return;
+    }
+    m_component->setInitialProperties(window, {
+        { "screenConfig", QVariant::fromValue<QObject *>(config) },
+        { "displayRotation", QVariant::fromValue<QObject *>(output.rotation) },
+        { "standby", m_standby }
+    });
+    place(window, config->output());
+    m_component->completeCreate();
+
+    output.window = window;
+    output.rotation->attach(window);
+    connect(config, &ScreenConfig::changed, window, [this, window, config]() {
+        place(window, config->output());
+    });
+
+    qDebug() << "ScreenManager: screen" << config->index() << "window on"
+             << (window->screen() ? window->screen()->name() : QString("-")) << "layers:" << config->layers();
+}
+
+void ScreenManager::destroyWindow(Output &output)
+{
+    if (output.window) {
+        qDebug() << "ScreenManager: closing screen" << output.config->index() << "window";
+        delete output.window;
+    }
+    delete output.rotation;
+    output.rotation = nullptr;
+    delete output.context;
+    output.context = nullptr;
+}
+
+void ScreenManager::place(QWindow *window, const QString &outputName)
+{
+    QScreen *screen = findScreen(outputName);
+    if (!screen) {
+        qWarning() << "ScreenManager: no output" << outputName << "- using the primary screen";
+        screen = QGuiApplication::primaryScreen();
+    }
+    if (!screen || window->screen() == screen) {
+        return;
+    }
+
+    window->setScreen(screen);
+    window->setPosition(screen->geometry().topLeft());
+    if (window->visibility() == QWindow::FullScreen) {
+        window->setGeometry(screen->geometry());
+    }
+}
+
+void ScreenManager::placeAll()
+{
+    if (m_primary) {
+        place(m_primary, m_config->primaryScreen()->output());
+    }
+    for (const Output &output : m_outputs) {
+        if (output.window) {
+            place(output.window, output.config->output());
+        }
+    }
+}
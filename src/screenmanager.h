@@ -0,0 +1,73 @@
+#ifndef SCREENMANAGER_H
+#define SCREENMANAGER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QPointer>
+
+class QQmlEngine;
+class QQmlComponent;
+class QQmlContext;
+class QQuickWindow;
+class QWindow;
+class QScreen;
+class ConfigManager;
+class ScreenConfig;
+class DisplayRotation;
+
+// Extra output windows from one process ([app_screen_N] with screen_state = 1).
+//
+// Every window is a ScreenWindow.qml instance created in the main engine's
+// root context, so all outputs share one DataManager, the image providers and
+// Qt's decoded image cache, the glyph inventory and the other context objects.
+// A child context per window sets screenPrefix ("screen1_" ...), which apps put
+// in front of their state snapshot keys and button/alert file names so two
+// windows showing the same app do not share them; the main window has "".
+// Each gets its own LayerStack, render_window and DisplayRotation, and is placed
+// on render_output (screen name or index in QGuiApplication::screens()).
+//
+// Windows follow the config: enabling/disabling a screen section creates or
+// destroys its window, outputs appearing or disappearing re-place them.
+class ScreenManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    ScreenManager(QQmlEngine *engine, ConfigManager *config, QObject *parent = nullptr);
+    ~ScreenManager();
+
+    // Move the primary window (main.qml) to [app_live] render_output
+    void attachPrimary(QWindow *window);
+
+    // Warm standby: extra windows stay hidden like the primary one
+    void setStandby(bool standby);
+
+    // Screen name, index or empty (primary screen); null if there is no such screen
+    static QScreen *findScreen(const QString &output);
+
+public slots:
+    void sync();
+
+private:
+    struct Output {
+        ScreenConfig *config = nullptr;
+        QPointer<QQuickWindow> window;
+        DisplayRotation *rotation = nullptr;
+        QQmlContext *context = nullptr;   // screenPrefix of the window's apps
+    };
+
+    void createWindow(Output &output);
+    void destroyWindow(Output &output);
+    void place(QWindow *window, const QString &outputName);
+    void placeAll();
+
+    QQmlEngine *m_engine;
+    ConfigManager *m_config;
+    QQmlComponent *m_component;
+    QVector<Output> m_outputs;
+    QPointer<QWindow> m_primary;
+    bool m_standby;
+};
+
+#endif // SCREENMANAGER_H
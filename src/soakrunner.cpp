@@ -0,0 +1,451 @@
+#include "soakrunner.h"
+#include "virtualclock.h"
+#include "contentbundle.h"
+#include <QQuickWindow>
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QMutexLocker>
+#include <QDebug>
+#include <unistd.h>
+
+namespace {
+
+// Real time per burst of steps before the event loop gets a turn (file
+// watcher events, update requests, queued calls)
+const int kSliceMs = 8;
+
+const char *kDefaultScript =
+    "10m data *\n"
+    "1h config\n";
+
+qint64 parseInterval(const QString &text)
+{
+    static const QRegularExpression intervalRegex("^(\\d+)([smhd])$");
+    QRegularExpressionMatch match = intervalRegex.match(text);
+    if (!match.hasMatch()) {
+        return -1;
+    }
+    const qint64 value = match.captured(1).toLongLong();
+    switch (match.captured(2).at(0).toLatin1()) {
+    case 's': return value * 1000;
+    case 'm': return value * 60 * 1000;
+    case 'h': return value * 3600 * 1000;
+    default: return value * 24 * 3600 * 1000;
+    }
+}
+
+int countEntries(const QString &path, QDir::Filters filters)
+{
+    return QDir(path).entryList(filters | QDir::NoDotAndDotDot).size();
+}
+
+int countInotifyWatches()
+{
+    // Every watch of every inotify instance is one "inotify wd:" line
+    int watches = 0;
+    QDir fdinfoDir("/proc/self/fdinfo");
+    const QStringList fds = fdinfoDir.entryList(QDir::Files);
+    for (const QString &fd : fds) {
+        QFile info(fdinfoDir.filePath(fd));
+        if (info.open(QIODevice::ReadOnly)) {
+            watches += info.readAll().count("inotify wd:");
+        }
+    }
+    return watches;
+}
+
+} // namespace
+
+SoakRunner::SoakRunner(QObject *parent)
+    : QObject(parent)
+    , m_sandbox(nullptr)
+    , m_durationMs(0)
+    , m_stepMs(250)
+    , m_nextSampleMs(0)
+    , m_churnCount(0)
+    , m_steps(0)
+    , m_stepTimer(new QTimer(this))
+    , m_frameStartNs(-1)
+    , m_frames(0)
+    , m_frameSumMs(0.0)
+    , m_frameMaxMs(0.0)
+{
+    m_frameClock.start();
+    connect(m_stepTimer, &QTimer::timeout, this, &SoakRunner::step);
+}
+
+SoakRunner::~SoakRunner()
+{
+    delete m_sandbox;
+}
+
+bool SoakRunner::prepare(const QString &configPath, const QString &dataPath, const QStringList &overlayPaths)
+{
+    delete m_sandbox;
+
+    // tmpfs like the kiosk's /dev/shm
+    QString base = QDir("/dev/shm").exists() ? "/dev/shm/gladis-soak-XXXXXX" : QString();
+    m_sandbox = base.isEmpty() ? new QTemporaryDir() : new QTemporaryDir(base);
+    if (!m_sandbox->isValid()) {
+        qWarning() << "Failed to create soak sandbox:" << m_sandbox->errorString();
+        return false;
+    }
+
+    m_configPath = mapPath(configPath);
+    m_dataPath = mapPath(dataPath);
+
+    QStringList files = overlayPaths;
+    files.prepend(configPath);
+    QFileInfo data(dataPath);
+    if (data.isDir()) {
+        QDir().mkpath(m_dataPath);
+        const QStringList names = QDir(dataPath).entryList(QDir::Files);
+        for (const QString &name : names) {
+            files.append(data.absoluteFilePath() + "/" + name);
+        }
+    } else {
+        files.append(dataPath);
+    }
+
+    for (const QString &file : files) {
+        if (file.isEmpty() || !QFileInfo::exists(file)) {
+            continue;
+        }
+        QString target = mapPath(file);
+        QDir().mkpath(QFileInfo(target).absolutePath());
+        if (!QFile::copy(file, target)) {
+            qWarning() << "Soak: cannot copy" << file << "to the sandbox";
+            return false;
+        }
+    }
+
+    qDebug() << "Soak sandbox:" << sandboxRoot();
+    return true;
+}
+
+QString SoakRunner::sandboxRoot() const
+{
+    return m_sandbox ? m_sandbox->path() : QString();
+}
+
+QString SoakRunner::configPath() const
+{
+    return m_configPath;
+}
+
+QString SoakRunner::dataPath() const
+{
+    return m_dataPath;
+}
+
+bool SoakRunner::loadScript(const QString &path)
+{
+    m_actions.clear();
+    if (path.isEmpty()) {
+        return parseScript(kDefaultScript, "default churn");
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Soak: cannot read churn script" << path << file.errorString();
+        return false;
+    }
+    return parseScript(QString::fromUtf8(file.readAll()), path);
+}
+
+bool SoakRunner::parseScript(const QString &text, const QString &origin)
+{
+    const QStringList lines = text.split('\n');
+    for (int i = 0; i < lines.size(); i++) {
+        QString line = lines.at(i).trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = line.split(QRegularExpression("\\s+"));
+        Action action;
+        action.intervalMs = parseInterval(fields.value(0));
+        action.command = fields.value(1);
+        action.target = fields.value(2);
+        if (action.command == "set") {
+            action.values = fields.mid(3).join(' ').split('|');
+        }
+
+        bool valid = action.intervalMs > 0
+                     && (action.command == "config"
+                         || (action.command == "data" && !action.target.isEmpty())
+                         || (action.command == "set" && action.target.contains('/')));
+        if (!valid) {
+            qWarning().noquote() << QString("Soak: %1:%2: cannot parse \"%3\"").arg(origin).arg(i + 1).arg(line);
+            return false;
+        }
+        action.dueMs = action.intervalMs;
+        m_actions.append(action);
+    }
+    return true;
+}
+
+void SoakRunner::setDuration(qint64 simulatedMs)
+{
+    m_durationMs = qMax<qint64>(0, simulatedMs);
+}
+
+void SoakRunner::setStep(int ms)
+{
+    m_stepMs = qBound(1, ms, 1000);
+}
+
+void SoakRunner::setOutputPath(const QString &path)
+{
+    m_outputPath = path;
+}
+
+void SoakRunner::start(QQuickWindow *window)
+{
+    m_window = window;
+    if (m_window) {
+        connect(m_window, &QQuickWindow::beforeSynchronizing, this, &SoakRunner::onBeforeSynchronizing,
+                Qt::DirectConnection);
+        connect(m_window, &QQuickWindow::frameSwapped, this, &SoakRunner::onFrameSwapped,
+                Qt::DirectConnection);
+    }
+
+    if (!m_outputPath.isEmpty()) {
+        QDir().mkpath(QFileInfo(m_outputPath).absolutePath());
+        QFile file(m_outputPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            QTextStream(&file) << "simulated_h,real_s,rss_kb,fds,threads,inotify_watches,"
+                                  "frames,frame_mean_ms,frame_max_ms\n";
+        } else {
+            qWarning() << "Failed to open soak output:" << m_outputPath << file.errorString();
+        }
+    }
+
+    qDebug() << "Soak: running" << m_durationMs / 3600000.0 << "simulated hours in" << m_stepMs << "ms steps,"
+             << m_actions.size() << "churn actions";
+    m_realClock.start();
+    m_nextSampleMs = 0;
+    sample();
+    m_stepTimer->start(0);
+}
+
+void SoakRunner::step()
+{
+    VirtualClock *clock = VirtualClock::instance();
+    QElapsedTimer slice;
+    slice.start();
+
+    while (slice.elapsed() < kSliceMs) {
+        clock->advance(m_stepMs);
+        m_steps++;
+        const qint64 now = clock->elapsed();
+
+        for (Action &action : m_actions) {
+            if (now >= action.dueMs) {
+                runAction(action);
+                action.dueMs += action.intervalMs;
+            }
+        }
+
+        if (now >= m_nextSampleMs) {
+            sample();
+        }
+        if (now >= m_durationMs) {
+            finish();
+            return;
+        }
+    }
+}
+
+void SoakRunner::runAction(Action &action)
+{
+    m_churnCount++;
+
+    if (action.command == "data") {
+        rewriteData(action.target);
+    } else if (action.command == "config") {
+        // Same settings, different bytes: a full reload and diff without a visible change
+        QFile file(m_configPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QByteArray content = file.readAll();
+        file.close();
+        int marker = content.indexOf("\n; soak churn ");
+        if (marker >= 0) {
+            content.truncate(marker + 1);
+        }
+        if (!content.endsWith('\n')) {
+            content.append('\n');
+        }
+        content.append("; soak churn " + QByteArray::number(m_churnCount) + "\n");
+        rewriteFile(m_configPath, content);
+    } else if (action.command == "set") {
+        const QString value = action.values.value(action.next % qMax(1, int(action.values.size())));
+        action.next++;
+        QSettings settings(m_configPath, QSettings::IniFormat);
+        settings.setValue(action.target, value);
+        settings.sync();
+    }
+}
+
+void SoakRunner::rewriteData(const QString &name)
+{
+    if (!QFileInfo(m_dataPath).isDir()) {
+        // Bundle: repack so it gets a new timestamp and is swapped in like a real update
+        QString error;
+        QSharedPointer<const ContentBundle> bundle = ContentBundle::open(m_dataPath, &error);
+        if (!bundle) {
+            qWarning() << "Soak: cannot open bundle" << m_dataPath << error;
+            return;
+        }
+        QList<ContentBundle::Item> items;
+        const QStringList names = bundle->names();
+        for (const QString &itemName : names) {
+            items.append(ContentBundle::itemFromFile(itemName, QByteArray(bundle->data(itemName))));
+        }
+        if (!ContentBundle::write(m_dataPath, items, &error)) {
+            qWarning() << "Soak: cannot repack bundle" << m_dataPath << error;
+        }
+        return;
+    }
+
+    QDir dir(m_dataPath);
+    const QStringList names = name == "*" ? dir.entryList(QDir::Files) : QStringList{ name };
+    for (const QString &file : names) {
+        QFile source(dir.filePath(file));
+        if (source.open(QIODevice::ReadOnly)) {
+            QByteArray content = source.readAll();
+            source.close();
+            rewriteFile(source.fileName(), content);
+        }
+    }
+}
+
+void SoakRunner::rewriteFile(const QString &path, const QByteArray &content)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size() || !file.commit()) {
+        qWarning() << "Soak: cannot rewrite" << path << file.errorString();
+    }
+}
+
+void SoakRunner::onBeforeSynchronizing()
+{
+    QMutexLocker locker(&m_frameMutex);
+    m_frameStartNs = m_frameClock.nsecsElapsed();
+}
+
+void SoakRunner::onFrameSwapped()
+{
+    QMutexLocker locker(&m_frameMutex);
+    if (m_frameStartNs < 0) {
+        return;
+    }
+    double ms = (m_frameClock.nsecsElapsed() - m_frameStartNs) / 1e6;
+    m_frameStartNs = -1;
+    m_frames++;
+    m_frameSumMs += ms;
+    m_frameMaxMs = qMax(m_frameMaxMs, ms);
+}
+
+void SoakRunner::sample()
+{
+    const qint64 now = VirtualClock::instance()->elapsed();
+    m_nextSampleMs = (now / SampleIntervalMs + 1) * SampleIntervalMs;
+
+    Sample s;
+    s.simulatedHours = now / 3600000.0;
+    s.realSeconds = m_realClock.elapsed() / 1000.0;
+
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        s.rssKb = fields.value(1).toLongLong() * sysconf(_SC_PAGESIZE) / 1024;
+    }
+    s.fds = countEntries("/proc/self/fd", QDir::AllEntries | QDir::System);
+    s.threads = countEntries("/proc/self/task", QDir::Dirs);
+    s.inotifyWatches = countInotifyWatches();
+
+    {
+        QMutexLocker locker(&m_frameMutex);
+        s.frames = m_frames;
+        s.frameMeanMs = m_frames > 0 ? m_frameSumMs / m_frames : 0.0;
+        s.frameMaxMs = m_frameMaxMs;
+        m_frames = 0;
+        m_frameSumMs = 0.0;
+        m_frameMaxMs = 0.0;
+    }
+    m_samples.append(s);
+
+    if (!m_outputPath.isEmpty()) {
+        QFile file(m_outputPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            QTextStream(&file) << QString::number(s.simulatedHours, 'f', 2) << ','
+                               << QString::number(s.realSeconds, 'f', 1) << ','
+                               << s.rssKb << ',' << s.fds << ',' << s.threads << ',' << s.inotifyWatches << ','
+                               << s.frames << ',' << QString::number(s.frameMeanMs, 'f', 3) << ','
+                               << QString::number(s.frameMaxMs, 'f', 3) << "\n";
+        }
+    }
+
+    // One progress line per simulated day
+    if (m_samples.size() % 24 == 1) {
+        qInfo().noquote() << QString("SOAK day=%1 real_s=%2 rss_kb=%3 fds=%4 inotify_watches=%5")
+                                 .arg(s.simulatedHours / 24.0, 0, 'f', 1)
+                                 .arg(s.realSeconds, 0, 'f', 1)
+                                 .arg(s.rssKb)
+                                 .arg(s.fds)
+                                 .arg(s.inotifyWatches);
+    }
+}
+
+void SoakRunner::finish()
+{
+    m_stepTimer->stop();
+    sample();
+    emit finished();
+}
+
+QString SoakRunner::summaryLine() const
+{
+    if (m_samples.isEmpty()) {
+        return QString("simulated_h=0");
+    }
+
+    // Growth is measured from the end of the first simulated hour: startup
+    // allocations and the first loads of every app are not a leak
+    const Sample &first = m_samples.at(qMin(1, int(m_samples.size()) - 1));
+    const Sample &last = m_samples.last();
+    const double days = qMax(1.0 / 24.0, (last.simulatedHours - first.simulatedHours) / 24.0);
+
+    return QString("simulated_h=%1 real_s=%2 steps=%3 churn=%4 rss_start_kb=%5 rss_end_kb=%6 "
+                   "rss_kb_per_day=%7 fds_start=%8 fds_end=%9 inotify_start=%10 inotify_end=%11 "
+                   "threads_end=%12 frame_ms_start=%13 frame_ms_end=%14")
+        .arg(last.simulatedHours, 0, 'f', 1)
+        .arg(last.realSeconds, 0, 'f', 1)
+        .arg(m_steps)
+        .arg(m_churnCount)
+        .arg(first.rssKb)
+        .arg(last.rssKb)
+        .arg((last.rssKb - first.rssKb) / days, 0, 'f', 0)
+        .arg(first.fds)
+        .arg(last.fds)
+        .arg(first.inotifyWatches)
+        .arg(last.inotifyWatches)
+        .arg(last.threads)
+        .arg(first.frameMeanMs, 0, 'f', 3)
+        .arg(last.frameMeanMs, 0, 'f', 3);
+}
+
+QString SoakRunner::mapPath(const QString &path) const
+{
+    return QDir::cleanPath(sandboxRoot() + "/" + QFileInfo(path).absoluteFilePath());
+}
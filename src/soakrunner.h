@@ -0,0 +1,124 @@
+#ifndef SOAKRUNNER_H
+#define SOAKRUNNER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QPointer>
+#include <QStringList>
+#include <QList>
+
+class QTimer;
+class QTemporaryDir;
+class QQuickWindow;
+
+// Long-run soak harness (--soak <hours>). Runs simulated kiosk time on the
+// VirtualClock as fast as the process allows, with scripted config and data
+// churn, and samples the process every simulated hour into a CSV:
+// RSS, open fds, threads, inotify watches and render cost of the frames
+// drawn since the last sample. Leaks and timer drift that take days in the
+// field show up as a slope over a few minutes of real time.
+//
+// Config and data are copied into a sandbox first (same layout as the replay
+// sandbox: recorded path P lives at <sandbox>/P), so churn never touches the
+// real files. Churn script, one action per line (# comments):
+//   10m data *                        rewrite every data file (same content)
+//   30m data user_data.json           rewrite one data file
+//   1h config                         rewrite the config file (comment changes)
+//   6h set app_live/layer_2 app_image|app_hello|
+//                                     cycle a config key through values
+// Intervals take s, m, h or d. Files are replaced by rename, as sync tools do;
+// with a .bundle data path every data action repacks the whole bundle.
+class SoakRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SoakRunner(QObject *parent = nullptr);
+    ~SoakRunner();
+
+    bool prepare(const QString &configPath, const QString &dataPath, const QStringList &overlayPaths);
+
+    // Sandbox paths to hand to ConfigManager/DataManager (valid after prepare)
+    QString sandboxRoot() const;
+    QString configPath() const;
+    QString dataPath() const;
+
+    // Empty path = default churn (data every 10 min, config every hour)
+    bool loadScript(const QString &path);
+
+    void setDuration(qint64 simulatedMs);
+    // Virtual time per step; QML Timers fire at most once per step, keep it below their intervals
+    void setStep(int ms);
+    void setOutputPath(const QString &path);
+
+    void start(QQuickWindow *window);
+
+    // One line, key=value pairs, like FrameStats::summaryLine()
+    QString summaryLine() const;
+
+    static const qint64 SampleIntervalMs = 3600 * 1000;
+
+signals:
+    void finished();
+
+private:
+    struct Action {
+        qint64 intervalMs = 0;
+        qint64 dueMs = 0;
+        QString command;        // data, config, set
+        QString target;
+        QStringList values;     // set: values to cycle through
+        int next = 0;
+    };
+
+    struct Sample {
+        double simulatedHours = 0.0;
+        double realSeconds = 0.0;
+        qint64 rssKb = 0;
+        int fds = 0;
+        int threads = 0;
+        int inotifyWatches = 0;
+        int frames = 0;
+        double frameMeanMs = 0.0;
+        double frameMaxMs = 0.0;
+    };
+
+    bool parseScript(const QString &text, const QString &origin);
+    void step();
+    void runAction(Action &action);
+    void rewriteData(const QString &name);
+    void rewriteFile(const QString &path, const QByteArray &content);
+    void sample();
+    void finish();
+    QString mapPath(const QString &path) const;
+
+    // Window signals (render thread with the threaded loop)
+    void onBeforeSynchronizing();
+    void onFrameSwapped();
+
+    QTemporaryDir *m_sandbox;
+    QString m_configPath;
+    QString m_dataPath;
+    QString m_outputPath;
+    QList<Action> m_actions;
+    qint64 m_durationMs;
+    int m_stepMs;
+    qint64 m_nextSampleMs;
+    int m_churnCount;
+    quint64 m_steps;
+
+    QTimer *m_stepTimer;
+    QElapsedTimer m_realClock;
+    QPointer<QQuickWindow> m_window;
+    QList<Sample> m_samples;
+
+    QMutex m_frameMutex;
+    QElapsedTimer m_frameClock;
+    qint64 m_frameStartNs;
+    int m_frames;
+    double m_frameSumMs;
+    double m_frameMaxMs;
+};
+
+#endif // SOAKRUNNER_H
@@ -0,0 +1,168 @@
+#include "statesnapshot.h"
+#include "metrics.h"
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QDebug>
+
+StateSnapshot::StateSnapshot(QObject *parent)
+    : QObject(parent)
+    , m_maxAgeMs(60000)
+    , m_saveTimer(new QTimer(this))
+    , m_restored(false)
+    , m_restoredWrittenMs(0)
+{
+    m_saveTimer->setInterval(1000);
+    connect(m_saveTimer, &QTimer::timeout, this, &StateSnapshot::save);
+
+    Metrics::instance()->describe("gladis_state_snapshot_writes_total", Metrics::Counter, "Runtime state snapshots written");
+    Metrics::instance()->describe("gladis_state_snapshot_errors_total", Metrics::Counter, "Runtime state snapshots that could not be written");
+    Metrics::instance()->describe("gladis_state_snapshot_bytes", Metrics::Gauge, "Size of the last runtime state snapshot");
+}
+
+void StateSnapshot::setPath(const QString &path)
+{
+    if (path == m_path) {
+        return;
+    }
+    m_path = path;
+    if (m_path.isEmpty()) {
+        m_saveTimer->stop();
+    }
+}
+
+void StateSnapshot::setInterval(int intervalMs)
+{
+    m_saveTimer->setInterval(qMax(100, intervalMs));
+}
+
+void StateSnapshot::setMaxAge(int maxAgeMs)
+{
+    m_maxAgeMs = maxAgeMs;
+}
+
+bool StateSnapshot::restore()
+{
+    if (m_path.isEmpty()) {
+        return false;
+    }
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint64 writtenMs = 0;
+    in >> magic >> version >> writtenMs;
+    if (magic != Magic || version != Version) {
+        qWarning() << "State snapshot: ignoring" << m_path << "- unknown format or version" << version;
+        return false;
+    }
+
+    qint64 ageMs = QDateTime::currentMSecsSinceEpoch() - writtenMs;
+    if (ageMs < 0 || (m_maxAgeMs > 0 && ageMs > m_maxAgeMs)) {
+        qDebug() << "State snapshot: ignoring" << m_path << "- written" << ageMs << "ms ago";
+        return false;
+    }
+
+    QVariantMap values;
+    in >> values;
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "State snapshot: ignoring truncated" << m_path;
+        return false;
+    }
+
+    m_values = values;
+    m_restored = true;
+    m_restoredWrittenMs = writtenMs;
+    qDebug() << "State snapshot: restored" << m_values.size() << "values from" << m_path << "written" << ageMs << "ms ago";
+    emit restored();
+    return true;
+}
+
+void StateSnapshot::start()
+{
+    if (m_path.isEmpty()) {
+        return;
+    }
+    m_saveTimer->start();
+}
+
+void StateSnapshot::stop()
+{
+    m_saveTimer->stop();
+}
+
+void StateSnapshot::setValue(const QString &key, const QVariant &value)
+{
+    m_values.insert(key, value);
+}
+
+QVariant StateSnapshot::value(const QString &key, const QVariant &defaultValue) const
+{
+    return m_values.value(key, defaultValue);
+}
+
+bool StateSnapshot::contains(const QString &key) const
+{
+    return m_values.contains(key);
+}
+
+int StateSnapshot::ageMs() const
+{
+    if (!m_restored) {
+        return 0;
+    }
+    return int(qMax<qint64>(0, QDateTime::currentMSecsSinceEpoch() - m_restoredWrittenMs));
+}
+
+void StateSnapshot::save()
+{
+    if (m_path.isEmpty()) {
+        return;
+    }
+
+    // Let the apps put their current state in first
+    emit saving();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    // /dev/shm is tmpfs: QSaveFile's rename keeps readers from seeing half a snapshot
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "State snapshot: cannot write" << m_path << "-" << file.errorString();
+        Metrics::instance()->increment("gladis_state_snapshot_errors_total");
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << Magic << Version << QDateTime::currentMSecsSinceEpoch() << m_values;
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "State snapshot: writing" << m_path << "failed -" << file.errorString();
+        Metrics::instance()->increment("gladis_state_snapshot_errors_total");
+        return;
+    }
+
+    Metrics::instance()->increment("gladis_state_snapshot_writes_total");
+    Metrics::instance()->setGauge("gladis_state_snapshot_bytes", double(QFileInfo(m_path).size()));
+    if (timer.elapsed() > 20) {
+        qDebug() << "State snapshot: write took" << timer.elapsed() << "ms";
+    }
+}
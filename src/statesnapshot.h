@@ -0,0 +1,71 @@
+#ifndef STATESNAPSHOT_H
+#define STATESNAPSHOT_H
+
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+class QTimer;
+
+// Runtime state that survives a restart ([app_live] state_snapshot).
+//
+// Apps keep their running state (countdown, carousel index, ticker offset,
+// pressed buttons) under their own keys: saving() is emitted before every
+// periodic write so they can store the current values with setValue(), and
+// they read them back with value() when created or when restored() is
+// emitted (warm standby taking over).
+//
+// File format (little endian), replaced atomically on every write:
+//   quint32 magic "GLST", quint16 version, qint64 written (ms since epoch),
+//   QVariantMap (QDataStream Qt_6_0)
+// Snapshots with another version or older than state_snapshot_max_age are ignored.
+class StateSnapshot : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool restored READ isRestored NOTIFY restored)
+    Q_PROPERTY(int ageMs READ ageMs NOTIFY restored)
+
+public:
+    static const quint32 Magic = 0x474c5354;   // "GLST"
+    static const quint16 Version = 1;
+
+    explicit StateSnapshot(QObject *parent = nullptr);
+
+    // Empty path disables snapshots
+    void setPath(const QString &path);
+    void setInterval(int intervalMs);
+    void setMaxAge(int maxAgeMs);
+
+    // Load the snapshot from disk; emits restored() when one was accepted
+    bool restore();
+
+    // Periodic writes; a warm standby only starts writing once it is active
+    void start();
+    void stop();
+
+    Q_INVOKABLE void setValue(const QString &key, const QVariant &value);
+    Q_INVOKABLE QVariant value(const QString &key, const QVariant &defaultValue = QVariant()) const;
+    Q_INVOKABLE bool contains(const QString &key) const;
+
+    bool isRestored() const { return m_restored; }
+    // Wall clock time between the restored snapshot being written and now
+    int ageMs() const;
+
+public slots:
+    void save();
+
+signals:
+    void saving();
+    void restored();
+
+private:
+    QString m_path;
+    int m_maxAgeMs;
+    QTimer *m_saveTimer;
+    QVariantMap m_values;
+    bool m_restored;
+    qint64 m_restoredWrittenMs;
+};
+
+#endif // STATESNAPSHOT_H
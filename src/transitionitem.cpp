@@ -0,0 +1,296 @@
+#include "transitionitem.h"
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGTexture>
+#include <QSGTextureProvider>
+#include <QImage>
+#include <cstring>
+
+namespace {
+
+// QQuickImage::FillMode values
+const int kFillStretch = 0;
+const int kFillPreserveAspectFit = 1;
+const int kFillPreserveAspectCrop = 2;
+const int kFillPad = 6;
+
+// std140 layout of the uniform block in shaders/transition.{vert,frag}
+struct UniformBlock {
+    float matrix[16];
+    float opacity;
+    float progress;
+    float softness;
+    qint32 mode;
+    float fromRect[4];
+    float toRect[4];
+    float fromSubRect[4];
+    float toSubRect[4];
+};
+static_assert(sizeof(UniformBlock) == 144, "must match the shader uniform block");
+
+void copyRect(float *target, const QRectF &rect)
+{
+    target[0] = float(rect.x());
+    target[1] = float(rect.y());
+    target[2] = float(rect.width());
+    target[3] = float(rect.height());
+}
+
+class TransitionMaterial : public QSGMaterial
+{
+public:
+    TransitionMaterial()
+    {
+        setFlag(Blending);
+    }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        // Every transition has its own progress, never merge two into one batch
+        return this == other ? 0 : (this < other ? -1 : 1);
+    }
+
+    QSGTexture *fromTexture = nullptr;
+    QSGTexture *toTexture = nullptr;
+    QRectF fromRect;
+    QRectF toRect;
+    float progress = 0.0f;
+    float softness = 0.05f;
+    int mode = TransitionItem::Fade;
+};
+
+class TransitionShader : public QSGMaterialShader
+{
+public:
+    TransitionShader()
+    {
+        setShaderFileName(VertexStage, QStringLiteral(":/shaders/transition.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/shaders/transition.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        auto *material = static_cast<TransitionMaterial *>(newMaterial);
+        QByteArray *buffer = state.uniformData();
+        Q_ASSERT(buffer->size() >= int(sizeof(UniformBlock)));
+        auto *block = reinterpret_cast<UniformBlock *>(buffer->data());
+
+        if (state.isMatrixDirty()) {
+            std::memcpy(block->matrix, state.combinedMatrix().constData(), sizeof(block->matrix));
+        }
+        if (state.isOpacityDirty()) {
+            block->opacity = state.opacity();
+        }
+
+        block->progress = material->progress;
+        block->softness = material->softness;
+        block->mode = material->mode;
+        copyRect(block->fromRect, material->fromRect);
+        copyRect(block->toRect, material->toRect);
+        copyRect(block->fromSubRect, material->fromTexture->normalizedTextureSubRect());
+        copyRect(block->toSubRect, material->toTexture->normalizedTextureSubRect());
+        return true;
+    }
+
+    void updateSampledImage(RenderState &state, int binding, QSGTexture **texture,
+                            QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        auto *material = static_cast<TransitionMaterial *>(newMaterial);
+        QSGTexture *source = (binding == 1) ? material->fromTexture : material->toTexture;
+        source->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+        *texture = source;
+    }
+};
+
+QSGMaterialShader *TransitionMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new TransitionShader;
+}
+
+class TransitionNode : public QSGGeometryNode
+{
+public:
+    TransitionNode()
+        : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
+    {
+        setGeometry(&m_geometry);
+        setMaterial(&m_material);
+    }
+
+    ~TransitionNode() override
+    {
+        delete m_transparent;
+    }
+
+    // Stands in for a source that has no texture (yet), the sampler always needs one
+    QSGTexture *transparentTexture(QQuickWindow *window)
+    {
+        if (!m_transparent) {
+            QImage image(1, 1, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::transparent);
+            m_transparent = window->createTextureFromImage(image);
+        }
+        return m_transparent;
+    }
+
+    QSGGeometry m_geometry;
+    TransitionMaterial m_material;
+    QRectF m_rect;
+    QSGTexture *m_transparent = nullptr;
+};
+
+} // namespace
+
+TransitionItem::TransitionItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_progress(0.0)
+    , m_mode(Fade)
+    , m_fillMode(kFillStretch)
+    , m_softness(0.05)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void TransitionItem::setFrom(QQuickItem *item)
+{
+    if (m_from == item) {
+        return;
+    }
+    m_from = item;
+    emit fromChanged();
+    update();
+}
+
+void TransitionItem::setTo(QQuickItem *item)
+{
+    if (m_to == item) {
+        return;
+    }
+    m_to = item;
+    emit toChanged();
+    update();
+}
+
+void TransitionItem::setProgress(qreal progress)
+{
+    progress = qBound(0.0, progress, 1.0);
+    if (qFuzzyCompare(m_progress, progress)) {
+        return;
+    }
+    m_progress = progress;
+    emit progressChanged();
+    update();
+}
+
+void TransitionItem::setMode(Mode mode)
+{
+    if (m_mode == mode) {
+        return;
+    }
+    m_mode = mode;
+    emit modeChanged();
+    update();
+}
+
+void TransitionItem::setFillMode(int fillMode)
+{
+    if (m_fillMode == fillMode) {
+        return;
+    }
+    m_fillMode = fillMode;
+    emit fillModeChanged();
+    update();
+}
+
+void TransitionItem::setSoftness(qreal softness)
+{
+    softness = qBound(0.0, softness, 1.0);
+    if (qFuzzyCompare(m_softness, softness)) {
+        return;
+    }
+    m_softness = softness;
+    emit softnessChanged();
+    update();
+}
+
+QRectF TransitionItem::placement(const QSize &textureSize) const
+{
+    // Where the image lands inside the item, in 0..1 item coordinates
+    if (textureSize.isEmpty() || width() <= 0 || height() <= 0 || m_fillMode == kFillStretch) {
+        return QRectF(0, 0, 1, 1);
+    }
+
+    QSizeF imageSize = textureSize;
+    if (m_fillMode == kFillPad) {
+        qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+        imageSize /= dpr;
+    } else if (m_fillMode == kFillPreserveAspectFit) {
+        imageSize.scale(size(), Qt::KeepAspectRatio);
+    } else if (m_fillMode == kFillPreserveAspectCrop) {
+        imageSize.scale(size(), Qt::KeepAspectRatioByExpanding);
+    } else {
+        return QRectF(0, 0, 1, 1);  // Tile modes are drawn stretched
+    }
+
+    qreal w = imageSize.width() / width();
+    qreal h = imageSize.height() / height();
+    return QRectF((1.0 - w) / 2.0, (1.0 - h) / 2.0, w, h);
+}
+
+QSGNode *TransitionItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<TransitionNode *>(oldNode);
+
+    auto textureOf = [this](QQuickItem *item) -> QSGTexture * {
+        if (!item || !item->isTextureProvider()) {
+            return nullptr;
+        }
+        QSGTextureProvider *provider = item->textureProvider();
+        if (!provider) {
+            return nullptr;
+        }
+        // Called on the render thread; repaint from the GUI thread once the image has loaded
+        connect(provider, &QSGTextureProvider::textureChanged, this, &QQuickItem::update,
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
+        return provider->texture();
+    };
+
+    QSGTexture *fromTexture = textureOf(m_from);
+    QSGTexture *toTexture = textureOf(m_to);
+    if ((!fromTexture && !toTexture) || width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new TransitionNode;
+    }
+
+    TransitionMaterial &material = node->m_material;
+    material.fromTexture = fromTexture ? fromTexture : node->transparentTexture(window());
+    material.toTexture = toTexture ? toTexture : node->transparentTexture(window());
+    material.fromRect = placement(fromTexture ? fromTexture->textureSize() : QSize());
+    material.toRect = placement(toTexture ? toTexture->textureSize() : QSize());
+    material.progress = float(m_progress);
+    material.softness = float(m_softness);
+    material.mode = m_mode;
+    node->markDirty(QSGNode::DirtyMaterial);
+
+    if (node->m_rect != boundingRect()) {
+        node->m_rect = boundingRect();
+        QSGGeometry::updateTexturedRectGeometry(&node->m_geometry, node->m_rect, QRectF(0, 0, 1, 1));
+        node->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    return node;
+}
@@ -0,0 +1,75 @@
+#ifndef TRANSITIONITEM_H
+#define TRANSITIONITEM_H
+
+#include <QQuickItem>
+#include <QPointer>
+
+// Blends two texture providers (usually Image items) in one draw call with a
+// single custom material, instead of stacking Images with opacity/clip
+// animations. Everything is driven by the progress uniform:
+//   Fade   cross-fade from -> to
+//   Wipe   soft edge moving left to right
+//   Swap   from fades out, then to fades in (old SwapImageAnimation look)
+//   Push   to slides in from the right and pushes from out
+// fillMode takes Image.Stretch / PreserveAspectFit / PreserveAspectCrop / Pad
+// and is applied in the shader, so cropping needs no clip node.
+//
+// Registered for QML as TransitionItem in "Gladis" 1.0.
+class TransitionItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QQuickItem *from READ from WRITE setFrom NOTIFY fromChanged)
+    Q_PROPERTY(QQuickItem *to READ to WRITE setTo NOTIFY toChanged)
+    Q_PROPERTY(qreal progress READ progress WRITE setProgress NOTIFY progressChanged)
+    Q_PROPERTY(Mode mode READ mode WRITE setMode NOTIFY modeChanged)
+    Q_PROPERTY(int fillMode READ fillMode WRITE setFillMode NOTIFY fillModeChanged)
+    Q_PROPERTY(qreal softness READ softness WRITE setSoftness NOTIFY softnessChanged)
+
+public:
+    enum Mode {
+        Fade,
+        Wipe,
+        Swap,
+        Push
+    };
+    Q_ENUM(Mode)
+
+    explicit TransitionItem(QQuickItem *parent = nullptr);
+
+    QQuickItem *from() const { return m_from; }
+    QQuickItem *to() const { return m_to; }
+    qreal progress() const { return m_progress; }
+    Mode mode() const { return m_mode; }
+    int fillMode() const { return m_fillMode; }
+    qreal softness() const { return m_softness; }
+
+    void setFrom(QQuickItem *item);
+    void setTo(QQuickItem *item);
+    void setProgress(qreal progress);
+    void setMode(Mode mode);
+    void setFillMode(int fillMode);
+    void setSoftness(qreal softness);
+
+signals:
+    void fromChanged();
+    void toChanged();
+    void progressChanged();
+    void modeChanged();
+    void fillModeChanged();
+    void softnessChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    QRectF placement(const QSize &textureSize) const;
+
+    QPointer<QQuickItem> m_from;
+    QPointer<QQuickItem> m_to;
+    qreal m_progress;
+    Mode m_mode;
+    int m_fillMode;
+    qreal m_softness;
+};
+
+#endif // TRANSITIONITEM_H
@@ -0,0 +1,158 @@
+#include "videostats.h"
+#include "metrics.h"
+#include <QVideoSink>
+#include <QVideoFrame>
+#include <QVideoFrameFormat>
+#include <QTimer>
+#include <QMutexLocker>
+#include <QDebug>
+
+VideoStats::VideoStats(QObject *parent)
+    : QObject(parent)
+    , m_sink(nullptr)
+    , m_publishTimer(new QTimer(this))
+    , m_lastStartUs(-1)
+    , m_frameDurationUs(0)
+    , m_anchorWallUs(0)
+    , m_warnedRgb(false)
+{
+    m_clock.start();
+
+    // QML sees the numbers once a second, frames arrive at up to 60 Hz
+    m_publishTimer->setInterval(1000);
+    connect(m_publishTimer, &QTimer::timeout, this, &VideoStats::publish);
+
+    Metrics::instance()->describe("gladis_video_frames_total", Metrics::Counter, "Video frames delivered to the scene graph");
+    Metrics::instance()->describe("gladis_video_dropped_frames_total", Metrics::Counter, "Video frames skipped (presentation timestamp gaps)");
+    Metrics::instance()->describe("gladis_video_frame_delay_seconds", Metrics::Histogram, "Video frame arrival behind its presentation time (decode + delivery)");
+}
+
+void VideoStats::attach(QObject *videoSink)
+{
+    if (m_sink) {
+        disconnect(m_sink, nullptr, this, nullptr);
+    }
+
+    m_sink = qobject_cast<QVideoSink *>(videoSink);
+    reset();
+
+    if (!m_sink) {
+        m_publishTimer->stop();
+        return;
+    }
+
+    // Direct: timestamp frames on the delivering thread, not when the GUI thread gets to them
+    connect(m_sink, &QVideoSink::videoFrameChanged, this, &VideoStats::onFrame, Qt::DirectConnection);
+    connect(m_sink, &QObject::destroyed, this, [this]() {
+        m_sink = nullptr;
+        m_publishTimer->stop();
+    });
+    m_publishTimer->start();
+}
+
+void VideoStats::detach(QObject *videoSink)
+{
+    if (isAttached(videoSink)) {
+        attach(nullptr);
+    }
+}
+
+bool VideoStats::isAttached(QObject *videoSink) const
+{
+    return m_sink && m_sink == videoSink;
+}
+
+void VideoStats::reset()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_counters = Counters();
+        m_lastStartUs = -1;
+        m_frameDurationUs = 0;
+        m_warnedRgb = false;
+    }
+    publish();
+}
+
+void VideoStats::restartTimeline()
+{
+    QMutexLocker locker(&m_mutex);
+    m_lastStartUs = -1;
+}
+
+void VideoStats::onFrame(const QVideoFrame &frame)
+{
+    if (!frame.isValid()) {
+        return;
+    }
+
+    qint64 wallUs = m_clock.nsecsElapsed() / 1000;
+    qint64 startUs = frame.startTime();
+
+    QMutexLocker locker(&m_mutex);
+    m_counters.frames++;
+    QVideoFrameFormat::PixelFormat format = frame.pixelFormat();
+    m_counters.pixelFormat = QVideoFrameFormat::pixelFormatToString(format);
+    m_counters.gpuFrames = (frame.handleType() == QVideoFrame::RhiTextureHandle);
+
+    if (!m_warnedRgb && (format == QVideoFrameFormat::Format_ARGB8888 || format == QVideoFrameFormat::Format_XRGB8888
+                         || format == QVideoFrameFormat::Format_RGBA8888 || format == QVideoFrameFormat::Format_RGBX8888)) {
+        m_warnedRgb = true;
+        qWarning() << "VideoApp: decoder delivers RGB frames, YUV->RGB conversion happens on the CPU";
+    }
+
+    int dropped = 0;
+    if (startUs >= 0) {
+        if (frame.endTime() > startUs) {
+            m_frameDurationUs = frame.endTime() - startUs;
+        }
+
+        if (m_lastStartUs < 0 || startUs < m_lastStartUs) {
+            // First frame, the clip looped or playback resumed: new timeline
+            m_anchorWallUs = wallUs - startUs;
+        } else if (m_frameDurationUs > 0) {
+            qint64 gap = startUs - m_lastStartUs;
+            if (gap > m_frameDurationUs * 3 / 2) {
+                dropped = int((gap + m_frameDurationUs / 2) / m_frameDurationUs) - 1;
+            }
+        }
+        m_lastStartUs = startUs;
+
+        // The earliest frame of the timeline defines "on time"
+        qint64 offsetUs = wallUs - startUs;
+        if (offsetUs < m_anchorWallUs) {
+            m_anchorWallUs = offsetUs;
+        }
+        double delayMs = (offsetUs - m_anchorWallUs) / 1000.0;
+        m_counters.delaySumMs += delayMs;
+        m_counters.maxDelayMs = qMax(m_counters.maxDelayMs, delayMs);
+        Metrics::instance()->observe("gladis_video_frame_delay_seconds", delayMs / 1000.0);
+    }
+    m_counters.dropped += dropped;
+    locker.unlock();
+
+    Metrics::instance()->increment("gladis_video_frames_total");
+    if (dropped > 0) {
+        Metrics::instance()->increment("gladis_video_dropped_frames_total", QString(), dropped);
+    }
+}
+
+void VideoStats::publish()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_published = m_counters;
+    }
+    emit updated();
+}
+
+QString VideoStats::summaryLine() const
+{
+    return QString("frames=%1 dropped=%2 delay_ms=%3 max_delay_ms=%4 format=%5 gpu_frames=%6")
+        .arg(framesReceived())
+        .arg(droppedFrames())
+        .arg(delayMs(), 0, 'f', 2)
+        .arg(maxDelayMs(), 0, 'f', 2)
+        .arg(pixelFormat().isEmpty() ? QString("-") : pixelFormat())
+        .arg(gpuFrames() ? 1 : 0);
+}
@@ -0,0 +1,86 @@
+#ifndef VIDEOSTATS_H
+#define VIDEOSTATS_H
+
+#include <QObject>
+#include <QString>
+#include <QMutex>
+#include <QElapsedTimer>
+
+class QTimer;
+class QVideoSink;
+class QVideoFrame;
+
+// Playback statistics for VideoApp, taken from the VideoOutput's sink without
+// touching pixel data (frames are only inspected, never mapped or converted):
+//   - dropped frames: gaps in the presentation timestamps of delivered frames
+//   - frame delay: how far behind its presentation time each frame reached the
+//     sink, relative to the most punctual frame of the loop (decode + delivery
+//     stalls; the backend does not expose per-frame decode durations)
+//   - the frame path: pixel format and whether frames arrive as GPU textures
+//     (hardware decode) or CPU planes; both are uploaded as YUV and converted
+//     in the VideoOutput shader
+class VideoStats : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int framesReceived READ framesReceived NOTIFY updated)
+    Q_PROPERTY(int droppedFrames READ droppedFrames NOTIFY updated)
+    Q_PROPERTY(double delayMs READ delayMs NOTIFY updated)
+    Q_PROPERTY(double maxDelayMs READ maxDelayMs NOTIFY updated)
+    Q_PROPERTY(QString pixelFormat READ pixelFormat NOTIFY updated)
+    Q_PROPERTY(bool gpuFrames READ gpuFrames NOTIFY updated)
+
+public:
+    explicit VideoStats(QObject *parent = nullptr);
+
+    // VideoOutput.videoSink; null detaches. One sink at a time: the last
+    // VideoApp to attach is measured
+    Q_INVOKABLE void attach(QObject *videoSink);
+    // Only if videoSink is the one attached, another VideoApp may own the stats by now
+    Q_INVOKABLE void detach(QObject *videoSink);
+    Q_INVOKABLE bool isAttached(QObject *videoSink) const;
+    Q_INVOKABLE void reset();
+    // Playback (re)started: the next frame anchors the timeline again, so time
+    // spent paused is not counted as delay. Keeps the counters.
+    Q_INVOKABLE void restartTimeline();
+
+    int framesReceived() const { return m_published.frames; }
+    int droppedFrames() const { return m_published.dropped; }
+    double delayMs() const { return m_published.frames > 0 ? m_published.delaySumMs / m_published.frames : 0.0; }
+    double maxDelayMs() const { return m_published.maxDelayMs; }
+    QString pixelFormat() const { return m_published.pixelFormat; }
+    bool gpuFrames() const { return m_published.gpuFrames; }
+
+    QString summaryLine() const;
+
+signals:
+    void updated();
+
+private:
+    struct Counters {
+        int frames = 0;
+        int dropped = 0;
+        double delaySumMs = 0.0;
+        double maxDelayMs = 0.0;
+        QString pixelFormat;
+        bool gpuFrames = false;
+    };
+
+    void onFrame(const QVideoFrame &frame);
+    void publish();
+
+    QVideoSink *m_sink;
+    QTimer *m_publishTimer;
+
+    // Written from the thread delivering frames
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    Counters m_counters;
+    qint64 m_lastStartUs;
+    qint64 m_frameDurationUs;
+    qint64 m_anchorWallUs;   // Wall clock minus timestamp of the earliest frame seen
+    bool m_warnedRgb;
+
+    Counters m_published;
+};
+
+#endif // VIDEOSTATS_H
@@ -0,0 +1,198 @@
+#include "virtualclock.h"
+#include <QAnimationDriver>
+#include <QTimer>
+#include <QDebug>
+#include <utility>
+
+namespace {
+
+// Reports virtual time to QUnifiedTimer, which drives QML animations and Timers
+class VirtualAnimationDriver : public QAnimationDriver
+{
+public:
+    explicit VirtualAnimationDriver(QObject *parent)
+        : QAnimationDriver(parent)
+        , m_elapsedMs(0)
+    {
+    }
+
+    void setElapsed(qint64 ms) { m_elapsedMs = ms; }
+    qint64 elapsed() const override { return m_elapsedMs; }
+
+private:
+    qint64 m_elapsedMs;
+};
+
+} // namespace
+
+VirtualClock *VirtualClock::instance()
+{
+    static VirtualClock *clock = new VirtualClock();
+    return clock;
+}
+
+VirtualClock::VirtualClock(QObject *parent)
+    : QObject(parent)
+    , m_virtual(false)
+    , m_virtualMs(0)
+    , m_startEpochMs(0)
+    , m_driver(nullptr)
+{
+    m_realClock.start();
+}
+
+void VirtualClock::enableVirtual(const QDateTime &startTime)
+{
+    if (m_virtual) {
+        return;
+    }
+
+    m_virtual = true;
+    m_virtualMs = 0;
+    m_startEpochMs = startTime.toMSecsSinceEpoch();
+
+    VirtualAnimationDriver *driver = new VirtualAnimationDriver(this);
+    driver->install();
+    m_driver = driver;
+    qDebug() << "Virtual clock: starting at" << startTime.toString(Qt::ISODate);
+}
+
+qint64 VirtualClock::elapsed() const
+{
+    return m_virtual ? m_virtualMs : m_realClock.elapsed();
+}
+
+QDateTime VirtualClock::currentDateTime() const
+{
+    if (!m_virtual) {
+        return QDateTime::currentDateTime();
+    }
+    return QDateTime::fromMSecsSinceEpoch(m_startEpochMs + m_virtualMs);
+}
+
+double VirtualClock::now() const
+{
+    return double(m_virtual ? m_startEpochMs + m_virtualMs : QDateTime::currentMSecsSinceEpoch());
+}
+
+void VirtualClock::advance(qint64 ms)
+{
+    if (!m_virtual || ms <= 0) {
+        return;
+    }
+
+    // Earliest due timer first; a slot may start, stop or delete timers, so look again each time
+    const qint64 target = m_virtualMs + ms;
+    for (;;) {
+        ClockTimer *next = nullptr;
+        for (ClockTimer *timer : std::as_const(m_timers)) {
+            if (timer->m_dueMs >= 0 && timer->m_dueMs <= target && (!next || timer->m_dueMs < next->m_dueMs)) {
+                next = timer;
+            }
+        }
+        if (!next) {
+            break;
+        }
+
+        m_virtualMs = qMax(m_virtualMs, next->m_dueMs);
+        next->m_dueMs = next->m_singleShot ? -1 : m_virtualMs + qMax(1, next->m_interval);
+        emit next->timeout();
+    }
+    m_virtualMs = target;
+
+    VirtualAnimationDriver *driver = static_cast<VirtualAnimationDriver *>(m_driver);
+    driver->setElapsed(m_virtualMs);
+    driver->advance();
+}
+
+void VirtualClock::registerTimer(ClockTimer *timer)
+{
+    m_timers.append(timer);
+}
+
+void VirtualClock::unregisterTimer(ClockTimer *timer)
+{
+    m_timers.removeOne(timer);
+}
+
+ClockTimer::ClockTimer(QObject *parent)
+    : QObject(parent)
+    , m_timer(nullptr)
+    , m_interval(0)
+    , m_singleShot(false)
+    , m_dueMs(-1)
+{
+    if (VirtualClock::instance()->isVirtual()) {
+        VirtualClock::instance()->registerTimer(this);
+    } else {
+        m_timer = new QTimer(this);
+        connect(m_timer, &QTimer::timeout, this, &ClockTimer::timeout);
+    }
+}
+
+ClockTimer::~ClockTimer()
+{
+    if (!m_timer) {
+        VirtualClock::instance()->unregisterTimer(this);
+    }
+}
+
+void ClockTimer::setInterval(int ms)
+{
+    m_interval = ms;
+    if (m_timer) {
+        m_timer->setInterval(ms);
+    }
+}
+
+void ClockTimer::setSingleShot(bool singleShot)
+{
+    m_singleShot = singleShot;
+    if (m_timer) {
+        m_timer->setSingleShot(singleShot);
+    }
+}
+
+void ClockTimer::setTimerType(Qt::TimerType type)
+{
+    if (m_timer) {
+        m_timer->setTimerType(type);
+    }
+}
+
+bool ClockTimer::isActive() const
+{
+    return m_timer ? m_timer->isActive() : m_dueMs >= 0;
+}
+
+int ClockTimer::remainingTime() const
+{
+    if (m_timer) {
+        return m_timer->remainingTime();
+    }
+    return m_dueMs < 0 ? -1 : int(qMax<qint64>(0, m_dueMs - VirtualClock::instance()->elapsed()));
+}
+
+void ClockTimer::start()
+{
+    if (m_timer) {
+        m_timer->start();
+    } else {
+        m_dueMs = VirtualClock::instance()->elapsed() + m_interval;
+    }
+}
+
+void ClockTimer::start(int ms)
+{
+    setInterval(ms);
+    start();
+}
+
+void ClockTimer::stop()
+{
+    if (m_timer) {
+        m_timer->stop();
+    } else {
+        m_dueMs = -1;
+    }
+}
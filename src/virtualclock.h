@@ -0,0 +1,97 @@
+#ifndef VIRTUALCLOCK_H
+#define VIRTUALCLOCK_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QList>
+
+class QTimer;
+class QAnimationDriver;
+class ClockTimer;
+
+// Time source for everything that shapes what the kiosk shows over time.
+//
+// Normally this is just the wall clock. In virtual mode (--soak) time only
+// moves when advance() is called:
+//  - QML animations and QML Timers (countdown, carousel/grid rotation) run on
+//    an installed QAnimationDriver that reports virtual time
+//  - C++ timers that schedule content (ClockTimer: data reload delay, file
+//    polling, playlist switches) fire in virtual-time order
+//  - currentDateTime()/now() (playlist time windows, TimerApp, HoursDisplay)
+//    return the virtual wall clock
+// Instrumentation timers (metrics, render stats, journal flush) stay on real time.
+class VirtualClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    static VirtualClock *instance();
+
+    // Switches to virtual time starting at startTime; must run before timers start
+    void enableVirtual(const QDateTime &startTime);
+    bool isVirtual() const { return m_virtual; }
+
+    // Monotonic milliseconds since the clock started
+    qint64 elapsed() const;
+    QDateTime currentDateTime() const;
+
+    // Epoch milliseconds, for QML in place of Date.now()
+    Q_INVOKABLE double now() const;
+
+    // Virtual mode: moves time forward by ms, firing due timers in order and
+    // advancing animations once at the end
+    void advance(qint64 ms);
+
+private:
+    friend class ClockTimer;
+
+    explicit VirtualClock(QObject *parent = nullptr);
+
+    void registerTimer(ClockTimer *timer);
+    void unregisterTimer(ClockTimer *timer);
+
+    bool m_virtual;
+    QElapsedTimer m_realClock;
+    qint64 m_virtualMs;
+    qint64 m_startEpochMs;
+    QAnimationDriver *m_driver;
+    QList<ClockTimer *> m_timers;
+};
+
+// QTimer with the subset of its API the managers use, running on VirtualClock
+// time. Wraps a plain QTimer unless the clock is virtual.
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockTimer(QObject *parent = nullptr);
+    ~ClockTimer();
+
+    void setInterval(int ms);
+    int interval() const { return m_interval; }
+    void setSingleShot(bool singleShot);
+    bool isSingleShot() const { return m_singleShot; }
+    void setTimerType(Qt::TimerType type);
+    bool isActive() const;
+    int remainingTime() const;
+
+public slots:
+    void start();
+    void start(int ms);
+    void stop();
+
+signals:
+    void timeout();
+
+private:
+    friend class VirtualClock;
+
+    QTimer *m_timer;        // Real mode only
+    int m_interval;
+    bool m_singleShot;
+    qint64 m_dueMs;         // Virtual mode: VirtualClock::elapsed() it fires at, -1 = stopped
+};
+
+#endif // VIRTUALCLOCK_H
@@ -0,0 +1,71 @@
+#!/bin/bash
+
+# GLADIS Startup Benchmark
+# Launches GLADIS repeatedly and measures the first seconds with vsync on:
+# time from launch to the first frame and the jank (missed refreshes) while
+# pipelines are created and the first animations run. Compares:
+#   off   no pipeline cache, Qt's own shader disk cache disabled
+#   cold  pipeline cache enabled but empty (first boot after a driver/Qt update)
+#   warm  pipeline cache written by the previous run
+#
+# Usage:
+#   ./startup-benchmark.sh            # 5 launches per variant, 5 s each
+#   ./startup-benchmark.sh 10 8       # 10 launches, 8 s measured each
+#
+# Results: benchmark-results/startup.csv
+
+set -e
+
+RUNS=${1:-5}
+SECONDS_PER_RUN=${2:-5}
+RESULTS_DIR="benchmark-results"
+CSV="$RESULTS_DIR/startup.csv"
+
+if [[ ! -x "./GLADIS" ]]; then
+    echo "ERROR: ./GLADIS not found - build first (./run.sh builds and copies it)"
+    exit 1
+fi
+
+mkdir -p "$RESULTS_DIR"
+rm -f "$CSV" "$RESULTS_DIR"/startup-*.png
+
+CACHE_DIR=$(mktemp -d)
+OVERLAY_OFF=$(mktemp --suffix=.ini)
+OVERLAY_ON=$(mktemp --suffix=.ini)
+trap 'rm -rf "$CACHE_DIR" "$OVERLAY_OFF" "$OVERLAY_ON"' EXIT
+
+# Snapshots would restore a different state every run
+cat > "$OVERLAY_OFF" <<EOF
+[app_live]
+render_pipeline_cache = ""
+state_snapshot = ""
+render_stats = 0
+EOF
+cat > "$OVERLAY_ON" <<EOF
+[app_live]
+render_pipeline_cache = "$CACHE_DIR/pipeline.cache"
+state_snapshot = ""
+render_stats = 0
+EOF
+
+run() {
+    ./GLADIS --benchmark "$SECONDS_PER_RUN" --benchmark-startup --benchmark-output "$CSV" \
+             --config-overlay "$1" 2>&1 | grep "BENCHMARK" || true
+}
+
+for i in $(seq "$RUNS"); do
+    echo ""
+    echo "=== Startup run $i/$RUNS ==="
+
+    QT_DISABLE_SHADER_DISK_CACHE=1 run "$OVERLAY_OFF"
+
+    rm -f "$CACHE_DIR/pipeline.cache"
+    run "$OVERLAY_ON"   # cold, writes the cache on exit
+    run "$OVERLAY_ON"   # warm
+done
+
+echo ""
+echo "=== Results ($CSV) ==="
+column -s, -t < "$CSV" 2>/dev/null || cat "$CSV"
+echo ""
+echo "first_frame_ms = launch to first frame, jank = frames later than 1.5 refresh periods"
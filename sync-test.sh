@@ -0,0 +1,73 @@
+#!/bin/bash
+
+# GLADIS Content Sync Test
+# Exercises gladis-sync without a kiosk: syncs a copy of welcome-data to a local
+# bundle, then changes one file and checks that only its chunk is sent again,
+# once directly (LocalTransport) and once through the pipe protocol with a
+# loopback stand-in for ssh (ProcessTransport).
+#
+# Usage:
+#   ./sync-test.sh                    # uses ./gladis-sync and ./gladis-pack
+#   ./sync-test.sh build-local        # binaries from another directory
+
+set -e
+
+BIN_DIR=${1:-.}
+SYNC="$BIN_DIR/gladis-sync"
+PACK="$BIN_DIR/gladis-pack"
+
+if [[ ! -x "$SYNC" || ! -x "$PACK" ]]; then
+    echo "ERROR: $SYNC / $PACK not found - build first"
+    exit 1
+fi
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+cp -r welcome-data "$WORK/source"
+SSH_STANDIN="$WORK/loopback-ssh"
+cat > "$SSH_STANDIN" <<EOF
+#!/bin/sh
+# ssh stand-in: drop the host, run the remote command here
+shift
+exec "\$@"
+EOF
+chmod +x "$SSH_STANDIN"
+
+expect_sent() {
+    local output=$1 expected=$2
+    echo "$output" | tail -n 1
+    if ! echo "$output" | grep -q " $expected/[0-9]* chunks sent"; then
+        echo "FAIL: expected $expected chunks sent"
+        exit 1
+    fi
+}
+
+check_bundle() {
+    "$PACK" --list "$1" | grep -q "text_daily" || { echo "FAIL: $1 is not a valid bundle"; exit 1; }
+}
+
+echo "=== Local transport ==="
+OUT=$("$SYNC" "$WORK/source" "$WORK/local/vars.bundle")
+check_bundle "$WORK/local/vars.bundle"
+OUT=$("$SYNC" "$WORK/source" "$WORK/local/vars.bundle")
+expect_sent "$OUT" 0
+
+echo "PLAYERS ONLINE" > "$WORK/source/text_count"
+OUT=$("$SYNC" "$WORK/source" "$WORK/local/vars.bundle")
+expect_sent "$OUT" 1
+"$PACK" --list "$WORK/local/vars.bundle" | grep -q "text_count"
+
+echo ""
+echo "=== Process transport (loopback ssh) ==="
+REMOTE="$(realpath "$SYNC")"
+OUT=$("$SYNC" --ssh "$SSH_STANDIN" --remote-command "$REMOTE" "$WORK/source" "kiosk:$WORK/remote/vars")
+test -f "$WORK/remote/vars/text_count" || { echo "FAIL: directory target not published"; exit 1; }
+
+echo "NEW RELEASES TODAY" > "$WORK/source/text_round"
+OUT=$("$SYNC" --ssh "$SSH_STANDIN" --remote-command "$REMOTE" "$WORK/source" "kiosk:$WORK/remote/vars")
+expect_sent "$OUT" 1
+cmp -s "$WORK/source/text_round" "$WORK/remote/vars/text_round" || { echo "FAIL: text_round differs"; exit 1; }
+
+echo ""
+echo "PASS"
@@ -1,19 +1,55 @@
 #!/bin/bash
 # Bash script to sync GLADIS project to Raspberry Pi
 # Usage: ./sync-to-pi.sh
+#        PI_IP=192.168.1.90 ./sync-to-pi.sh
+#        PUBLISH_VARS=1 ./sync-to-pi.sh    # also publish welcome-data as the live ~/app/vars.bundle
+#
+# welcome-data goes to ${PI_DEST}/welcome-data through gladis-sync when it is
+# built here and on the Pi (only changed chunks). It then becomes a symlink to
+# a complete version under welcome-data.sync/, flipped in one rename, so the
+# kiosk never reads a half-updated set. Otherwise it is rsynced with the tree. ~/app/vars.bundle overrides the live ~/app/vars data, so it is only
+# written with PUBLISH_VARS=1 (needs gladis-sync on both ends).
 
-PI_IP="192.168.1.87"
-PI_USER="pi"  # Change this if your username is different
+PI_IP="${PI_IP:-192.168.1.87}"
+PI_USER="${PI_USER:-pi}"  # Change this if your username is different
 PI_DEST="~/gladis"
+PUBLISH_VARS="${PUBLISH_VARS:-0}"
+REMOTE_SYNC="${PI_DEST}/build-local/gladis-sync"
 
 echo "Syncing GLADIS project to Raspberry Pi at $PI_IP..."
 
 # Get the directory where this script is located
 SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
 
+# Content sync tool, if built
+GLADIS_SYNC=""
+for candidate in "$SCRIPT_DIR/gladis-sync" "$SCRIPT_DIR/build-local/gladis-sync" "$SCRIPT_DIR/build/gladis-sync"; do
+    if [ -x "$candidate" ]; then
+        GLADIS_SYNC="$candidate"
+        break
+    fi
+done
+
 # Ensure the destination directory exists on the Pi
 ssh "${PI_USER}@${PI_IP}" "mkdir -p ${PI_DEST}"
 
+# The receiver is the gladis-sync the Pi built from an earlier sync; a fresh
+# Pi has none yet, so welcome-data is rsynced with the tree until it does
+DATA_EXCLUDE=()
+if [ -n "$GLADIS_SYNC" ]; then
+    if ssh "${PI_USER}@${PI_IP}" "test -x ${REMOTE_SYNC}"; then
+        DATA_EXCLUDE=(--exclude '/welcome-data/' --exclude '/welcome-data.sync/')
+    else
+        echo "No ${REMOTE_SYNC} on the Pi yet - rsyncing welcome-data"
+        GLADIS_SYNC=""
+    fi
+fi
+
+if [ "$PUBLISH_VARS" = "1" ] && [ -z "$GLADIS_SYNC" ]; then
+    echo "PUBLISH_VARS=1 needs gladis-sync built here and on the Pi (${REMOTE_SYNC})"
+    exit 1
+fi
+
 # Use rsync to sync the project, excluding build artifacts
 rsync -avz --progress \
     --exclude 'build/' \
@@ -32,9 +68,30 @@ rsync -avz --progress \
     --exclude '*.so' \
     --exclude '*.a' \
     --exclude '*.log' \
+    "${DATA_EXCLUDE[@]}" \
     "$SCRIPT_DIR/" "${PI_USER}@${PI_IP}:${PI_DEST}/"
 
-if [ $? -eq 0 ]; then
+RESULT=$?
+
+if [ $RESULT -eq 0 ] && [ -n "$GLADIS_SYNC" ]; then
+    echo ""
+    echo "Syncing welcome-data with $GLADIS_SYNC..."
+    "$GLADIS_SYNC" --remote-command "$REMOTE_SYNC" \
+        "$SCRIPT_DIR/welcome-data" "${PI_USER}@${PI_IP}:${PI_DEST}/welcome-data"
+    RESULT=$?
+fi
+
+# Explicit opt-in: the bundle replaces whatever the kiosk shows from ~/app/vars
+if [ $RESULT -eq 0 ] && [ "$PUBLISH_VARS" = "1" ]; then
+    echo ""
+    echo "Publishing welcome-data as ~/app/vars.bundle..."
+    ssh "${PI_USER}@${PI_IP}" "mkdir -p app"
+    "$GLADIS_SYNC" --remote-command "$REMOTE_SYNC" \
+        "$SCRIPT_DIR/welcome-data" "${PI_USER}@${PI_IP}:app/vars.bundle"
+    RESULT=$?
+fi
+
+if [ $RESULT -eq 0 ]; then
     echo ""
     echo "Sync completed successfully!"
     echo "Project copied to: ${PI_USER}@${PI_IP}:${PI_DEST}"
@@ -0,0 +1,96 @@
+// gladis-pack: builds a content bundle (see src/contentbundle.h) from a
+// welcome-data directory, or lists the entries of an existing bundle.
+//
+//   gladis-pack welcome-data welcome-data.bundle
+//   gladis-pack --list welcome-data.bundle
+//
+// The output is replaced by rename, so a running GLADIS picks up either the
+// old or the new bundle, never a partial one.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include "contentbundle.h"
+
+static int listBundle(const QString &path)
+{
+    QTextStream out(stdout);
+    QString error;
+    QSharedPointer<const ContentBundle> bundle = ContentBundle::open(path, &error);
+    if (!bundle) {
+        QTextStream(stderr) << "gladis-pack: " << path << ": " << error << Qt::endl;
+        return 1;
+    }
+
+    out << path << ": " << bundle->size() << " bytes, packed "
+        << QDateTime::fromMSecsSinceEpoch(bundle->packedMs()).toString(Qt::ISODate) << Qt::endl;
+    QStringList names = bundle->names();
+    names.sort();
+    for (const QString &name : names) {
+        out << QString("%1 %2%3").arg(bundle->data(name).size(), 10).arg(name)
+                   .arg(bundle->cbor(name).isUndefined() ? "" : "  (json)") << Qt::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("gladis-pack");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Packs a GLADIS data directory into a content bundle.");
+    parser.addHelpOption();
+    QCommandLineOption listOption("list", "List the entries of a bundle.");
+    parser.addOption(listOption);
+    parser.addPositionalArgument("directory", "Data directory (e.g. welcome-data)");
+    parser.addPositionalArgument("bundle", "Output file, should end in .bundle");
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (parser.isSet(listOption)) {
+        if (args.size() != 1) {
+            parser.showHelp(1);
+        }
+        return listBundle(args.first());
+    }
+    if (args.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    QDir directory(args.at(0));
+    if (!directory.exists()) {
+        QTextStream(stderr) << "gladis-pack: no such directory: " << args.at(0) << Qt::endl;
+        return 1;
+    }
+
+    // Flat like the data directory itself; hidden files are editor/sync leftovers
+    QList<ContentBundle::Item> items;
+    const QStringList fileNames = directory.entryList(QDir::Files | QDir::Readable, QDir::Name);
+    for (const QString &fileName : fileNames) {
+        QFile file(directory.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) {
+            QTextStream(stderr) << "gladis-pack: cannot read " << file.fileName() << ": "
+                                << file.errorString() << Qt::endl;
+            return 1;
+        }
+        items.append(ContentBundle::itemFromFile(fileName, file.readAll()));
+    }
+
+    QString error;
+    if (!ContentBundle::write(args.at(1), items, &error)) {
+        QTextStream(stderr) << "gladis-pack: cannot write " << args.at(1) << ": " << error << Qt::endl;
+        return 1;
+    }
+
+    int jsonCount = 0;
+    for (const ContentBundle::Item &item : items) {
+        jsonCount += item.cbor.isEmpty() ? 0 : 1;
+    }
+    QTextStream(stdout) << "gladis-pack: " << items.size() << " files (" << jsonCount
+                        << " JSON) -> " << args.at(1) << Qt::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+// gladis-sync: pushes a data directory to a kiosk, sending only the chunks the
+// kiosk does not have yet and publishing the update atomically (see
+// src/contentsync.h).
+//
+//   gladis-sync welcome-data pi@192.168.1.87:app/vars.bundle   # over ssh
+//   gladis-sync welcome-data /tmp/kiosk/vars.bundle             # local target
+//   gladis-sync --receive app/vars.bundle                       # receiver (run by ssh)
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <unistd.h>
+#include "contentsync.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("gladis-sync");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Delta sync of a GLADIS data directory to a kiosk.");
+    parser.addHelpOption();
+    QCommandLineOption receiveOption("receive",
+        "Receiver side: serve a sender on stdin/stdout and publish to <target>.", "target");
+    QCommandLineOption remoteCommandOption("remote-command",
+        "gladis-sync on the kiosk (default: gladis-sync in PATH).", "command", "gladis-sync");
+    QCommandLineOption sshOption("ssh",
+        "ssh client used for host:path targets.", "command", "ssh");
+    parser.addOptions({ receiveOption, remoteCommandOption, sshOption });
+    parser.addPositionalArgument("source", "Data directory to send (e.g. welcome-data)");
+    parser.addPositionalArgument("target", "[user@]host:path or a local path; *.bundle publishes one content bundle");
+    parser.process(app);
+
+    QTextStream err(stderr);
+    if (parser.isSet(receiveOption)) {
+        ContentReceiver receiver(parser.value(receiveOption));
+        return receiver.serve(STDIN_FILENO, STDOUT_FILENO);
+    }
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2) {
+        parser.showHelp(1);
+    }
+    const QString source = args.at(0);
+    const QString target = args.at(1);
+
+    // host:path goes through ssh, anything else is a path on this machine
+    ContentReceiver *localReceiver = nullptr;
+    SyncTransport *transport = nullptr;
+    int colon = target.indexOf(':');
+    if (colon > 0 && !target.left(colon).contains('/')) {
+        transport = new ProcessTransport(parser.value(sshOption), {
+            target.left(colon), parser.value(remoteCommandOption), "--receive", target.mid(colon + 1)
+        });
+    } else {
+        localReceiver = new ContentReceiver(target);
+        transport = new LocalTransport(localReceiver);
+    }
+
+    SyncStats stats;
+    QString error;
+    bool ok = syncDirectory(source, transport, &stats, &error);
+    delete transport;
+    delete localReceiver;
+
+    if (!ok) {
+        err << "gladis-sync: " << error << Qt::endl;
+        return 1;
+    }
+    QTextStream(stdout) << "gladis-sync: " << stats.files << " files, " << stats.chunksSent << "/"
+                        << stats.chunks << " chunks sent (" << stats.bytesSent << " bytes) -> "
+                        << target << Qt::endl;
+    return 0;
+}